@@ -16,12 +16,20 @@
                 "_HAS_EXCEPTIONS=0"
             ],
             "sources": [
+                "src/cpp/authz.cpp",
+                "src/cpp/blame_cache.cpp",
                 "src/cpp/client.cpp",
+                "src/cpp/fetch_cache.cpp",
+                "src/cpp/log_cache.cpp",
                 "src/cpp/malloc.cpp",
+                "src/cpp/repos.cpp",
+                "src/cpp/status_watcher.cpp",
                 "src/cpp/svn_error.cpp",
                 "src/node/auth/simple.cpp",
                 "src/node/export.cpp",
-                "src/node/node_client.cpp"
+                "src/node/node_authz.cpp",
+                "src/node/node_client.cpp",
+                "src/node/node_repository.cpp"
             ],
             "cflags_cc": [
                 "-std=gnu++17",
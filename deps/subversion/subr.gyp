@@ -13,7 +13,8 @@
                 "include/subr"
             ],
             "defines": [
-                "alloca=_alloca"
+                "alloca=_alloca",
+                "SQLITE_ENABLE_FTS5"
             ],
             "sources": [
                 "subversion/subversion/libsvn_subr/adler32.c",
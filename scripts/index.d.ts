@@ -87,6 +87,31 @@ export interface CatOptions extends PegRevisionOpitons {
     revision: Revision;
 }
 
+export interface CatManyOptions extends CatOptions, BatchOption {
+    expand_keywords: boolean;
+}
+
+export interface CatManyItem {
+    path: string;
+    /** Not set if `error` is set. */
+    properties?: { [key: string]: string };
+    content?: Buffer;
+    error?: Error & { code: number };
+}
+
+export interface PristineItem {
+    path: string;
+    /**
+     * The pristine text as stored, without keyword and eol translation. A read-only
+     * mapping of the pristine store when possible, so it must not be written to. The
+     * mapping is released with the Buffer.
+     *
+     * Not set for files without a pristine text, like added ones.
+     */
+    content?: Buffer;
+    error?: Error & { code: number };
+}
+
 export interface CatResult {
     content: Buffer;
     properties: { [key: string]: string };
@@ -97,10 +122,130 @@ export type CheckoutOptions = DepthOption & PegRevisionOpitons;
 export type InfoOptions = DepthOption & PegRevisionOpitons;
 
 export type StatusOptions = DepthOption & RevisionOption & {
+    /** If true, report every entry, not only the interesting ones. */
+    get_all: boolean;
+    /** If true, contact the repository and report the out-of-date information. */
+    check_out_of_date: boolean;
+    /** If false, only report the out-of-date information. Defaults to true. */
+    check_working_copy: boolean;
+    /** If true, report ignored entries as well. */
+    no_ignore: boolean;
     /** If true, don't process externals definitions as part of this operation. */
     ignore_externals: boolean;
+    /** If true, `depth` is the sticky depth of the working copy to update to. */
+    depth_as_sticky: boolean;
+    /** Only report entries in one of these changelists. */
+    changelists: string | string[];
+
+    // the following filters are applied natively, before entries reach JavaScript
+
+    /** Only report entries with one of these node statuses. */
+    node_status_in: StatusKind | StatusKind[];
+    /** Only report entries at or below one of these paths. */
+    path_prefixes: string | string[];
+    /** Skip entries whose name or path relative to `path` matches one of these patterns. */
+    exclude_globs: string | string[];
+    /** Only report conflicted entries. */
+    only_conflicted: boolean;
 };
 
+export interface StatusChanges {
+    /** Pass it to `status_changes` to get what changed after this call. */
+    generation: number;
+    /** `changed` is the whole status, drop everything known before. */
+    reset: boolean;
+    changed: StatusItem[];
+    /** Paths that are no longer reported, e.g. because they were reverted. */
+    removed: string[];
+}
+
+export interface BatchOption {
+    /** The maximum number of items yielded in each iteration. */
+    batch_size: number;
+}
+
+export type PropertyOptions = DepthOption & PegRevisionOpitons & ChangelistsOption & BatchOption & {
+    /**
+     * Also report the properties the targets inherit from their parents.
+     *
+     * For URLs they are cached per repository and revision,
+     * so sibling targets don't fetch them again.
+     */
+    get_inherited_props: boolean;
+};
+
+export interface InheritedPropertyItem {
+    /** The URL of the parent that has the properties. */
+    path: string;
+    properties: { [key: string]: string };
+}
+
+export interface PropertyItem {
+    path: string;
+    properties: { [key: string]: string };
+    /** Only reported for the targets, when `get_inherited_props` is set. */
+    inherited_properties?: InheritedPropertyItem[];
+}
+
+export interface LockOptions extends BatchOption {
+    /** Steal the locks other users hold on the targets. */
+    steal_lock: boolean;
+}
+
+export interface UnlockOptions extends BatchOption {
+    /** Release the targets even if the locks are owned by other users. */
+    break_lock: boolean;
+}
+
+export interface LockResult {
+    path: string;
+    succeeded: boolean;
+    /** Only reported for created locks. */
+    token?: string;
+    owner?: string;
+    comment?: string;
+    creation_date?: Date;
+    expiration_date?: Date;
+    /** An `Error` named `SvnError`, with the svn error `code`. */
+    error?: Error & { code: number };
+}
+
+export interface CopySource extends PegRevisionOpitons {
+    path: string;
+}
+
+export interface CopyOptions {
+    /** Copy into `destination` if it exists (required for more than one source). */
+    copy_as_child: boolean;
+    make_parents: boolean;
+    ignore_externals: boolean;
+    /** Pin the externals of the copied directories to their current revisions. */
+    pin_externals: boolean;
+    revprops: { [key: string]: string };
+}
+
+export interface MoveOptions {
+    /** Move into `destination` if it exists (required for more than one source). */
+    move_as_child: boolean;
+    make_parents: boolean;
+    allow_mixed_revisions: boolean;
+    revprops: { [key: string]: string };
+}
+
+export type StatOptions = RevisionOption & BatchOption;
+
+export interface StatItem {
+    path: string;
+    /** `NodeKind.none` if the path doesn't exist at the revision. */
+    kind: NodeKind;
+    /** Only set for existing nodes, `-1` for directories. */
+    size?: number;
+    created_rev?: number;
+    time?: Date;
+    last_author?: string;
+    error?: Error & { code: number };
+}
+
 interface SimpleAuth {
     username: string;
     password: string;
@@ -115,6 +260,64 @@ interface GetChangelistsItem {
 interface BlameOptions extends PegRevisionOpitons {
     start_revision: Revision;
     end_revision: Revision;
+    include_merged_revisions: boolean;
+}
+
+interface BlameCacheOptions {
+    /** The size of the cache in bytes, 256 MiB by default. */
+    max_size: number;
+}
+
+interface FetchCacheOptions {
+    /** The size of the cache in bytes, 1 GiB by default. */
+    max_size: number;
+}
+
+interface CacheMetrics {
+    hits: number;
+    misses: number;
+    evictions: number;
+    /** The number of entries currently cached. */
+    entries: number;
+}
+
+interface BlameCacheMetrics extends CacheMetrics {
+    /** Hits on an older annotation that were extended, the others were blamed again. */
+    extensions: number;
+}
+
+interface FetchCacheMetrics {
+    hits: number;
+    misses: number;
+    /** File content served from the cache, in bytes. */
+    bytes_served: number;
+    /** File content downloaded from repositories, in bytes. */
+    bytes_fetched: number;
+    /** The size of the stored content, in bytes. */
+    size: number;
+}
+
+interface BlameRevision {
+    revision: number;
+    author: string | undefined;
+    date: Date | undefined;
+}
+
+/**
+ * The whole annotation of a file.
+ *
+ * Line `i` is `content.slice(line_offsets[i], line_offsets[i + 1])`, without its end of line.
+ * `revisions` and `merged_revisions` have one entry per line, `-1` where there is none.
+ */
+interface BlameCompactResult {
+    /** The text of the file in the end revision, keywords not expanded and line endings like `cat` has them. */
+    content: Buffer;
+    /** Line `i` is `content.slice(line_offsets[i], line_offsets[i + 1])`, including its end of line. */
+    line_offsets: Uint32Array;
+    revisions: Int32Array;
+    merged_revisions: Int32Array;
+    /** The author and date of every revision in `revisions` and `merged_revisions`, sorted by revision. */
+    revision_table: BlameRevision[];
 }
 
 interface BlameItem {
@@ -133,18 +336,92 @@ interface RevisionRange {
     end: Revision;
 }
 
-interface LogOptions extends PegRevisionOpitons {
+interface LogOptions extends PegRevisionOpitons, BatchOption {
+    /** Defaults to the whole history up to `peg_revision`. */
     revision_ranges: RevisionRange | RevisionRange[];
     limit: number;
+    discover_changed_paths: boolean;
+    strict_node_history: boolean;
+    include_merged_revisions: boolean;
+    /** Revision properties to fetch, all of them by default. */
+    revprops: string[];
+}
+
+interface LogChangedPath {
+    path: string;
+    /** `A`dd, `D`elete, `R`eplace or `M`odify. */
+    action: string;
+    copyfrom_path: string | undefined;
+    copyfrom_rev: number;
+    node_kind: NodeKind;
+    text_modified: boolean | undefined;
+    props_modified: boolean | undefined;
 }
 
 interface LogItem {
+    /** `-1` ends the children of the last item with `has_children`. */
     revision: number;
+    has_children: boolean;
     non_inheritable: boolean;
     subtractive_merge: boolean;
     author: string | undefined;
-    date: string | undefined;
+    date: Date | undefined;
     message: string | undefined;
+    /** Requested revision properties other than `svn:author`, `svn:date` and `svn:log`. */
+    revprops?: { [key: string]: string };
+    /** Only reported when `discover_changed_paths` is set. */
+    changed_paths?: LogChangedPath[];
+}
+
+interface LogCacheQuery {
+    author: string;
+    /** An SQLite FTS5 query on the log message. */
+    message: string;
+    /** A repository path with a leading slash, defaults to the path of the URL. */
+    path: string;
+    date_from: Date;
+    date_to: Date;
+    limit: number;
+    discover_changed_paths: boolean;
+}
+
+interface MergeinfoLogOptions extends DepthOption, BatchOption {
+    /** Report the revisions of `source` merged into `target` (default), or the ones still eligible. */
+    finding_merged: boolean;
+    target_peg_revision: Revision;
+    source_peg_revision: Revision;
+    source_start_revision: Revision;
+    source_end_revision: Revision;
+    discover_changed_paths: boolean;
+    /** Revision properties to fetch, all of them by default. */
+    revprops: string[];
+}
+
+interface LocationSegmentsOptions extends PegRevisionOpitons {
+    /** The youngest revision to report, defaults to `peg_revision`. */
+    start_revision: Revision;
+    /** The oldest revision to report, defaults to `0`. */
+    end_revision: Revision;
+}
+
+interface LocationSegment {
+    /** Both inclusive. */
+    range_start: number;
+    range_end: number;
+    /** The repository path (without leading slash), `undefined` for a gap in history. */
+    path: string | undefined;
+}
+
+interface HistoryOptions extends PegRevisionOpitons, BatchOption {
+    limit: number;
+    discover_changed_paths: boolean;
+    /** Revision properties to fetch, all of them by default. */
+    revprops: string[];
+}
+
+interface HistoryItem extends LogItem {
+    /** The repository path (without leading slash) of the node in this revision. */
+    path: string;
 }
 
 type AuthProviderResult<T> = undefined | T | Promise<undefined | T>;
@@ -220,8 +497,32 @@ export declare class Client {
      * Schedule a working copy path for addition to the repository.
      */
     public add(path: string, options?: Partial<AddOptions>): Promise<void>;
+    public blame(path: string, options: Partial<BlameOptions> & { compact: true }): Promise<BlameCompactResult>;
     public blame(path: string, options?: Partial<BlameOptions>): AsyncIterable<BlameItem>;
+    /**
+     * Enable the blame cache in `directory`, or disable it when `directory` is not given.
+     *
+     * Compact blames from revision `0` up to a repository revision are kept, and a blame
+     * of a younger revision only fetches the file revisions after the cached one.
+     */
+    public set_blame_cache(directory?: string, options?: Partial<BlameCacheOptions>): Promise<void>;
+    /** Counters since the blame cache was enabled, all zeros while it's disabled. */
+    public get_blame_cache_metrics(): Promise<BlameCacheMetrics>;
+    /**
+     * Enable the fetch cache in `directory`, or disable it when `directory` is not given.
+     *
+     * `cat` and `cat_many` of URLs at a fixed revision keep file contents once per checksum,
+     * and serve every path and revision known to have the same content without downloading it.
+     */
+    public set_fetch_cache(directory?: string, options?: Partial<FetchCacheOptions>): Promise<void>;
+    /** Counters since the fetch cache was enabled, all zeros while it's disabled. */
+    public get_fetch_cache_metrics(): Promise<FetchCacheMetrics>;
     public cat(path: string, options?: Partial<CatOptions>): Promise<CatResult>;
+    public cat_many(target: string | string[], options?: Partial<CatManyOptions>): AsyncIterable<CatManyItem[]>;
+    /**
+     * Read the pristine (BASE) text of working copy files without contacting the repository.
+     */
+    public pristine(path: string | string[], options?: Partial<BatchOption>): AsyncIterable<PristineItem[]>;
     /**
      * Check out a working copy from a repository.
      *
@@ -235,16 +536,73 @@ export declare class Client {
     public cleanup(path: string): Promise<void>;
     public commit(path: string | string[], message: string): AsyncIterable<CommitNotify>;
 
+    public copy(source: string | Partial<CopySource> | Array<string | Partial<CopySource>>, destination: string, message?: string, options?: Partial<CopyOptions>): AsyncIterable<CommitItem>;
+    /**
+     * Get the commits of a node across copies and renames, each with the path the node had in it.
+     */
+    public history(path: string, options?: Partial<HistoryOptions>): AsyncIterable<HistoryItem[]>;
     public info(path: string, options?: Partial<InfoOptions>): AsyncIterable<InfoItem>;
-    public log(path: string | string[], options?: Partial<LogOptions>): AsyncIterable<LogItem>;
+    public lock(target: string | string[], comment?: string, options?: Partial<LockOptions>): AsyncIterable<LockResult[]>;
+    public location_segments(path: string, options?: Partial<LocationSegmentsOptions>): Promise<LocationSegment[]>;
+    /**
+     * Get the log of one or more nodes.
+     *
+     * A single target is answered from the log cache (see `set_log_cache`)
+     * when it holds every requested revision. Only `svn:author`, `svn:date`
+     * and `svn:log` are cached, other revision properties are not reported
+     * then.
+     */
+    public log(path: string | string[], options?: Partial<LogOptions>): AsyncIterable<LogItem[]>;
+    /**
+     * Query the log cache of the repository of `url`, newest first, without
+     * contacting the server.
+     */
+    public search_log_cache(url: string, query?: Partial<LogCacheQuery>): Promise<LogItem[]>;
+    /**
+     * Enable the log cache, one SQLite database per repository in
+     * `directory`, or disable it when `directory` is not given.
+     */
+    public set_log_cache(directory?: string): Promise<void>;
+    /** Counters since the log cache was enabled, all zeros while it's disabled. */
+    public get_log_cache_metrics(): Promise<CacheMetrics>;
+    /**
+     * Fetch the revisions missing from the log cache of the repository of `url`.
+     *
+     * @returns The youngest cached revision.
+     */
+    public sync_log_cache(url: string): Promise<number>;
+    public mergeinfo_log(target: string, source: string, options?: Partial<MergeinfoLogOptions>): AsyncIterable<LogItem[]>;
+
+    public move(source: string | string[], destination: string, message?: string, options?: Partial<MoveOptions>): AsyncIterable<CommitItem>;
+    /** Bounds the cache of properties inherited by URL targets, 4096 entries by default. */
+    public set_inherited_properties_cache_size(max_entries: number): Promise<void>;
+    public get_inherited_properties_cache_metrics(): Promise<CacheMetrics>;
+    public propget(name: string, target: string | string[], options?: Partial<PropertyOptions>): AsyncIterable<PropertyItem[]>;
+    public proplist(target: string | string[], options?: Partial<PropertyOptions>): AsyncIterable<PropertyItem[]>;
 
     public remove(path: string | string[], options?: Partial<RemoveOptions>): AsyncIterable<CommitItem>;
     public resolve(path: string): Promise<void>;
     public revert(path: string | string[]): Promise<void>;
 
+    public stat(url: string | string[], options?: Partial<StatOptions>): AsyncIterable<StatItem[]>;
     public status(path: string, options?: Partial<StatusOptions>): AsyncIterable<StatusItem>;
+    /**
+     * Get the status changes of a watched working copy.
+     *
+     * @param path The path passed to `watch_status`, in any form that resolves to the same absolute path.
+     * @param generation The `generation` of the last result, or `0` for the whole status.
+     */
+    public status_changes(path: string, generation: number): Promise<StatusChanges>;
 
+    public unlock(target: string | string[], options?: Partial<UnlockOptions>): AsyncIterable<LockResult[]>;
     public update(path: string | string[], options?: Partial<UpdateOptions>): AsyncIterable<UpdateProgressNotify>;
+    /**
+     * Start watching a working copy for changes, see `status_changes`.
+     *
+     * @returns The whole status, like `status` with default options.
+     */
+    public watch_status(path: string): Promise<StatusChanges>;
+    public unwatch_status(path: string): void;
 
     public get_working_copy_root(path: string): Promise<string>;
 
@@ -312,4 +670,313 @@ export declare enum StatusKind {
     incomplete,
 }
 
+/** Blocks until the repository is created, see `repos.create`. */
 export declare function create_repos(path: string): void;
+
+export interface ReposCreateOptions {
+    /** Defaults to `fsfs`. */
+    fs_type: "fsfs" | "fsx";
+    /** Defaults to the backend's default. */
+    compression: "lz4" | "zlib" | "none";
+    /** Revisions per shard, defaults to the backend's default. */
+    shard_size: number;
+    /** The oldest Subversion version, like `"1.9"`, that must be able to read the repository. Defaults to the newest format. */
+    compatible_version: string;
+}
+
+/** The part of `AbortSignal` long running repository operations rely on. */
+export interface AbortSignalLike {
+    readonly aborted: boolean;
+    addEventListener(type: "abort", listener: () => void, options?: { once?: boolean }): void;
+    /** Called with the same listener once the operation has settled. */
+    removeEventListener?(type: "abort", listener: () => void): void;
+}
+
+export interface ReposOperationOptions {
+    /** Aborting fails the operation with `SVN_ERR_CANCELLED`. */
+    signal: AbortSignalLike;
+}
+
+export interface ReposHotcopyOptions extends ReposOperationOptions {
+    /** Only copies what changed since the last hotcopy to the destination. */
+    incremental: boolean;
+    /** Removes Berkeley DB log files that are no longer in use. */
+    clean_logs: boolean;
+    /**
+     * Approximate, applied per revision range. Defaults to no limit.
+     *
+     * The copy waits on one of the threads of the libuv pool (`UV_THREADPOOL_SIZE`, 4 by
+     * default), which stays taken until the copy is done and delays other work queued
+     * behind it.
+     */
+    rate_limit_bytes_per_sec: number;
+}
+
+export interface ReposHotcopyProgress {
+    /** Packed shards are copied at once, revisions one by one. */
+    start_revision: number;
+    end_revision: number;
+    /** The size of the revision files copied for the range. */
+    bytes: number;
+}
+
+export interface ReposPackOptions extends ReposOperationOptions {
+    /** Stops after packing that many shards, so packing can be spread over idle periods. Defaults to no limit. */
+    shards_per_run: number;
+}
+
+export interface ReposPackProgress {
+    action: "start" | "end" | "start_revprop" | "end_revprop";
+    shard: number;
+}
+
+export interface ReposStatsOptions extends ReposOperationOptions {
+    /** Reads every revision for the `layout` report, instead of only looking at the format. FSFS only. */
+    detailed: boolean;
+    /** Called with the revision being read for the `layout` report. */
+    progress: (revision: number) => void;
+}
+
+export interface ReposRepresentationStats {
+    count: number;
+    /** On disk, after deltification and compression. */
+    packed_size: number;
+    /** Fully expanded. */
+    expanded_size: number;
+    /** Nodes using the representations, some of them are shared. */
+    references: number;
+    /** The average length of the delta chains that have to be combined to read one. */
+    average_chain_length: number;
+}
+
+export interface ReposHistogramLine {
+    count: number;
+    size: number;
+}
+
+export interface ReposLayoutStats {
+    total_size: number;
+    revision_count: number;
+    change_count: number;
+    file_count: number;
+    dir_count: number;
+    file_representations: ReposRepresentationStats;
+    dir_representations: ReposRepresentationStats;
+    file_prop_representations: ReposRepresentationStats;
+    dir_prop_representations: ReposRepresentationStats;
+    /** Line `i` covers sizes below `2 ** i`, trailing empty lines are left out. */
+    representation_sizes: ReposHistogramLine[];
+    node_sizes: ReposHistogramLine[];
+    /** Largest first. */
+    largest_changes: Array<{ path: string; revision: number; size: number }>;
+    /** Largest `representation_size` first, `(none)` for files without extension. */
+    extensions: Array<{ extension: string; node_count: number; node_size: number; representation_count: number; representation_size: number }>;
+}
+
+export interface ReposStats {
+    youngest: number;
+    /** Zero when the repository isn't sharded. */
+    shard_size: number;
+    /** Revisions before it are packed. */
+    min_unpacked_rev: number;
+    /** Complete shards `repos.pack` would pack. */
+    unpacked_shards: number;
+    /** Only with `detailed`. */
+    layout?: ReposLayoutStats;
+}
+
+export interface ReposVerifyOptions extends ReposOperationOptions, BatchOption {
+    /** Defaults to `0`. */
+    start: number;
+    /** Defaults to the youngest revision. */
+    end: number;
+    /** The number of threads verifying revision ranges side by side, each on a filesystem handle of its own. Defaults to `1`. */
+    parallelism: number;
+    /** Only checks the backend's metadata, not the revisions' content. */
+    metadata_only: boolean;
+    /** Reports paths that only differ in Unicode normalization. */
+    check_normalization: boolean;
+}
+
+export interface ReposVerifyResult {
+    /** `-1` for problems not tied to a revision. */
+    revision: number;
+    /** Only reported for corrupted revisions, an `Error` named `SvnError`, with the svn error `code`. */
+    error?: Error & { code: number };
+}
+
+export interface ReposDumpOptions extends ReposOperationOptions {
+    /** Defaults to `0`. */
+    start: number;
+    /** Defaults to the youngest revision. */
+    end: number;
+    /** Only dumps what changed in `start`, instead of everything it has. */
+    incremental: boolean;
+    /** Dumps file contents as deltas against their previous versions. */
+    deltas: boolean;
+}
+
+export interface ReposDumpRange {
+    file: string;
+    start: number;
+    end: number;
+}
+
+export interface ReposLoadOptions extends ReposOperationOptions {
+    /** What to do with the dump file's UUID. Defaults to `default`, only using it when the repository is empty. */
+    uuid_action: "default" | "ignore" | "force";
+    /** Loads everything below this directory instead of the root. */
+    parent_dir: string;
+    validate_props: boolean;
+    ignore_dates: boolean;
+    normalize_props: boolean;
+    /** Doesn't flush every revision to disk as it's committed, for restores that can simply be restarted. */
+    batch_fsync: boolean;
+}
+
+export interface ReposLoadProgress {
+    /** The revision committed to the repository. */
+    revision: number;
+    /** Its number in the dump file. */
+    original_revision: number;
+}
+
+export type ReposCommitOperation =
+    /** `add` fails when the file exists, `put` creates or overwrites it. */
+    | { action: "add" | "put"; path: string; content: string | Buffer }
+    | { action: "delete" | "mkdir"; path: string }
+    /** `copyfrom_rev` defaults to the revision the commit is based on. */
+    | { action: "copy"; path: string; copyfrom_path: string; copyfrom_rev?: number }
+    /** Deletes the property when `value` is not set. */
+    | { action: "propset"; path: string; name: string; value?: string | Buffer };
+
+export interface ReposCommitInfo {
+    /** `svn:author` is not set without one. */
+    author: string;
+    message: string;
+    /** Additional revision properties. */
+    revprops: Record<string, string>;
+}
+
+export interface ReposBatchCommit extends Partial<ReposCommitInfo> {
+    operations: ReposCommitOperation[];
+}
+
+export interface ReposCommitOptions {
+    /** Doesn't run the start-commit, pre-commit and post-commit hooks. */
+    bypass_hooks: boolean;
+}
+
+export interface ReposCommitResult {
+    revision: number;
+    /** Set when the post-commit hook failed, the revision is committed anyway. */
+    post_commit_error: string | undefined;
+}
+
+export interface ReposTreeOptions extends BatchOption {
+    recursive: boolean;
+}
+
+export interface ReposDirent {
+    /** Relative to the listed directory. */
+    path: string;
+    kind: NodeKind;
+    /** Only reported for files. */
+    size?: number;
+    /** The revision the node was last changed in. */
+    created_rev: number;
+}
+
+export interface ReposHistoryOptions extends BatchOption {
+    /** Defaults to the youngest revision. */
+    revision: number;
+}
+
+export interface ReposLocation {
+    /** With a leading slash. */
+    path: string;
+    revision: number;
+}
+
+/**
+ * A repository on local disk, read without going through a client. Omitted
+ * revisions stand for the youngest one.
+ *
+ * Every `Repository` opened on the same path shares one handle and its caches.
+ */
+export declare class Repository {
+    private constructor();
+
+    public youngest(): Promise<number>;
+    public tree(revision?: number, path?: string, options?: Partial<ReposTreeOptions>): AsyncIterable<ReposDirent[]>;
+    /** Yields the content in chunks of up to 64 KiB. */
+    public cat(revision: number | undefined, path: string): AsyncIterable<Buffer[]>;
+    public changed_paths(revision?: number): Promise<LogChangedPath[]>;
+    public proplist(revision: number | undefined, path: string): Promise<Record<string, string>>;
+    public revision_proplist(revision?: number): Promise<Record<string, string>>;
+    /** The revisions `path` changed in, newest first, following copies. */
+    public history(path: string, options?: Partial<ReposHistoryOptions>): AsyncIterable<ReposLocation[]>;
+}
+
+export declare namespace repos {
+    /** Commits `operations` to a transaction directly, resolves to the new revision. */
+    function commit(path: string, info: Partial<ReposCommitInfo>, operations: ReposCommitOperation[], options?: Partial<ReposCommitOptions>): Promise<ReposCommitResult>;
+    /** Creates one revision per commit, in order. Stops at the first one that fails, the revisions before it stay. */
+    function commit_batch(path: string, commits: ReposBatchCommit[], options?: Partial<ReposCommitOptions>): Promise<ReposCommitResult[]>;
+    function create(path: string, options?: Partial<ReposCreateOptions>): Promise<void>;
+    /** `readable` can be a `stream.Readable`, or any async iterable of Buffers. Hooks are not run. */
+    function load(path: string, readable: AsyncIterable<Buffer>, options?: Partial<ReposLoadOptions>): AsyncIterable<ReposLoadProgress>;
+    function open(path: string): Promise<Repository>;
+    /**
+     * Yields the dump file in chunks of up to 64 KiB, dumping pauses until the previous chunk is consumed.
+     *
+     * Use `stream.Readable.from` to get a `Readable`.
+     */
+    function dump(path: string, options?: Partial<ReposDumpOptions>): AsyncIterable<Buffer>;
+    /**
+     * Dumps one range of revisions to each of `files` side by side. All but the first are incremental,
+     * so concatenating them gives one valid dump file.
+     */
+    function dump_parallel(path: string, files: string[], options?: Partial<ReposDumpOptions>): Promise<ReposDumpRange[]>;
+    function hotcopy(source: string, destination: string, options?: Partial<ReposHotcopyOptions>): AsyncIterable<ReposHotcopyProgress>;
+    function pack(path: string, options?: Partial<ReposPackOptions>): AsyncIterable<ReposPackProgress>;
+    function stats(path: string, options?: Partial<ReposStatsOptions>): Promise<ReposStats>;
+    /** Results of revision ranges verified in parallel are interleaved. */
+    function verify(path: string, options?: Partial<ReposVerifyOptions>): AsyncIterable<ReposVerifyResult[]>;
+}
+
+/** Same as the authz file syntax. */
+export type AuthzAccess = "r" | "rw";
+
+export interface AuthzCheckOptions {
+    /** The access must be granted to everything below each path too. */
+    recursive: boolean;
+}
+
+export interface AuthzFilterOptions extends AuthzCheckOptions {
+    /** Defaults to `"r"`. */
+    access: AuthzAccess;
+    /** The directory entry paths are relative to, like the `path` given to `Repository.tree`. */
+    base: string;
+}
+
+/**
+ * Compiled authorization rules. A `null` user stands for anonymous, a `null`
+ * repository only applies the rules that don't name one.
+ *
+ * Every `Authz` loaded from the same file shares one model, compiled again
+ * when the file changes on disk.
+ */
+export declare class Authz {
+    private constructor();
+
+    /** Whether `user` has `access` to each of `paths`, in order. */
+    public check(user: string | null, repos: string | null, paths: string[], access: AuthzAccess, options?: Partial<AuthzCheckOptions>): Promise<boolean[]>;
+    /** The entries `user` has access to, in order. `entries` must not change until the promise settles. */
+    public filter<T extends string | { path: string }>(user: string | null, repos: string | null, entries: T[], options?: Partial<AuthzFilterOptions>): Promise<T[]>;
+}
+
+export declare namespace authz {
+    /** A path to an authz file, or the content of one. */
+    function load(file_or_buffer: string | Buffer): Promise<Authz>;
+}
@@ -0,0 +1,185 @@
+#include "authz.hpp"
+
+#include <iterator>
+#include <map>
+#include <mutex>
+
+#include <apr_file_info.h>
+#include <apr_general.h>
+#include <apr_pools.h>
+
+#include <svn_io.h>
+#include <svn_pools.h>
+#include <svn_repos.h>
+#include <svn_string.h>
+
+#include <private/svn_fspath.h>
+
+#include "type_conversion.hpp"
+
+namespace svn {
+using pool_ptr = std::unique_ptr<apr_pool_t, decltype(&apr_pool_destroy)>;
+
+static pool_ptr create_pool() {
+    apr_pool_t* result;
+    check_result(apr_pool_create_ex(&result, nullptr, nullptr, nullptr));
+    return pool_ptr(result, apr_pool_destroy);
+}
+
+// The authz caches are global, set them up once.
+static void initialize() {
+    static std::once_flag flag;
+    std::call_once(flag, []() -> void {
+        check_result(apr_initialize());
+
+        apr_pool_t* pool;
+        check_result(apr_pool_create_ex(&pool, nullptr, nullptr, nullptr));
+        check_result(svn_repos_authz_initialize(pool));
+    });
+}
+
+// The file's size goes with its modification time, two writes in the same
+// tick of a coarse file system clock rarely leave the same size.
+struct file_version {
+    apr_time_t mtime;
+    apr_off_t  size;
+
+    bool operator==(const file_version& other) const {
+        return mtime == other.mtime && size == other.size;
+    }
+};
+
+static file_version get_file_version(const char* path, apr_pool_t* pool) {
+    apr_finfo_t info;
+    check_result(svn_io_stat(&info, path, APR_FINFO_MTIME | APR_FINFO_SIZE, pool));
+    return file_version{info.mtime, info.size};
+}
+
+struct authz::model {
+    model()
+        : pool(create_pool()) {
+    }
+
+    static std::shared_ptr<model> read(const char* path, const file_version& version) {
+        auto result     = std::make_shared<model>();
+        result->version = version;
+
+        auto pool = create_pool();
+        check_result(svn_repos_authz_read3(&result->rules, path, nullptr, true, nullptr, result->pool.get(), pool.get()));
+        return result;
+    }
+
+    static std::shared_ptr<model> parse(const std::string& content) {
+        auto result = std::make_shared<model>();
+
+        auto pool   = result->pool.get();
+        auto stream = svn_stream_from_string(svn_string_ncreate(content.data(), content.size(), pool), pool);
+        check_result(svn_repos_authz_parse(&result->rules, stream, nullptr, pool));
+        return result;
+    }
+
+    pool_ptr pool;
+    svn_authz_t* rules = nullptr;
+    file_version version{};
+
+    // held by checks, they fill the per-user caches in `pool`
+    std::mutex mutex;
+};
+
+static std::mutex                                       loaded_authz_mutex;
+static std::map<std::string, std::weak_ptr<svn::authz>> loaded_authz;
+
+std::shared_ptr<authz> authz::load(const std::string& path) {
+    initialize();
+
+    std::string key;
+    {
+        auto pool = create_pool();
+        key       = convert_from_path(path, pool.get());
+    }
+
+    std::lock_guard<std::mutex> lock(loaded_authz_mutex);
+
+    auto entry = loaded_authz.find(key);
+    if (entry != loaded_authz.end()) {
+        if (auto result = entry->second.lock()) {
+            return result;
+        }
+    }
+
+    // drops the rules released since, `key`'s too
+    for (auto it = loaded_authz.begin(); it != loaded_authz.end();) {
+        it = it->second.expired() ? loaded_authz.erase(it) : std::next(it);
+    }
+
+    auto result = std::shared_ptr<authz>(new authz(key));
+    // fails early when the file is missing or invalid
+    result->get_model();
+    loaded_authz[key] = result;
+    return result;
+}
+
+std::shared_ptr<authz> authz::parse(const std::string& content) {
+    initialize();
+
+    auto result    = std::shared_ptr<authz>(new authz(std::nullopt));
+    result->_model = model::parse(content);
+    return result;
+}
+
+authz::authz(std::optional<std::string> path)
+    : _path(std::move(path)) {
+}
+
+authz::~authz() {
+}
+
+std::shared_ptr<authz::model> authz::get_model() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_path.has_value()) {
+        auto pool    = create_pool();
+        auto version = get_file_version(_path->c_str(), pool.get());
+        if (!_model || !(_model->version == version)) {
+            _model = model::read(_path->c_str(), version);
+        }
+    }
+
+    return _model;
+}
+
+std::vector<bool> authz::check(const std::optional<std::string>& user,
+                               const std::optional<std::string>& repos,
+                               const std::vector<std::string>&   paths,
+                               authz_access                      access,
+                               bool                              recursive) {
+    auto model = get_model();
+
+    auto required = access == authz_access::write ? svn_authz_write : svn_authz_read;
+    if (recursive) {
+        required = static_cast<svn_repos_authz_access_t>(required | svn_authz_recursive);
+    }
+
+    auto raw_user  = user.has_value() ? user->c_str() : nullptr;
+    auto raw_repos = repos.has_value() ? repos->c_str() : nullptr;
+
+    std::vector<bool> result;
+    result.reserve(paths.size());
+
+    std::lock_guard<std::mutex> lock(model->mutex);
+
+    auto pool           = create_pool();
+    auto iteration_pool = svn_pool_create(pool.get());
+    for (const auto& path : paths) {
+        svn_pool_clear(iteration_pool);
+
+        auto raw_path = svn_fspath__canonicalize(convert_from_string(path), iteration_pool);
+
+        svn_boolean_t granted;
+        check_result(svn_repos_authz_check_access(model->rules, raw_repos, raw_path, raw_user, required, &granted, iteration_pool));
+        result.push_back(granted);
+    }
+
+    return result;
+}
+} // namespace svn
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct apr_pool_t;
+struct svn_authz_t;
+
+namespace svn {
+enum class authz_access {
+    read,
+    write,
+};
+
+// Path-based authorization rules, compiled once and shared by every `load`
+// of the same file. The file's modification time is checked before each
+// bulk check, the rules are compiled again when it changed.
+//
+// libsvn_repos caches per-user rules inside the compiled model, so checks on
+// the same rules take turns, they're a few microseconds per path anyway.
+class authz {
+  public:
+    static std::shared_ptr<authz> load(const std::string& path);
+    static std::shared_ptr<authz> parse(const std::string& content);
+
+    ~authz();
+
+    authz(const authz&) = delete;
+    authz& operator=(const authz&) = delete;
+
+    // Whether `user` has `access` to each of `paths`, anonymous when not set.
+    // Without `repos`, only the rules that don't name a repository apply.
+    // With `recursive`, the access must be granted to everything below too.
+    std::vector<bool> check(const std::optional<std::string>& user,
+                            const std::optional<std::string>& repos,
+                            const std::vector<std::string>&   paths,
+                            authz_access                      access,
+                            bool                              recursive);
+
+  private:
+    struct model;
+
+    explicit authz(std::optional<std::string> path);
+
+    std::shared_ptr<model> get_model();
+
+    const std::optional<std::string> _path;
+
+    std::mutex             _mutex;
+    std::shared_ptr<model> _model;
+};
+} // namespace svn
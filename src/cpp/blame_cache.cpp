@@ -0,0 +1,626 @@
+#include "blame_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <set>
+
+#include <apr_pools.h>
+
+#include <svn_delta.h>
+#include <svn_diff.h>
+#include <svn_dirent_uri.h>
+#include <svn_hash.h>
+#include <svn_io.h>
+#include <svn_props.h>
+#include <svn_ra.h>
+#include <svn_string.h>
+#include <svn_subst.h>
+#include <svn_time.h>
+
+#include <private/svn_sqlite.h>
+
+#include "type_conversion.hpp"
+
+namespace svn {
+// bumped whenever the serialized form changes, older entries become misses
+static const uint32_t format_version = 2;
+
+enum statement_index {
+    STMT_CREATE_SCHEMA,
+    STMT_SELECT_BLAME,
+    STMT_TOUCH_BLAME,
+    STMT_INSERT_BLAME,
+    STMT_SELECT_BY_AGE,
+    STMT_DELETE_BLAME,
+    STMT_COUNT_BLAMES,
+};
+
+static const char* const statements[] = {
+    // STMT_CREATE_SCHEMA
+    "CREATE TABLE IF NOT EXISTS blames ("
+    "  uuid TEXT NOT NULL,"
+    "  path TEXT NOT NULL,"
+    "  options INTEGER NOT NULL,"
+    "  revision INTEGER NOT NULL,"
+    "  data BLOB NOT NULL,"
+    "  size INTEGER NOT NULL,"
+    "  last_used INTEGER NOT NULL,"
+    "  PRIMARY KEY (uuid, path, options));"
+    "CREATE INDEX IF NOT EXISTS blames_last_used ON blames (last_used);",
+
+    // STMT_SELECT_BLAME
+    "SELECT rowid, revision, data FROM blames WHERE uuid = ?1 AND path = ?2 AND options = ?3",
+
+    // STMT_TOUCH_BLAME
+    "UPDATE blames SET last_used = ?2 WHERE rowid = ?1",
+
+    // STMT_INSERT_BLAME
+    "INSERT OR REPLACE INTO blames (uuid, path, options, revision, data, size, last_used)"
+    "  VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7)",
+
+    // STMT_SELECT_BY_AGE
+    "SELECT rowid, size FROM blames ORDER BY last_used DESC",
+
+    // STMT_DELETE_BLAME
+    "DELETE FROM blames WHERE rowid = ?1",
+
+    // STMT_COUNT_BLAMES
+    "SELECT COUNT(*) FROM blames",
+
+    nullptr,
+};
+
+template <class T>
+static void write(std::vector<char>& buffer, const T& value) {
+    auto data = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), data, data + sizeof(T));
+}
+
+template <class T>
+static void write(std::vector<char>& buffer, const std::vector<T>& value) {
+    write(buffer, static_cast<uint32_t>(value.size()));
+    auto data = reinterpret_cast<const char*>(value.data());
+    buffer.insert(buffer.end(), data, data + value.size() * sizeof(T));
+}
+
+static void write(std::vector<char>& buffer, const std::optional<std::string>& value) {
+    write(buffer, static_cast<uint8_t>(value.has_value()));
+    if (value) {
+        write(buffer, std::vector<char>(value->begin(), value->end()));
+    }
+}
+
+static std::vector<char> serialize(const blame_result& value) {
+    std::vector<char> buffer;
+    write(buffer, format_version);
+    write(buffer, value.content);
+    write(buffer, value.line_offsets);
+    write(buffer, value.revisions);
+    write(buffer, value.merged_revisions);
+
+    write(buffer, static_cast<uint32_t>(value.revision_table.size()));
+    for (auto& item : value.revision_table) {
+        write(buffer, item.revision);
+        write(buffer, item.author);
+        write(buffer, static_cast<uint8_t>(item.date.has_value()));
+        write(buffer, item.date.value_or(0));
+    }
+
+    return buffer;
+}
+
+struct reader {
+    const char* position;
+    const char* end;
+
+    template <class T>
+    bool read(T& value) {
+        if (static_cast<size_t>(end - position) < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+
+    template <class T>
+    bool read(std::vector<T>& value) {
+        uint32_t size;
+        if (!read(size) || static_cast<size_t>(end - position) / sizeof(T) < size) {
+            return false;
+        }
+        value.resize(size);
+        std::memcpy(value.data(), position, size * sizeof(T));
+        position += size * sizeof(T);
+        return true;
+    }
+
+    bool read(std::optional<std::string>& value) {
+        uint8_t has_value;
+        if (!read(has_value)) {
+            return false;
+        }
+        if (has_value) {
+            std::vector<char> buffer;
+            if (!read(buffer)) {
+                return false;
+            }
+            value.emplace(buffer.begin(), buffer.end());
+        }
+        return true;
+    }
+};
+
+static std::optional<blame_result> deserialize(const char* data, size_t size) {
+    reader       input{data, data + size};
+    blame_result value;
+
+    uint32_t version;
+    if (!input.read(version) || version != format_version) {
+        return {};
+    }
+
+    uint32_t count;
+    if (!input.read(value.content) ||
+        !input.read(value.line_offsets) ||
+        !input.read(value.revisions) ||
+        !input.read(value.merged_revisions) ||
+        !input.read(count)) {
+        return {};
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        blame_revision item{0, {}, {}};
+
+        uint8_t has_date;
+        int64_t date;
+        if (!input.read(item.revision) || !input.read(item.author) || !input.read(has_date) || !input.read(date)) {
+            return {};
+        }
+        if (has_date) {
+            item.date = date;
+        }
+
+        value.revision_table.push_back(std::move(item));
+    }
+
+    return value;
+}
+
+blame_cache::blame_cache(const std::string& directory, int64_t max_size)
+    : _max_size(max_size)
+    , _metrics{0, 0, 0, 0, 0} {
+    check_result(apr_pool_create_ex(&_pool, nullptr, nullptr, nullptr));
+
+    apr_pool_t* pool;
+    check_result(apr_pool_create_ex(&pool, _pool, nullptr, nullptr));
+
+    try {
+        auto raw_directory = convert_from_path(directory, pool);
+        check_result(svn_io_make_dir_recursively(raw_directory, pool));
+
+        check_result(svn_sqlite__open(&_db,
+                                      svn_dirent_join(raw_directory, "blame.db", pool),
+                                      svn_sqlite__mode_rwcreate,
+                                      statements,
+                                      0,
+                                      nullptr,
+                                      0,
+                                      _pool,
+                                      pool));
+        check_result(svn_sqlite__exec_statements(_db, STMT_CREATE_SCHEMA));
+    } catch (...) {
+        apr_pool_destroy(_pool);
+        throw;
+    }
+
+    apr_pool_destroy(pool);
+}
+
+blame_cache::~blame_cache() {
+    // closes the database
+    apr_pool_destroy(_pool);
+}
+
+std::optional<std::pair<int32_t, blame_result>> blame_cache::get(const key& key) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    svn_sqlite__stmt_t* stmt;
+    svn_boolean_t       have_row;
+
+    check_result(svn_sqlite__get_statement(&stmt, _db, STMT_SELECT_BLAME));
+    check_result(svn_sqlite__bindf(stmt, "ssd", key.uuid.c_str(), key.path.c_str(), static_cast<int>(key.options)));
+    check_result(svn_sqlite__step(&have_row, stmt));
+    if (!have_row) {
+        check_result(svn_sqlite__reset(stmt));
+        _metrics.misses++;
+        return {};
+    }
+
+    auto       row      = svn_sqlite__column_int64(stmt, 0);
+    auto       revision = static_cast<int32_t>(svn_sqlite__column_revnum(stmt, 1));
+    apr_size_t size;
+    auto       data  = static_cast<const char*>(svn_sqlite__column_blob(stmt, 2, &size, nullptr));
+    auto       value = deserialize(data, size);
+    check_result(svn_sqlite__reset(stmt));
+
+    if (!value) {
+        _metrics.misses++;
+        return {};
+    }
+
+    _metrics.hits++;
+
+    check_result(svn_sqlite__get_statement(&stmt, _db, STMT_TOUCH_BLAME));
+    check_result(svn_sqlite__bind_int64(stmt, 1, row));
+    check_result(svn_sqlite__bind_int64(stmt, 2, apr_time_now()));
+    check_result(svn_sqlite__update(nullptr, stmt));
+
+    return std::make_pair(revision, std::move(*value));
+}
+
+void blame_cache::put(const key& key, int32_t revision, const blame_result& value) {
+    auto data = serialize(value);
+    if (static_cast<int64_t>(data.size()) > _max_size) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    svn_sqlite__stmt_t* stmt;
+    check_result(svn_sqlite__get_statement(&stmt, _db, STMT_INSERT_BLAME));
+    check_result(svn_sqlite__bindf(stmt,
+                                   "ssdr",
+                                   key.uuid.c_str(),
+                                   key.path.c_str(),
+                                   static_cast<int>(key.options),
+                                   static_cast<svn_revnum_t>(revision)));
+    check_result(svn_sqlite__bind_blob(stmt, 5, data.data(), data.size()));
+    check_result(svn_sqlite__bind_int64(stmt, 6, data.size()));
+    check_result(svn_sqlite__bind_int64(stmt, 7, apr_time_now()));
+
+    apr_int64_t row;
+    check_result(svn_sqlite__insert(&row, stmt));
+
+    evict();
+}
+
+void blame_cache::evict() {
+    std::vector<apr_int64_t> evicted;
+
+    svn_sqlite__stmt_t* stmt;
+    svn_boolean_t       have_row;
+
+    // keeps the most recently used entries that fit
+    int64_t total = 0;
+    check_result(svn_sqlite__get_statement(&stmt, _db, STMT_SELECT_BY_AGE));
+    check_result(svn_sqlite__step(&have_row, stmt));
+    while (have_row) {
+        total += svn_sqlite__column_int64(stmt, 1);
+        if (total > _max_size) {
+            evicted.push_back(svn_sqlite__column_int64(stmt, 0));
+        }
+        check_result(svn_sqlite__step(&have_row, stmt));
+    }
+    check_result(svn_sqlite__reset(stmt));
+
+    for (auto row : evicted) {
+        check_result(svn_sqlite__get_statement(&stmt, _db, STMT_DELETE_BLAME));
+        check_result(svn_sqlite__bind_int64(stmt, 1, row));
+        check_result(svn_sqlite__step_done(stmt));
+    }
+    _metrics.evictions += evicted.size();
+}
+
+void blame_cache::add_extension() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _metrics.extensions++;
+}
+
+blame_cache_metrics blame_cache::get_metrics() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    svn_sqlite__stmt_t* stmt;
+    svn_boolean_t       have_row;
+
+    check_result(svn_sqlite__get_statement(&stmt, _db, STMT_COUNT_BLAMES));
+    check_result(svn_sqlite__step(&have_row, stmt));
+
+    auto result    = _metrics;
+    result.entries = have_row ? svn_sqlite__column_int64(stmt, 0) : 0;
+
+    check_result(svn_sqlite__reset(stmt));
+    return result;
+}
+
+void blame_cache::set_line_offsets(blame_result& result) {
+    auto& content = result.content;
+
+    result.line_offsets.assign(1, 0);
+    for (size_t i = 0; i < content.size(); i++) {
+        if (content[i] == '\n' || content[i] == '\r') {
+            if (content[i] == '\r' && i + 1 < content.size() && content[i + 1] == '\n') {
+                i++;
+            }
+            result.line_offsets.push_back(static_cast<uint32_t>(i + 1));
+        }
+    }
+    if (result.line_offsets.back() < content.size()) {
+        result.line_offsets.push_back(static_cast<uint32_t>(content.size()));
+    }
+}
+
+// Calls `callback(begin, end)` for every line of `text` without its end of
+// line, the same lines `svn_diff` sees.
+template <class Callback>
+static void split_lines(const char* text, size_t size, Callback callback) {
+    size_t start = 0;
+    for (size_t i = 0; i < size; i++) {
+        if (text[i] == '\n' || text[i] == '\r') {
+            callback(text + start, text + i);
+            if (text[i] == '\r' && i + 1 < size && text[i + 1] == '\n') {
+                i++;
+            }
+            start = i + 1;
+        }
+    }
+    if (start < size) {
+        callback(text + start, text + size);
+    }
+}
+
+struct annotate_baton {
+    const std::vector<int32_t>& original;
+    std::vector<int32_t>&       result;
+    int32_t                     revision;
+};
+
+static svn_error_t* output_common(void*     raw_baton,
+                                  apr_off_t original_start,
+                                  apr_off_t original_length,
+                                  apr_off_t modified_start,
+                                  apr_off_t modified_length,
+                                  apr_off_t latest_start,
+                                  apr_off_t latest_length) {
+    auto baton = static_cast<annotate_baton*>(raw_baton);
+    if (static_cast<size_t>(original_start + original_length) > baton->original.size()) {
+        return svn_error_create(SVN_ERR_INCORRECT_PARAMS, nullptr, "The cached blame doesn't match the repository");
+    }
+
+    auto begin = baton->original.begin() + original_start;
+    baton->result.insert(baton->result.end(), begin, begin + original_length);
+    return SVN_NO_ERROR;
+}
+
+static svn_error_t* output_modified(void*     raw_baton,
+                                    apr_off_t original_start,
+                                    apr_off_t original_length,
+                                    apr_off_t modified_start,
+                                    apr_off_t modified_length,
+                                    apr_off_t latest_start,
+                                    apr_off_t latest_length) {
+    auto baton = static_cast<annotate_baton*>(raw_baton);
+    baton->result.insert(baton->result.end(), static_cast<size_t>(modified_length), baton->revision);
+    return SVN_NO_ERROR;
+}
+
+struct extend_baton {
+    const blame_result&            base;
+    const svn_diff_file_options_t* options;
+    const std::string&             path;
+    int32_t                        from;
+
+    // texts of one revision live here until the next one
+    apr_pool_t* revision_pool;
+
+    bool                 started;
+    std::string          text;
+    std::vector<int32_t> annotations;
+
+    svn_stringbuf_t* pending;
+    int32_t          pending_revision;
+
+    std::map<int32_t, blame_revision> revisions;
+    std::optional<std::string>        mime_type;
+    std::optional<std::string>        eol_style;
+};
+
+static svn_error_t* finish_pending(extend_baton* baton, apr_pool_t* pool) {
+    if (baton->pending == nullptr) {
+        return SVN_NO_ERROR;
+    }
+
+    auto pending = baton->pending;
+
+    if (!baton->started) {
+        // the oldest file revision must be the text the annotation was
+        // computed for
+        auto&  base  = baton->base;
+        size_t index = 0;
+        auto   match = true;
+        split_lines(pending->data, pending->len, [&](const char* begin, const char* end) -> void {
+            if (!match || index + 1 >= base.line_offsets.size()) {
+                match = false;
+                return;
+            }
+
+            auto line_begin = base.content.begin() + base.line_offsets[index];
+            auto line_end   = base.content.begin() + base.line_offsets[index + 1];
+            while (line_end != line_begin && (line_end[-1] == '\n' || line_end[-1] == '\r')) {
+                line_end--;
+            }
+            match = std::equal(begin, end, line_begin, line_end);
+            index++;
+        });
+
+        if (!match || index != base.revisions.size()) {
+            return svn_error_create(SVN_ERR_INCORRECT_PARAMS, nullptr, "The cached blame doesn't match the repository");
+        }
+
+        baton->started     = true;
+        baton->annotations = base.revisions;
+    } else {
+        svn_string_t original{baton->text.data(), baton->text.size()};
+        svn_string_t modified{pending->data, pending->len};
+
+        svn_diff_t* diff;
+        SVN_ERR(svn_diff_mem_string_diff(&diff, &original, &modified, baton->options, pool));
+
+        std::vector<int32_t> annotations;
+        annotate_baton       annotate{baton->annotations, annotations, baton->pending_revision};
+
+        svn_diff_output_fns_t output{output_common, output_modified, nullptr, nullptr, nullptr};
+        SVN_ERR(svn_diff_output2(diff, &annotate, &output, nullptr, nullptr));
+
+        baton->annotations = std::move(annotations);
+    }
+
+    baton->text.assign(pending->data, pending->len);
+    baton->pending = nullptr;
+    apr_pool_clear(baton->revision_pool);
+
+    return SVN_NO_ERROR;
+}
+
+static svn_error_t* invoke_file_rev(void*                         raw_baton,
+                                    const char*                   path,
+                                    svn_revnum_t                  revision,
+                                    apr_hash_t*                   rev_props,
+                                    svn_boolean_t                 result_of_merge,
+                                    svn_txdelta_window_handler_t* delta_handler,
+                                    void**                        delta_baton,
+                                    apr_array_header_t*           prop_diffs,
+                                    apr_pool_t*                   pool) {
+    auto baton = static_cast<extend_baton*>(raw_baton);
+
+    SVN_ERR(finish_pending(baton, pool));
+
+    if (!baton->started && (revision > baton->from || baton->path != path)) {
+        return svn_error_create(SVN_ERR_INCORRECT_PARAMS, nullptr, "The cached blame doesn't match the repository");
+    }
+
+    for (auto i = 0; i < prop_diffs->nelts; i++) {
+        auto& prop = APR_ARRAY_IDX(prop_diffs, i, svn_prop_t);
+        std::optional<std::string>* value = nullptr;
+        if (strcmp(prop.name, SVN_PROP_MIME_TYPE) == 0) {
+            value = &baton->mime_type;
+        } else if (strcmp(prop.name, SVN_PROP_EOL_STYLE) == 0) {
+            value = &baton->eol_style;
+        }
+
+        if (value != nullptr) {
+            if (prop.value != nullptr) {
+                value->emplace(prop.value->data, prop.value->len);
+            } else {
+                value->reset();
+            }
+        }
+    }
+
+    if (baton->started) {
+        blame_revision item{static_cast<int32_t>(revision), {}, {}};
+
+        auto author = static_cast<svn_string_t*>(svn_hash_gets(rev_props, SVN_PROP_REVISION_AUTHOR));
+        if (author != nullptr) {
+            item.author = std::string(author->data, author->len);
+        }
+
+        auto date = static_cast<svn_string_t*>(svn_hash_gets(rev_props, SVN_PROP_REVISION_DATE));
+        if (date != nullptr) {
+            apr_time_t time;
+            auto       error = svn_time_from_cstring(&time, date->data, pool);
+            if (error == nullptr) {
+                item.date = time;
+            }
+            svn_error_clear(error);
+        }
+
+        baton->revisions.emplace(item.revision, std::move(item));
+    }
+
+    // no delta, the text didn't change
+    if (delta_handler == nullptr) {
+        return SVN_NO_ERROR;
+    }
+
+    baton->pending          = svn_stringbuf_create_empty(baton->revision_pool);
+    baton->pending_revision = static_cast<int32_t>(revision);
+
+    auto source = svn_stream_from_string(svn_string_ncreate(baton->text.data(), baton->text.size(), baton->revision_pool),
+                                         baton->revision_pool);
+    auto target = svn_stream_from_stringbuf(baton->pending, baton->revision_pool);
+    svn_txdelta_apply(source, target, nullptr, nullptr, baton->revision_pool, delta_handler, delta_baton);
+
+    return SVN_NO_ERROR;
+}
+
+blame_result blame_cache::extend(svn_ra_session_t*              session,
+                                 const std::string&             path,
+                                 int32_t                        from,
+                                 int32_t                        to,
+                                 const blame_result&            base,
+                                 const svn_diff_file_options_t* options,
+                                 bool                           ignore_mime_type,
+                                 apr_pool_t*                    pool) {
+    apr_pool_t* revision_pool;
+    check_result(apr_pool_create_ex(&revision_pool, pool, nullptr, nullptr));
+
+    extend_baton baton{base, options, path, from, revision_pool, false, {}, {}, nullptr, -1, {}, {}};
+
+    check_result(svn_ra_get_file_revs2(session, path.c_str() + 1, from, to, false, invoke_file_rev, &baton, pool));
+    check_result(finish_pending(&baton, pool));
+
+    if (!baton.started) {
+        check_result(svn_error_create(SVN_ERR_INCORRECT_PARAMS, nullptr, "The cached blame doesn't match the repository"));
+    }
+
+    // let svn report it
+    if (!ignore_mime_type && baton.mime_type && svn_mime_type_is_binary(baton.mime_type->c_str())) {
+        check_result(svn_error_create(SVN_ERR_CLIENT_IS_BINARY_FILE, nullptr, nullptr));
+    }
+
+    blame_result result;
+    result.content.assign(baton.text.begin(), baton.text.end());
+
+    // the repository keeps the normal form, translate it like `cat` does
+    const char* eol = nullptr;
+    if (baton.eol_style) {
+        svn_subst_eol_style_t style;
+        svn_subst_eol_style_from_value(&style, &eol, baton.eol_style->c_str());
+    }
+
+    if (eol != nullptr) {
+        auto translated = svn_stringbuf_create_empty(pool);
+        auto output     = svn_subst_stream_translated(svn_stream_from_stringbuf(translated, pool), eol, true, nullptr, false, pool);
+
+        auto length = static_cast<apr_size_t>(baton.text.size());
+        check_result(svn_stream_write(output, baton.text.data(), &length));
+        check_result(svn_stream_close(output));
+
+        result.content.assign(translated->data, translated->data + translated->len);
+    }
+
+    set_line_offsets(result);
+
+    if (baton.annotations.size() + 1 != result.line_offsets.size()) {
+        check_result(svn_error_create(SVN_ERR_INCORRECT_PARAMS, nullptr, "The cached blame doesn't match the repository"));
+    }
+
+    result.revisions = std::move(baton.annotations);
+    result.merged_revisions.assign(result.revisions.size(), -1);
+
+    for (auto& item : base.revision_table) {
+        baton.revisions.emplace(item.revision, item);
+    }
+
+    std::set<int32_t> used(result.revisions.begin(), result.revisions.end());
+    for (auto& pair : baton.revisions) {
+        if (used.find(pair.first) != used.end()) {
+            result.revision_table.push_back(std::move(pair.second));
+        }
+    }
+
+    return result;
+}
+} // namespace svn
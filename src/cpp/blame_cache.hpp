@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <cpp/types.hpp>
+
+struct apr_pool_t;
+struct svn_diff_file_options_t;
+struct svn_ra_session_t;
+struct svn_sqlite__db_t;
+
+namespace svn {
+// Compact blames of whole file histories, kept in one SQLite database and
+// evicted least recently used first once they take more than a size limit.
+//
+// An annotation up to some revision is extended to a younger one by
+// applying only the file revisions in between.
+class blame_cache {
+  public:
+    struct key {
+        std::string uuid;
+        // in the end revision, relative to the root with a leading slash
+        std::string path;
+        // the diff options the annotation was computed with
+        int32_t options;
+    };
+
+    blame_cache(const std::string& directory, int64_t max_size);
+    ~blame_cache();
+
+    blame_cache(const blame_cache&) = delete;
+    blame_cache& operator=(const blame_cache&) = delete;
+
+    // The cached annotation and the revision it ends at.
+    std::optional<std::pair<int32_t, blame_result>> get(const key& key);
+    void put(const key& key, int32_t revision, const blame_result& value);
+
+    // Counts an annotation extended from an older cached one.
+    void add_extension();
+
+    // `hits` include annotations older than the one asked for.
+    blame_cache_metrics get_metrics();
+
+    // Sets `line_offsets` of `result` from its `content`, every line ends
+    // after its end of line. CR, LF and CRLF all end lines, like in svn_diff.
+    static void set_line_offsets(blame_result& result);
+
+    // Extends `base`, the annotation of `path` up to `from`, to `to`.
+    // `session` must be parented at the repository root. Throws when the
+    // history between them doesn't continue `base`.
+    static blame_result extend(svn_ra_session_t*              session,
+                               const std::string&             path,
+                               int32_t                        from,
+                               int32_t                        to,
+                               const blame_result&            base,
+                               const svn_diff_file_options_t* options,
+                               bool                           ignore_mime_type,
+                               apr_pool_t*                    pool);
+
+  private:
+    void evict();
+
+    std::mutex        _mutex;
+    int64_t           _max_size;
+    apr_pool_t*       _pool;
+    svn_sqlite__db_t* _db;
+
+    blame_cache_metrics _metrics;
+};
+} // namespace svn
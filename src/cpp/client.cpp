@@ -1,15 +1,38 @@
 #include "client.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <set>
+#include <tuple>
 #include <utility>
 
+#include <apr_file_info.h>
+#include <apr_file_io.h>
 #include <apr_hash.h>
+#include <apr_mmap.h>
 #include <apr_pools.h>
+#include <apr_strings.h>
 
+#include <svn_checksum.h>
 #include <svn_client.h>
 #include <svn_compat.h>
+#include <svn_dirent_uri.h>
+#include <svn_hash.h>
 #include <svn_path.h>
-
+#include <svn_props.h>
+#include <svn_ra.h>
+#include <svn_string.h>
+#include <svn_subst.h>
+#include <svn_time.h>
+#include <svn_wc.h>
+
+#include "blame_cache.hpp"
+#include "fetch_cache.hpp"
+#include "log_cache.hpp"
+#include "lru_cache.hpp"
 #include "malloc.hpp"
+#include "rangelist.hpp"
 #include "type_conversion.hpp"
 
 static svn_error_t* throw_on_malfunction(svn_boolean_t can_return,
@@ -84,6 +107,112 @@ static auto get_reference(void* ref) {
     return static_cast<std::reference_wrapper<const T>*>(ref)->get();
 }
 
+// An RA session opened for one repository, shared by all targets of a call
+// that live in that repository.
+struct ra_session {
+    const char*       root;
+    const char*       uuid;
+    svn_ra_session_t* session;
+    svn_revnum_t      youngest;
+
+    svn_revnum_t resolve_revision(const svn_opt_revision_t& revision, apr_pool_t* pool) {
+        switch (revision.kind) {
+            case svn_opt_revision_number:
+                return revision.value.number;
+            case svn_opt_revision_date: {
+                svn_revnum_t result;
+                check_result(svn_ra_get_dated_revision(session, &result, revision.value.date, pool));
+                return result;
+            }
+            case svn_opt_revision_unspecified:
+            case svn_opt_revision_head:
+                if (!SVN_IS_VALID_REVNUM(youngest)) {
+                    check_result(svn_ra_get_latest_revnum(session, &youngest, pool));
+                }
+                return youngest;
+            default:
+                // working copy relative revisions have no meaning for URLs
+                throw svn::svn_type_error("");
+        }
+    }
+};
+
+// Opens at most one RA session per repository and reparents it between
+// targets, instead of paying a new connection (and authentication) for
+// every URL.
+struct ra_session_cache {
+    explicit ra_session_cache(svn_client_ctx_t* context, apr_pool_t* pool)
+        : _context(context)
+        , _pool(pool) {}
+
+    ra_session& open(const char* url, apr_pool_t* scratch_pool) {
+        auto& item = find_or_open(url, scratch_pool);
+        reparent(item, url, scratch_pool);
+        return item;
+    }
+
+    // Parents the session at the repository root, so targets can be passed
+    // as relative paths without a reparent for each of them.
+    ra_session& open_root(const char* url, apr_pool_t* scratch_pool) {
+        auto& item = find_or_open(url, scratch_pool);
+        reparent(item, item.root, scratch_pool);
+        return item;
+    }
+
+  private:
+    ra_session& find_or_open(const char* url, apr_pool_t* scratch_pool) {
+        for (auto& item : _sessions) {
+            if (svn_uri_skip_ancestor(item.root, url, scratch_pool) != nullptr) {
+                return item;
+            }
+        }
+
+        ra_session item{nullptr, nullptr, nullptr, SVN_INVALID_REVNUM};
+        check_result(svn_client_open_ra_session2(&item.session, url, nullptr, _context, _pool, scratch_pool));
+        check_result(svn_ra_get_repos_root2(item.session, &item.root, _pool));
+        check_result(svn_ra_get_uuid2(item.session, &item.uuid, _pool));
+
+        _sessions.push_back(item);
+        return _sessions.back();
+    }
+
+    static void reparent(ra_session& item, const char* url, apr_pool_t* scratch_pool) {
+        const char* current;
+        check_result(svn_ra_get_session_url(item.session, &current, scratch_pool));
+
+        if (std::strcmp(current, url) != 0) {
+            check_result(svn_ra_reparent(item.session, url, scratch_pool));
+        }
+    }
+
+    svn_client_ctx_t*     _context;
+    apr_pool_t*           _pool;
+    std::list<ra_session> _sessions;
+};
+
+// Returns the revision an operation is evaluated at, if both revisions
+// agree, i.e. no history tracing is involved.
+static const svn_opt_revision_t* get_fixed_revision(const svn_opt_revision_t& peg_revision,
+                                                    const svn_opt_revision_t& revision) {
+    if (revision.kind == svn_opt_revision_unspecified)
+        return &peg_revision;
+
+    if (peg_revision.kind == svn_opt_revision_unspecified)
+        return &revision;
+
+    if (peg_revision.kind != revision.kind)
+        return nullptr;
+
+    switch (revision.kind) {
+        case svn_opt_revision_number:
+            return peg_revision.value.number == revision.value.number ? &revision : nullptr;
+        case svn_opt_revision_date:
+            return peg_revision.value.date == revision.value.date ? &revision : nullptr;
+        default:
+            return &revision;
+    }
+}
+
 static svn_error_t* invoke_log_message(const char**              log_msg,
                                        const char**              tmp_file,
                                        const apr_array_header_t* commit_items,
@@ -98,14 +227,21 @@ struct notify_scope {
   public:
     explicit notify_scope(svn_client_ctx_t*                   context,
                           const svn::client::notify_function& notify)
+        : notify_scope(context, _invoke, this) {
+        _notify = &notify;
+    }
+
+    explicit notify_scope(svn_client_ctx_t*     context,
+                          svn_wc_notify_func2_t function,
+                          void*                 baton)
         : _context(context)
-        , _notify(notify) {
+        , _notify(nullptr) {
         if (_context->notify_func2 != nullptr) {
             throw svn::svn_error(-1, "");
         }
 
-        _context->notify_baton2 = this;
-        _context->notify_func2  = _invoke;
+        _context->notify_baton2 = baton;
+        _context->notify_func2  = function;
     }
 
     ~notify_scope() {
@@ -124,11 +260,11 @@ struct notify_scope {
             notify->path,
             convert_to_revision_number(notify->revision)};
 
-        _this->_notify(info);
+        (*_this->_notify)(info);
     }
 
     svn_client_ctx_t*                   _context;
-    const svn::client::notify_function& _notify;
+    const svn::client::notify_function* _notify;
 };
 
 static svn_error_t* invoke_get_simple_prompt_provider(svn_auth_cred_simple_t** credential,
@@ -170,9 +306,144 @@ static svn_error_t* invoke_cancel_func(void* raw_baton) {
 }
 
 namespace svn {
+// Inherited properties of a node are the explicit properties of its parents,
+// so siblings share them. They are immutable at a fixed revision and are
+// memoized per (repository root, revision, parent path).
+struct client::inherited_properties_cache {
+    static const size_t max_entries = 4096;
+
+    std::vector<inherited_property> get(ra_session&  session,
+                                        const char*  url,
+                                        svn_revnum_t revision,
+                                        apr_pool_t*  pool) {
+        const char* relpath;
+        check_result(svn_ra_get_path_relative_to_root(session.session, &relpath, url, pool));
+
+        // repository root inherits nothing
+        if (*relpath == '\0') {
+            return std::vector<inherited_property>();
+        }
+
+        auto key = std::make_tuple(std::string(session.root),
+                                   static_cast<int32_t>(revision),
+                                   std::string(svn_relpath_dirname(relpath, pool)));
+
+        if (auto entry = _entries.get(key)) {
+            return *entry;
+        }
+
+        apr_array_header_t* raw_inherited_props;
+        check_result(svn_ra_get_inherited_props(session.session, &raw_inherited_props, "", revision, pool, pool));
+
+        // RA layer reports repository relative paths, libsvn_client reports URLs
+        for (auto i = 0; i < raw_inherited_props->nelts; i++) {
+            auto item         = APR_ARRAY_IDX(raw_inherited_props, i, svn_prop_inherited_item_t*);
+            item->path_or_url = svn_path_url_add_component2(session.root, item->path_or_url, pool);
+        }
+
+        auto result = convert_to_inherited_properties(raw_inherited_props, pool);
+        _entries.set(key, result);
+        return result;
+    }
+
+    void set_capacity(size_t capacity) {
+        _entries.set_capacity(capacity);
+    }
+
+    cache_metrics get_metrics() const {
+        return _entries.get_metrics();
+    }
+
+  private:
+    using key_type = std::tuple<std::string, int32_t, std::string>;
+
+    lru_cache<key_type, std::vector<inherited_property>> _entries{max_entries};
+};
+
+static svn_error_t* invoke_location_segment(svn_location_segment_t* segment, void* raw_baton, apr_pool_t* pool) {
+    auto segments = static_cast<std::vector<location_segment>*>(raw_baton);
+    segments->push_back(location_segment{static_cast<int32_t>(segment->range_start),
+                                         static_cast<int32_t>(segment->range_end),
+                                         convert_to_optional_string(segment->path)});
+    return nullptr;
+}
+
+// Both the mergeinfo of a node and the history of a node are immutable once
+// their revision is fixed, so they are memoized per (URL, revision) and
+// reused by every following `mergeinfo_log` call on the same branches.
+struct client::mergeinfo_cache {
+    static const size_t max_entries = 1024;
+
+    svn::mergeinfo get_mergeinfo(ra_session_cache&         sessions,
+                                 const char*               target,
+                                 const svn_opt_revision_t& peg_revision,
+                                 svn_client_ctx_t*         context,
+                                 apr_pool_t*               pool) {
+        auto                    raw_peg_revision = peg_revision;
+        std::optional<key_type> key;
+
+        // working copies may have local mergeinfo changes
+        if (svn_path_is_url(target)) {
+            auto& session = sessions.open(target, pool);
+
+            raw_peg_revision.kind         = svn_opt_revision_number;
+            raw_peg_revision.value.number = session.resolve_revision(peg_revision, pool);
+
+            key = std::make_tuple(std::string(target), static_cast<int32_t>(raw_peg_revision.value.number));
+            if (auto entry = _mergeinfo.get(*key)) {
+                return *entry;
+            }
+        }
+
+        apr_hash_t* raw_mergeinfo;
+        check_result(svn_client_mergeinfo_get_merged(&raw_mergeinfo, target, &raw_peg_revision, context, pool));
+
+        auto result = convert_to_mergeinfo(raw_mergeinfo, pool);
+        for (auto& item : result) {
+            item.second = rangelist::normalize(std::move(item.second));
+        }
+
+        if (key) {
+            _mergeinfo.set(*key, result);
+        }
+        return result;
+    }
+
+    std::vector<location_segment> get_segments(ra_session&  session,
+                                               const char*  url,
+                                               svn_revnum_t peg_revision,
+                                               apr_pool_t*  pool) {
+        auto key = std::make_tuple(std::string(url), static_cast<int32_t>(peg_revision));
+        if (auto entry = _segments.get(key)) {
+            return *entry;
+        }
+
+        std::vector<location_segment> result;
+        check_result(svn_ra_get_location_segments(session.session,
+                                                  "",
+                                                  peg_revision,
+                                                  peg_revision,
+                                                  0,
+                                                  invoke_location_segment,
+                                                  &result,
+                                                  pool));
+
+        _segments.set(key, result);
+        return result;
+    }
+
+  private:
+    using key_type = std::tuple<std::string, int32_t>;
+
+    lru_cache<key_type, svn::mergeinfo>                _mergeinfo{max_entries};
+    lru_cache<key_type, std::vector<location_segment>> _segments{max_entries};
+};
+
 bool client::_apr_initialized = false;
 
-client::client(const std::optional<const std::string>& config_path) {
+client::client(const std::optional<const std::string>& config_path)
+    : _inherited_properties_cache(std::make_unique<inherited_properties_cache>())
+    , _mergeinfo_cache(std::make_unique<mergeinfo_cache>()) {
     if (!_apr_initialized) {
         apr_initialize();
     }
@@ -221,7 +492,12 @@ client::client(const std::optional<const std::string>& config_path) {
 
 client::client(client&& other)
     : _pool(std::exchange(other._pool, nullptr))
-    , _context(std::exchange(other._context, nullptr)) {
+    , _context(std::exchange(other._context, nullptr))
+    , _inherited_properties_cache(std::move(other._inherited_properties_cache))
+    , _mergeinfo_cache(std::move(other._mergeinfo_cache))
+    , _log_cache(std::move(other._log_cache))
+    , _blame_cache(std::move(other._blame_cache))
+    , _fetch_cache(std::move(other._fetch_cache)) {
 }
 
 client& client::operator=(client&& other) {
@@ -233,6 +509,12 @@ client& client::operator=(client&& other) {
 
         _pool    = std::exchange(other._pool, nullptr);
         _context = std::exchange(other._context, nullptr);
+
+        _inherited_properties_cache = std::move(other._inherited_properties_cache);
+        _mergeinfo_cache            = std::move(other._mergeinfo_cache);
+        _log_cache                  = std::move(other._log_cache);
+        _blame_cache                = std::move(other._blame_cache);
+        _fetch_cache                = std::move(other._fetch_cache);
     }
     return *this;
 }
@@ -275,6 +557,65 @@ std::optional<simple_auth> client::invoke_simple_auth_providers(const std::strin
     return {};
 }
 
+void client::set_log_cache(const std::optional<const std::string>& directory) {
+    std::shared_ptr<log_cache> cache;
+    if (directory) {
+        cache = std::make_shared<log_cache>(*directory);
+    }
+    std::atomic_store(&_log_cache, std::move(cache));
+}
+
+cache_metrics client::get_log_cache_metrics() const {
+    auto cache = std::atomic_load(&_log_cache);
+    if (!cache) {
+        return cache_metrics{0, 0, 0, 0};
+    }
+
+    return cache->get_metrics();
+}
+
+void client::set_blame_cache(const std::optional<const std::string>& directory, int64_t max_size) {
+    std::shared_ptr<blame_cache> cache;
+    if (directory) {
+        cache = std::make_shared<blame_cache>(*directory, max_size);
+    }
+    std::atomic_store(&_blame_cache, std::move(cache));
+}
+
+blame_cache_metrics client::get_blame_cache_metrics() const {
+    auto cache = std::atomic_load(&_blame_cache);
+    if (!cache) {
+        return blame_cache_metrics{0, 0, 0, 0, 0};
+    }
+
+    return cache->get_metrics();
+}
+
+void client::set_fetch_cache(const std::optional<const std::string>& directory, int64_t max_size) {
+    std::shared_ptr<fetch_cache> cache;
+    if (directory) {
+        cache = std::make_shared<fetch_cache>(*directory, max_size);
+    }
+    std::atomic_store(&_fetch_cache, std::move(cache));
+}
+
+void client::set_inherited_properties_cache_size(size_t max_entries) {
+    _inherited_properties_cache->set_capacity(max_entries);
+}
+
+cache_metrics client::get_inherited_properties_cache_metrics() const {
+    return _inherited_properties_cache->get_metrics();
+}
+
+fetch_cache_metrics client::get_fetch_cache_metrics() const {
+    auto cache = std::atomic_load(&_fetch_cache);
+    if (!cache) {
+        return fetch_cache_metrics{0, 0, 0, 0, 0};
+    }
+
+    return cache->get_metrics();
+}
+
 void client::add_to_changelist(const std::vector<std::string>&                      paths,
                                const std::string&                                   changelist,
                                svn::depth                                           depth,
@@ -425,6 +766,410 @@ svn_error_t* invoke_cat_callback(void*       raw_baton,
     return callback->invoke(data, *len);
 }
 
+struct blame_compact_baton {
+    blame_result&                     result;
+    std::map<int32_t, blame_revision> revisions;
+};
+
+static void add_blame_revision(blame_compact_baton* baton,
+                               svn_revnum_t         revision,
+                               apr_hash_t*          rev_props,
+                               apr_pool_t*          pool) {
+    if (!SVN_IS_VALID_REVNUM(revision) || rev_props == nullptr) {
+        return;
+    }
+
+    auto raw_revision = static_cast<int32_t>(revision);
+    if (baton->revisions.find(raw_revision) != baton->revisions.end()) {
+        return;
+    }
+
+    blame_revision item{raw_revision, {}, {}};
+
+    auto author = static_cast<svn_string_t*>(svn_hash_gets(rev_props, SVN_PROP_REVISION_AUTHOR));
+    if (author != nullptr) {
+        item.author = std::string(author->data, author->len);
+    }
+
+    auto date = static_cast<svn_string_t*>(svn_hash_gets(rev_props, SVN_PROP_REVISION_DATE));
+    if (date != nullptr) {
+        apr_time_t time;
+        auto       error = svn_time_from_cstring(&time, date->data, pool);
+        if (error == nullptr) {
+            item.date = time;
+        }
+        svn_error_clear(error);
+    }
+
+    baton->revisions.emplace(raw_revision, std::move(item));
+}
+
+static svn_error_t* invoke_vector_write(void* raw_baton, const char* data, apr_size_t* length) {
+    auto vector = static_cast<std::vector<char>*>(raw_baton);
+    vector->insert(vector->end(), data, data + *length);
+    return nullptr;
+}
+
+static svn_error_t* invoke_blame_compact(void*         raw_baton,
+                                         svn_revnum_t  start_revnum,
+                                         svn_revnum_t  end_revnum,
+                                         apr_int64_t   line_no,
+                                         svn_revnum_t  revision,
+                                         apr_hash_t*   rev_props,
+                                         svn_revnum_t  merged_revision,
+                                         apr_hash_t*   merged_rev_props,
+                                         const char*   merged_path,
+                                         const char*   line,
+                                         svn_boolean_t local_change,
+                                         apr_pool_t*   pool) {
+    auto  baton  = static_cast<blame_compact_baton*>(raw_baton);
+    auto& result = baton->result;
+
+    // `line` has its end of line normalized away, the text is read afterwards
+    result.revisions.push_back(SVN_IS_VALID_REVNUM(revision) ? static_cast<int32_t>(revision) : -1);
+    result.merged_revisions.push_back(SVN_IS_VALID_REVNUM(merged_revision) ? static_cast<int32_t>(merged_revision) : -1);
+
+    add_blame_revision(baton, revision, rev_props, pool);
+    add_blame_revision(baton, merged_revision, merged_rev_props, pool);
+
+    return SVN_NO_ERROR;
+}
+
+static svn_error_t* invoke_location_info(void*                     raw_baton,
+                                         const char*               abspath_or_url,
+                                         const svn_client_info2_t* info,
+                                         apr_pool_t*               pool) {
+    auto baton = static_cast<svn_client_info2_t**>(raw_baton);
+    *baton     = svn_client_info2_dup(info, pool);
+    return nullptr;
+}
+
+// Reads the URL and the revision of a working copy path at a working copy
+// relative revision, without contacting the repository.
+static void get_wc_location(const char*           path,
+                            svn_opt_revision_kind kind,
+                            const char**          url,
+                            svn_revnum_t*         revision,
+                            svn_client_ctx_t*     context,
+                            apr_pool_t*           pool) {
+    svn_opt_revision_t  local{svn_opt_revision_unspecified};
+    svn_client_info2_t* info = nullptr;
+    check_result(svn_client_info4(path,
+                                  &local,
+                                  &local,
+                                  svn_depth_empty,
+                                  false,
+                                  true,
+                                  false,
+                                  nullptr,
+                                  invoke_location_info,
+                                  &info,
+                                  context,
+                                  pool));
+
+    if (info == nullptr || info->URL == nullptr) {
+        check_result(svn_error_createf(SVN_ERR_ENTRY_MISSING_URL,
+                                       nullptr,
+                                       "'%s' has no URL",
+                                       svn_dirent_local_style(path, pool)));
+    }
+
+    *url = info->URL;
+    switch (kind) {
+        case svn_opt_revision_committed:
+            *revision = info->last_changed_rev;
+            break;
+        case svn_opt_revision_previous:
+            *revision = info->last_changed_rev - 1;
+            break;
+        default:
+            *revision = info->rev;
+            break;
+    }
+}
+
+// Finds the URL and the revision a path or URL at a peg revision stands for,
+// and opens a session on that URL. Working copy pegs are read from the
+// working copy, without contacting the repository.
+static ra_session& open_location(ra_session_cache&         sessions,
+                                 const char*               target,
+                                 const svn_opt_revision_t& peg_revision,
+                                 const char**              url,
+                                 svn_revnum_t*             revision,
+                                 svn_client_ctx_t*         context,
+                                 apr_pool_t*               pool) {
+    if (svn_path_is_url(target)) {
+        *url          = target;
+        auto& session = sessions.open(target, pool);
+        *revision     = session.resolve_revision(peg_revision, pool);
+        return session;
+    }
+
+    switch (peg_revision.kind) {
+        case svn_opt_revision_unspecified:
+        case svn_opt_revision_base:
+        case svn_opt_revision_working:
+        case svn_opt_revision_committed:
+        case svn_opt_revision_previous:
+            get_wc_location(target, peg_revision.kind, url, revision, context, pool);
+            return sessions.open(*url, pool);
+        default: {
+            check_result(svn_client_url_from_path2(url, target, context, pool, pool));
+
+            auto& session = sessions.open(*url, pool);
+            *revision     = session.resolve_revision(peg_revision, pool);
+            return session;
+        }
+    }
+}
+
+// Finds the cache key of a blame, when it covers the whole history up to a
+// repository revision. `session` is left parented at the repository root.
+static std::optional<blame_cache::key> get_blame_cache_key(ra_session_cache&         sessions,
+                                                           const char*               target,
+                                                           const svn_opt_revision_t& peg_revision,
+                                                           const svn_opt_revision_t& start_revision,
+                                                           const svn_opt_revision_t& end_revision,
+                                                           int32_t                   options,
+                                                           ra_session**              session,
+                                                           svn_revnum_t*             revision,
+                                                           svn_client_ctx_t*         context,
+                                                           apr_pool_t*               pool) {
+    if (start_revision.kind != svn_opt_revision_number || start_revision.value.number != 0) {
+        return {};
+    }
+
+    if (end_revision.kind != svn_opt_revision_number && end_revision.kind != svn_opt_revision_head) {
+        return {};
+    }
+
+    const char*  url;
+    svn_revnum_t peg;
+    open_location(sessions, target, peg_revision, &url, &peg, context, pool);
+
+    *session  = &sessions.open_root(url, pool);
+    *revision = (*session)->resolve_revision(end_revision, pool);
+
+    auto path = std::string("/") + svn_uri_skip_ancestor((*session)->root, url, pool);
+    if (*revision != peg) {
+        auto revisions                          = apr_array_make(pool, 1, sizeof(svn_revnum_t));
+        APR_ARRAY_PUSH(revisions, svn_revnum_t) = *revision;
+
+        apr_hash_t* locations;
+        check_result(svn_ra_get_locations((*session)->session, &locations, path.c_str() + 1, peg, revisions, pool));
+
+        auto location = static_cast<const char*>(apr_hash_get(locations, revision, sizeof(svn_revnum_t)));
+        if (location == nullptr) {
+            return {};
+        }
+        path = location;
+    }
+
+    return blame_cache::key{(*session)->uuid, path, options};
+}
+
+blame_result client::blame_compact(const std::string& path,
+                                   const revision&    start_revision,
+                                   const revision&    end_revision,
+                                   const revision&    peg_revision,
+                                   diff_ignore_space  ignore_space,
+                                   bool               ignore_eol_style,
+                                   bool               ignore_mime_type,
+                                   bool               include_merged_revisions) const {
+    child_pool pool(_pool);
+
+    auto raw_path           = convert_from_path_or_url(path, pool);
+    auto raw_start_revision = convert_from_revision(start_revision);
+    auto raw_end_revision   = convert_from_revision(end_revision);
+    auto raw_peg_revision   = convert_from_revision(peg_revision);
+
+    auto options              = svn_diff_file_options_create(pool);
+    options->ignore_space     = static_cast<svn_diff_file_ignore_space_t>(ignore_space);
+    options->ignore_eol_style = ignore_eol_style;
+
+    ra_session_cache                sessions(_context, pool);
+    ra_session*                     session = nullptr;
+    svn_revnum_t                    cache_revision = SVN_INVALID_REVNUM;
+    std::optional<blame_cache::key> cache_key;
+    std::optional<int32_t>          cached_revision;
+
+    auto cache = std::atomic_load(&_blame_cache);
+    if (cache && !include_merged_revisions) {
+        auto cache_options = static_cast<int32_t>(ignore_space) | (ignore_eol_style << 2) | (ignore_mime_type << 3);
+
+        cache_key = get_blame_cache_key(sessions,
+                                        raw_path,
+                                        raw_peg_revision,
+                                        raw_start_revision,
+                                        raw_end_revision,
+                                        cache_options,
+                                        &session,
+                                        &cache_revision,
+                                        _context,
+                                        pool);
+    }
+
+    if (cache_key) {
+        auto cached = cache->get(*cache_key);
+        if (cached) {
+            cached_revision = cached->first;
+        }
+
+        if (cached && cached->first == cache_revision) {
+            return std::move(cached->second);
+        }
+
+        if (cached && cached->first < cache_revision) {
+            try {
+                auto result = blame_cache::extend(session->session,
+                                                  cache_key->path,
+                                                  cached->first,
+                                                  static_cast<int32_t>(cache_revision),
+                                                  cached->second,
+                                                  options,
+                                                  ignore_mime_type,
+                                                  pool);
+                cache->put(*cache_key, static_cast<int32_t>(cache_revision), result);
+                cache->add_extension();
+                return result;
+            } catch (const svn_error& error) {
+                if (error.code == SVN_ERR_CANCELLED) {
+                    throw;
+                }
+                // a different node at the same path, or a binary file, blame
+                // the whole history instead
+            }
+        }
+    }
+
+    blame_result        result;
+    blame_compact_baton baton{result, {}};
+
+    check_result(svn_client_blame5(raw_path,
+                                   &raw_peg_revision,
+                                   &raw_start_revision,
+                                   &raw_end_revision,
+                                   options,
+                                   ignore_mime_type,
+                                   include_merged_revisions,
+                                   invoke_blame_compact,
+                                   &baton,
+                                   _context,
+                                   pool));
+
+    result.revision_table.reserve(baton.revisions.size());
+    for (auto& pair : baton.revisions) {
+        result.revision_table.push_back(std::move(pair.second));
+    }
+
+    // the same text svn_client_blame5 split, with the ends of lines it dropped
+    auto stream = svn_stream_create(&result.content, pool);
+    svn_stream_set_write(stream, invoke_vector_write);
+    check_result(svn_client_cat3(nullptr, stream, raw_path, &raw_peg_revision, &raw_end_revision, false, _context, pool, pool));
+
+    if (result.content.size() > UINT32_MAX) {
+        throw svn_error(SVN_ERR_INCORRECT_PARAMS, "The file is too large to blame in compact mode");
+    }
+
+    blame_cache::set_line_offsets(result);
+    if (result.line_offsets.size() != result.revisions.size() + 1) {
+        throw svn_error(SVN_ERR_INCORRECT_PARAMS, "The file changed while it was blamed");
+    }
+
+    // don't replace a younger annotation, it's the one extended next time
+    if (cache_key && (!cached_revision || *cached_revision < cache_revision)) {
+        cache->put(*cache_key, static_cast<int32_t>(cache_revision), result);
+    }
+
+    return result;
+}
+
+// Fetches a file over an existing session in a single request, then applies
+// the same keyword and eol translation as svn_client_cat3 (which asks the
+// server twice: once for the properties, once for the content).
+//
+// With a `cache`, the content comes from it whenever it has been fetched
+// before.
+static void fetch_file(ra_session&  session,
+                       const char*  url,
+                       svn_revnum_t revision,
+                       bool         expand_keywords,
+                       fetch_cache* cache,
+                       cat_item&    item,
+                       apr_pool_t*  pool) {
+    auto relpath = svn_uri_skip_ancestor(session.root, url, pool);
+
+    // fetched straight into the result, only translation needs a copy
+    item.content.clear();
+
+    apr_hash_t* raw_props;
+    if (cache != nullptr) {
+        cache->get_file(session.session, session.uuid, relpath, static_cast<int32_t>(revision), item.content, &raw_props, pool);
+    } else {
+        auto stream = svn_stream_create(&item.content, pool);
+        svn_stream_set_write(stream, invoke_vector_write);
+
+        check_result(svn_ra_get_file(session.session, relpath, revision, stream, nullptr, &raw_props, pool));
+    }
+
+    auto eol_style = static_cast<svn_string_t*>(svn_hash_gets(raw_props, SVN_PROP_EOL_STYLE));
+    auto keywords  = static_cast<svn_string_t*>(svn_hash_gets(raw_props, SVN_PROP_KEYWORDS));
+
+    const char* eol = nullptr;
+    if (eol_style != nullptr) {
+        svn_subst_eol_style_t style;
+        svn_subst_eol_style_from_value(&style, &eol, eol_style->data);
+    }
+
+    apr_hash_t* raw_keywords = nullptr;
+    if (keywords != nullptr && expand_keywords) {
+        auto committed_rev  = static_cast<svn_string_t*>(svn_hash_gets(raw_props, SVN_PROP_ENTRY_COMMITTED_REV));
+        auto committed_date = static_cast<svn_string_t*>(svn_hash_gets(raw_props, SVN_PROP_ENTRY_COMMITTED_DATE));
+        auto last_author    = static_cast<svn_string_t*>(svn_hash_gets(raw_props, SVN_PROP_ENTRY_LAST_AUTHOR));
+
+        apr_time_t date = 0;
+        if (committed_date != nullptr) {
+            check_result(svn_time_from_cstring(&date, committed_date->data, pool));
+        }
+
+        check_result(svn_subst_build_keywords3(&raw_keywords,
+                                               keywords->data,
+                                               committed_rev != nullptr ? committed_rev->data : "",
+                                               url,
+                                               session.root,
+                                               date,
+                                               last_author != nullptr ? last_author->data : nullptr,
+                                               pool));
+    }
+
+    if (eol != nullptr || raw_keywords != nullptr) {
+        std::vector<char> translated;
+        translated.reserve(item.content.size());
+
+        auto output = svn_stream_create(&translated, pool);
+        svn_stream_set_write(output, invoke_vector_write);
+        output = svn_subst_stream_translated(output, eol, false, raw_keywords, true, pool);
+
+        auto length = static_cast<apr_size_t>(item.content.size());
+        check_result(svn_stream_write(output, item.content.data(), &length));
+        check_result(svn_stream_close(output));
+
+        item.content = std::move(translated);
+    }
+
+    // like svn_client_cat3, only report regular properties
+    apr_hash_index_t* index;
+    const char*       name;
+    svn_string_t*     value;
+    for (index = apr_hash_first(pool, raw_props); index; index = apr_hash_next(index)) {
+        apr_hash_this(index, reinterpret_cast<const void**>(&name), nullptr, reinterpret_cast<void**>(&value));
+
+        if (svn_property_kind2(name) == svn_prop_regular_kind) {
+            item.properties.emplace(name, std::string(value->data, value->len));
+        }
+    }
+}
+
 string_map client::cat(const std::string&  path,
                        const cat_callback& callback,
                        const revision&     peg_revision,
@@ -435,10 +1180,26 @@ string_map client::cat(const std::string&  path,
 
     apr_hash_t* raw_properties;
 
-    auto raw_path         = convert_from_path(path, pool);
+    auto raw_path         = convert_from_path_or_url(path, pool);
     auto raw_peg_revision = convert_from_revision(peg_revision);
     auto raw_revision     = convert_from_revision(revision);
 
+    // a fixed revision of a URL can be served from the fetch cache
+    auto fixed_revision = get_fixed_revision(raw_peg_revision, raw_revision);
+    auto cache          = std::atomic_load(&_fetch_cache);
+    if (cache && svn_path_is_url(raw_path) && fixed_revision != nullptr) {
+        ra_session_cache sessions(_context, pool);
+
+        auto& session = sessions.open_root(raw_path, pool);
+        auto  revnum  = session.resolve_revision(*fixed_revision, pool);
+
+        cat_item item{path, string_map(), std::vector<char>(), {}};
+        fetch_file(session, raw_path, revnum, expand_keywords, cache.get(), item, pool);
+
+        callback(item.content.data(), item.content.size());
+        return item.properties;
+    }
+
     callback_data<cat_callback> data(callback);
 
     auto stream = svn_stream_create(&data, pool);
@@ -486,6 +1247,198 @@ cat_result client::cat(const std::string& path,
     return cat_result{content, properties};
 }
 
+void client::cat_many(const std::vector<std::string>& targets,
+                      const cat_many_callback&        callback,
+                      const revision&                 peg_revision,
+                      const revision&                 revision,
+                      bool                            expand_keywords) const {
+    child_pool pool(_pool);
+
+    auto raw_peg_revision = convert_from_revision(peg_revision);
+    auto raw_revision     = convert_from_revision(revision);
+    auto fixed_revision   = get_fixed_revision(raw_peg_revision, raw_revision);
+    auto cache            = std::atomic_load(&_fetch_cache);
+
+    if (targets.size() == 0) {
+        throw svn_type_error("");
+    }
+
+    ra_session_cache sessions(_context, pool);
+
+    for (auto& target : targets) {
+        child_pool iteration_pool(pool);
+
+        cat_item item{target, string_map(), std::vector<char>(), {}};
+
+        try {
+            auto raw_target = convert_from_path_or_url(target, iteration_pool);
+
+            if (svn_path_is_url(raw_target) && fixed_revision != nullptr) {
+                // one session per repository, parented at its root
+                auto& session = sessions.open_root(raw_target, iteration_pool);
+                auto  revnum  = session.resolve_revision(*fixed_revision, iteration_pool);
+
+                fetch_file(session, raw_target, revnum, expand_keywords, cache.get(), item, iteration_pool);
+            } else {
+                auto stream = svn_stream_create(&item.content, iteration_pool);
+                svn_stream_set_write(stream, invoke_vector_write);
+
+                apr_hash_t* raw_props;
+                check_result(svn_client_cat3(&raw_props,
+                                             stream,
+                                             raw_target,
+                                             &raw_peg_revision,
+                                             &raw_revision,
+                                             expand_keywords,
+                                             _context,
+                                             iteration_pool,
+                                             iteration_pool));
+
+                item.properties = convert_to_string_map(raw_props, iteration_pool);
+            }
+        } catch (const svn_error& error) {
+            if (error.code == SVN_ERR_CANCELLED) {
+                throw;
+            }
+
+            item.properties.clear();
+            item.content.clear();
+            item.error.emplace(error);
+        }
+
+        callback(item);
+    }
+}
+
+// The working copy format whose pristine store keeps plain texts as
+// `pristine/<2 chars>/<sha1>.svn-base`, from Subversion 1.8 on.
+static const int pristine_store_format = 31;
+
+// Windows can't delete a file while a view of it is mapped, a Buffer waiting
+// for the garbage collector would keep `cleanup` from removing its pristine.
+#ifdef _WIN32
+static const bool can_map_pristines = false;
+#else
+static const bool can_map_pristines = true;
+#endif
+
+// Maps `path` read-only, the mapping lives until the last copy of the result
+// is released. The file itself is closed right away. Null when the file can't
+// be mapped, including empty files.
+static std::shared_ptr<const char> map_file(const char* path, size_t* size) {
+    apr_pool_t* pool;
+    check_result(apr_pool_create_ex(&pool, nullptr, nullptr, nullptr));
+
+    apr_file_t* file;
+    apr_finfo_t finfo;
+    apr_mmap_t* mmap;
+
+    auto status = apr_file_open(&file, path, APR_READ | APR_BINARY, APR_OS_DEFAULT, pool);
+    if (status == APR_SUCCESS) {
+        status = apr_file_info_get(&finfo, APR_FINFO_SIZE, file);
+    }
+    if (status == APR_SUCCESS && finfo.size > 0) {
+        status = apr_mmap_create(&mmap, file, 0, static_cast<apr_size_t>(finfo.size), APR_MMAP_READ, pool);
+    }
+
+    if (status == APR_SUCCESS) {
+        // the mapping doesn't need it
+        status = apr_file_close(file);
+    }
+
+    if (status != APR_SUCCESS || finfo.size == 0) {
+        apr_pool_destroy(pool);
+        return {};
+    }
+
+    *size = static_cast<size_t>(finfo.size);
+    return std::shared_ptr<const char>(static_cast<const char*>(mmap->mm), [pool, mmap](const char*) {
+        apr_mmap_delete(mmap);
+        apr_pool_destroy(pool);
+    });
+}
+
+void client::pristine(const std::vector<std::string>& paths, const pristine_callback& callback) const {
+    child_pool pool(_pool);
+
+    if (paths.size() == 0) {
+        throw svn_type_error("");
+    }
+
+    for (auto& path : paths) {
+        child_pool iteration_pool(pool);
+
+        pristine_item item{path, nullptr, 0, {}};
+
+        try {
+            auto raw_path = convert_from_path(path, iteration_pool);
+
+            svn_opt_revision_t  local{svn_opt_revision_unspecified};
+            svn_client_info2_t* info = nullptr;
+            check_result(svn_client_info4(raw_path,
+                                          &local,
+                                          &local,
+                                          svn_depth_empty,
+                                          false,
+                                          false,
+                                          false,
+                                          nullptr,
+                                          invoke_location_info,
+                                          &info,
+                                          _context,
+                                          iteration_pool));
+
+            auto wc_info = info != nullptr ? info->wc_info : nullptr;
+
+            int format = 0;
+            if (can_map_pristines && wc_info != nullptr && wc_info->checksum != nullptr && wc_info->checksum->kind == svn_checksum_sha1) {
+                check_result(svn_wc_check_wc2(&format, _context->wc_ctx, wc_info->wcroot_abspath, iteration_pool));
+            }
+
+            if (format == pristine_store_format) {
+                auto checksum = svn_checksum_to_cstring_display(wc_info->checksum, iteration_pool);
+                auto file     = svn_dirent_join_many(iteration_pool,
+                                                     wc_info->wcroot_abspath,
+                                                     svn_wc_get_adm_dir(iteration_pool),
+                                                     "pristine",
+                                                     apr_pstrndup(iteration_pool, checksum, 2),
+                                                     apr_pstrcat(iteration_pool, checksum, ".svn-base", SVN_VA_NULL),
+                                                     SVN_VA_NULL);
+
+                item.content = map_file(file, &item.content_size);
+            }
+
+            // other layouts, compressed or fetched on demand pristines and
+            // empty files are copied from their stream
+            if (item.content == nullptr) {
+                svn_stream_t* stream;
+                check_result(svn_wc_get_pristine_contents2(&stream, _context->wc_ctx, raw_path, iteration_pool, iteration_pool));
+
+                if (stream != nullptr) {
+                    svn_stringbuf_t* buffer;
+                    check_result(svn_stringbuf_from_stream(&buffer, stream, 0, iteration_pool));
+
+                    auto content = new char[buffer->len];
+                    std::memcpy(content, buffer->data, buffer->len);
+
+                    item.content      = std::shared_ptr<const char>(content, std::default_delete<const char[]>());
+                    item.content_size = buffer->len;
+                }
+            }
+        } catch (const svn_error& error) {
+            if (error.code == SVN_ERR_CANCELLED) {
+                throw;
+            }
+
+            item.content.reset();
+            item.content_size = 0;
+            item.error.emplace(error);
+        }
+
+        callback(item);
+    }
+}
+
 int32_t client::checkout(const std::string& url,
                          const std::string& path,
                          const revision&    peg_revision,
@@ -589,6 +1542,41 @@ static svn_error_t* invoke_info(void*                     raw_baton,
     return callback->invoke(path, convert_to_info(raw_info));
 }
 
+void client::copy(const std::vector<copy_source>& sources,
+                  const std::string&              destination,
+                  const std::string&              message,
+                  const commit_callback&          callback,
+                  bool                            copy_as_child,
+                  bool                            make_parents,
+                  bool                            ignore_externals,
+                  bool                            pin_externals,
+                  const string_map&               revprop_table) const {
+    auto message_ref         = std::cref(message);
+    _context->log_msg_baton3 = &message_ref;
+
+    child_pool pool(_pool);
+
+    auto raw_sources     = convert_from_copy_sources(sources, pool);
+    auto raw_destination = convert_from_path_or_url(destination, pool);
+    auto raw_props       = convert_from_map(revprop_table, pool);
+
+    // all sources are copied in one commit, over one RA session
+    callback_data<commit_callback> data(callback);
+    data.check_result(svn_client_copy7(raw_sources,
+                                       raw_destination,
+                                       copy_as_child,
+                                       make_parents,
+                                       ignore_externals,
+                                       false,
+                                       pin_externals,
+                                       nullptr,
+                                       raw_props,
+                                       invoke_commit,
+                                       &data,
+                                       _context,
+                                       pool));
+}
+
 void client::info(const std::string&                                   path,
                   const info_callback&                                 callback,
                   const revision&                                      peg_revision,
@@ -621,23 +1609,358 @@ void client::info(const std::string&                                   path,
 }
 
 static svn_error_t* invoke_log(void* raw_baton, svn_log_entry_t* raw_entry, apr_pool_t* pool) {
-    svn::log_entry entry{
-        static_cast<int32_t>(raw_entry->revision),
-        {},
-        nullptr,
-        nullptr,
-        nullptr,
-        static_cast<bool>(raw_entry->has_children),
-        std::map<std::string, svn::log_changed_path>(),
-        static_cast<bool>(raw_entry->non_inheritable),
-        static_cast<bool>(raw_entry->subtractive_merge)};
-    svn_compat_log_revprops_out(&entry.author, &entry.date, &entry.message, raw_entry->revprops);
+    auto entry = convert_to_log_entry(raw_entry, pool);
 
     auto callback = get_callback_data<client::log_callback>(raw_baton);
     return callback->invoke(entry);
 }
 
-void client::log(const std::vector<std::string>&                              paths,
+struct lock_baton {
+    callback_data<client::lock_callback>& data;
+    std::set<std::string>                 reported;
+};
+
+static void invoke_lock_notify(void* raw_baton, const svn_wc_notify_t* notify, apr_pool_t* pool) {
+    bool succeeded;
+    switch (notify->action) {
+        case svn_wc_notify_locked:
+        case svn_wc_notify_unlocked:
+            succeeded = true;
+            break;
+        case svn_wc_notify_failed_lock:
+        case svn_wc_notify_failed_unlock:
+            succeeded = false;
+            break;
+        default:
+            return;
+    }
+
+    auto baton = static_cast<lock_baton*>(raw_baton);
+    auto path  = notify->url != nullptr ? notify->url : notify->path;
+    baton->reported.emplace(path);
+
+    lock_result result{path, succeeded, {}, {}, {}, 0, 0, {}};
+
+    if (succeeded && notify->lock != nullptr) {
+        result.token           = convert_to_optional_string(notify->lock->token);
+        result.owner           = convert_to_optional_string(notify->lock->owner);
+        result.comment         = convert_to_optional_string(notify->lock->comment);
+        result.creation_date   = notify->lock->creation_date;
+        result.expiration_date = notify->lock->expiration_date;
+    }
+
+    if (notify->err != nullptr) {
+        result.error.emplace(copy_error(*notify->err));
+    }
+
+    // exceptions are kept by `data` and rethrown after svn returns
+    svn_error_clear(baton->data.invoke(result));
+}
+
+// svn_client_lock and svn_client_unlock take either paths of one working
+// copy or URLs of one repository, and send all of them in one request.
+static std::vector<std::pair<std::string, apr_array_header_t*>> group_lock_targets(const std::vector<std::string>& targets,
+                                                                                  ra_session_cache&               sessions,
+                                                                                  svn_client_ctx_t*               context,
+                                                                                  apr_pool_t*                     pool) {
+    if (targets.size() == 0) {
+        throw svn_type_error("");
+    }
+
+    std::vector<std::pair<std::string, apr_array_header_t*>> groups;
+    for (auto& target : targets) {
+        auto raw_target = convert_from_path_or_url(target, pool);
+
+        const char* root;
+        if (svn_path_is_url(raw_target)) {
+            root = sessions.open(raw_target, pool).root;
+        } else {
+            check_result(svn_client_get_wc_root(&root, raw_target, context, pool, pool));
+        }
+
+        auto group = std::find_if(groups.begin(), groups.end(), [root](const auto& item) -> bool {
+            return item.first == root;
+        });
+        if (group == groups.end()) {
+            group = groups.emplace(groups.end(), root, apr_array_make(pool, 1, sizeof(const char*)));
+        }
+
+        APR_ARRAY_PUSH(group->second, const char*) = raw_target;
+    }
+
+    return groups;
+}
+
+// A failure of a whole request (e.g. authentication) is reported for every
+// target svn didn't report on, so one repository doesn't hide the results
+// of the others.
+static void check_lock_result(lock_baton& baton, const apr_array_header_t* targets, svn_error_t* result) {
+    try {
+        baton.data.check_result(result);
+    } catch (const svn_error& error) {
+        if (error.code == SVN_ERR_CANCELLED) {
+            throw;
+        }
+
+        for (auto i = 0; i < targets->nelts; i++) {
+            auto target = APR_ARRAY_IDX(targets, i, const char*);
+            if (baton.reported.count(target) != 0) {
+                continue;
+            }
+
+            lock_result item{target, false, {}, {}, {}, 0, 0, error};
+            baton.data.check_result(baton.data.invoke(item));
+        }
+    }
+}
+
+void client::lock(const std::vector<std::string>& targets,
+                  const std::string&              comment,
+                  const lock_callback&            callback,
+                  bool                            steal_lock) const {
+    child_pool pool(_pool);
+
+    auto raw_comment = comment.empty() ? nullptr : convert_from_string(comment);
+
+    ra_session_cache sessions(_context, pool);
+    auto             groups = group_lock_targets(targets, sessions, _context, pool);
+
+    callback_data<lock_callback> data(callback);
+    lock_baton                   baton{data, {}};
+    notify_scope                 scope(_context, invoke_lock_notify, &baton);
+
+    for (auto& group : groups) {
+        check_lock_result(baton, group.second, svn_client_lock(group.second, raw_comment, steal_lock, _context, pool));
+    }
+}
+
+struct history_baton {
+    callback_data<client::history_callback>& data;
+    const std::vector<location_segment>&     segments;
+};
+
+static svn_error_t* invoke_history(void* raw_baton, svn_log_entry_t* raw_entry, apr_pool_t* pool) {
+    auto baton = static_cast<history_baton*>(raw_baton);
+
+    auto revision = static_cast<int32_t>(raw_entry->revision);
+
+    // a commit belongs to the segment that covers its revision, and the log
+    // never reports revisions outside of the node's history
+    std::string path;
+    for (auto& segment : baton->segments) {
+        if (segment.range_start <= revision && revision <= segment.range_end && segment.path) {
+            path = *segment.path;
+            break;
+        }
+    }
+
+    history_item item{path, convert_to_log_entry(raw_entry, pool)};
+    return baton->data.invoke(item);
+}
+
+void client::history(const std::string&                                   path_or_url,
+                     const history_callback&                              callback,
+                     const revision&                                      peg_revision,
+                     const std::optional<int32_t>&                        limit,
+                     bool                                                 discover_changed_paths,
+                     const std::optional<const std::vector<std::string>>& revprops) const {
+    child_pool pool(_pool);
+
+    auto raw_path_or_url  = convert_from_path_or_url(path_or_url, pool);
+    auto raw_peg_revision = convert_from_revision(peg_revision);
+    auto raw_revprops     = convert_from_vector(revprops, pool);
+
+    ra_session_cache sessions(_context, pool);
+
+    const char*  url;
+    svn_revnum_t peg;
+    auto&        session  = open_location(sessions, raw_path_or_url, raw_peg_revision, &url, &peg, _context, pool);
+    auto         segments = _mergeinfo_cache->get_segments(session, url, peg, pool);
+
+    // one log over the whole history, following copies on the server,
+    // instead of one request per segment
+    auto paths                         = apr_array_make(pool, 1, sizeof(const char*));
+    APR_ARRAY_PUSH(paths, const char*) = "";
+
+    callback_data<history_callback> data(callback);
+
+    history_baton baton{data, segments};
+    data.check_result(svn_ra_get_log2(session.session,
+                                      paths,
+                                      peg,
+                                      0,
+                                      limit.value_or(0),
+                                      discover_changed_paths,
+                                      false,
+                                      false,
+                                      raw_revprops,
+                                      invoke_history,
+                                      &baton,
+                                      pool));
+}
+
+std::vector<location_segment> client::location_segments(const std::string& path_or_url,
+                                                        const revision&    peg_revision,
+                                                        const revision&    start_revision,
+                                                        const revision&    end_revision) const {
+    child_pool pool(_pool);
+
+    auto raw_path_or_url    = convert_from_path_or_url(path_or_url, pool);
+    auto raw_peg_revision   = convert_from_revision(peg_revision);
+    auto raw_start_revision = convert_from_revision(start_revision);
+    auto raw_end_revision   = convert_from_revision(end_revision);
+
+    ra_session_cache sessions(_context, pool);
+
+    const char*  url;
+    svn_revnum_t peg;
+    auto&        session = open_location(sessions, raw_path_or_url, raw_peg_revision, &url, &peg, _context, pool);
+
+    auto start = raw_start_revision.kind == svn_opt_revision_unspecified
+                     ? peg
+                     : session.resolve_revision(raw_start_revision, pool);
+    auto end   = raw_end_revision.kind == svn_opt_revision_unspecified
+                     ? 0
+                     : session.resolve_revision(raw_end_revision, pool);
+
+    std::vector<location_segment> result;
+    check_result(svn_ra_get_location_segments(session.session,
+                                              "",
+                                              peg,
+                                              start,
+                                              end,
+                                              invoke_location_segment,
+                                              &result,
+                                              pool));
+    return result;
+}
+
+static bool has_revprop(const apr_array_header_t* revprops, const char* name) {
+    if (revprops == nullptr) {
+        return true;
+    }
+
+    for (auto i = 0; i < revprops->nelts; i++) {
+        if (strcmp(APR_ARRAY_IDX(revprops, i, const char*), name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Answers `log` from the log cache when it covers the request: one target,
+// one range and only cached revisions. Returns false to ask the server
+// instead.
+static bool log_from_cache(log_cache&                  cache,
+                           const char*                 target,
+                           const svn_opt_revision_t&   peg_revision,
+                           const apr_array_header_t*   ranges,
+                           int                         limit,
+                           bool                        discover_changed_paths,
+                           bool                        strict_node_history,
+                           const apr_array_header_t*   revprops,
+                           const client::log_callback& callback,
+                           svn_client_ctx_t*           context,
+                           apr_pool_t*                 pool) {
+    if (ranges->nelts != 1) {
+        return false;
+    }
+
+    const char* url = target;
+    if (!svn_path_is_url(target)) {
+        check_result(svn_client_url_from_path2(&url, target, context, pool, pool));
+    }
+
+    auto cached = cache.find(url);
+    if (!cached) {
+        return false;
+    }
+
+    auto& root     = cached->first;
+    auto  youngest = cached->second;
+
+    // HEAD costs a round trip, at most one
+    std::optional<svn_revnum_t> head;
+
+    auto resolve = [&](const svn_opt_revision_t& revision) -> svn_revnum_t {
+        switch (revision.kind) {
+            case svn_opt_revision_number:
+                return revision.value.number;
+            case svn_opt_revision_unspecified:
+            case svn_opt_revision_base:
+            case svn_opt_revision_working:
+            case svn_opt_revision_committed:
+            case svn_opt_revision_previous:
+                if (!svn_path_is_url(target)) {
+                    const char*  ignored;
+                    svn_revnum_t result;
+                    get_wc_location(target, revision.kind, &ignored, &result, context, pool);
+                    return result;
+                }
+                if (revision.kind != svn_opt_revision_unspecified) {
+                    return SVN_INVALID_REVNUM;
+                }
+                [[fallthrough]];
+            case svn_opt_revision_head:
+                if (!head) {
+                    try {
+                        ra_session_cache sessions(context, pool);
+                        head = sessions.open(root.c_str(), pool).resolve_revision(revision, pool);
+                    } catch (const svn_error& error) {
+                        if (error.code == SVN_ERR_CANCELLED) {
+                            throw;
+                        }
+                        // offline, the cache is as good as it gets
+                        head = youngest;
+                    }
+                }
+                return *head;
+            default:
+                return SVN_INVALID_REVNUM;
+        }
+    };
+
+    auto range = APR_ARRAY_IDX(ranges, 0, svn_opt_revision_range_t*);
+    auto peg   = resolve(peg_revision);
+    auto start = resolve(range->start);
+    auto end   = resolve(range->end);
+
+    // let the server report invalid ranges
+    if (!SVN_IS_VALID_REVNUM(peg) || !SVN_IS_VALID_REVNUM(start) || !SVN_IS_VALID_REVNUM(end) ||
+        peg > youngest || std::max(start, end) > peg) {
+        return false;
+    }
+
+    auto path = std::string("/") + svn_uri_skip_ancestor(root.c_str(), url, pool);
+
+    auto author  = has_revprop(revprops, SVN_PROP_REVISION_AUTHOR);
+    auto date    = has_revprop(revprops, SVN_PROP_REVISION_DATE);
+    auto message = has_revprop(revprops, SVN_PROP_REVISION_LOG);
+
+    cache.log(root,
+              path,
+              static_cast<int32_t>(peg),
+              static_cast<int32_t>(start),
+              static_cast<int32_t>(end),
+              limit,
+              discover_changed_paths,
+              strict_node_history,
+              [&](log_entry& entry) -> void {
+                  if (!author) {
+                      entry.author.reset();
+                  }
+                  if (!date) {
+                      entry.date.reset();
+                  }
+                  if (!message) {
+                      entry.message.reset();
+                  }
+                  callback(entry);
+              });
+    return true;
+}
+
+void client::log(const std::vector<std::string>&                              paths,
                  const log_callback&                                          callback,
                  const std::optional<const std::vector<svn::revision_range>>& revision_ranges,
                  const std::optional<int32_t>&                                limit,
@@ -654,6 +1977,44 @@ void client::log(const std::vector<std::string>&                              pa
     auto raw_limit          = limit.value_or(0);
     auto raw_revprops       = convert_from_vector(revprops, pool);
 
+    // like `svn log`, default to the whole history up to the peg revision,
+    // HEAD for URLs, BASE only exists in working copies
+    if (raw_revision_rangs == nullptr) {
+        auto range = new (pool) svn_opt_revision_range_t;
+
+        range->start = raw_peg_revision;
+        if (range->start.kind == svn_opt_revision_unspecified) {
+            auto is_url       = raw_paths->nelts > 0 && svn_path_is_url(APR_ARRAY_IDX(raw_paths, 0, const char*));
+            range->start.kind = is_url ? svn_opt_revision_head : svn_opt_revision_base;
+        }
+
+        range->end.kind         = svn_opt_revision_number;
+        range->end.value.number = 0;
+
+        raw_revision_rangs                                            = apr_array_make(pool, 1, sizeof(svn_opt_revision_range_t*));
+        APR_ARRAY_PUSH(raw_revision_rangs, svn_opt_revision_range_t*) = range;
+    }
+
+    auto cache = std::atomic_load(&_log_cache);
+    if (cache && paths.size() == 1 && !include_merged_revisions &&
+        log_from_cache(*cache,
+                       APR_ARRAY_IDX(raw_paths, 0, const char*),
+                       raw_peg_revision,
+                       raw_revision_rangs,
+                       raw_limit,
+                       discover_changed_paths,
+                       strict_node_history,
+                       raw_revprops,
+                       callback,
+                       _context,
+                       pool)) {
+        return;
+    }
+
+    if (cache) {
+        cache->add_miss();
+    }
+
     callback_data<log_callback> data(callback);
     data.check_result(svn_client_log5(raw_paths,
                                       &raw_peg_revision,
@@ -669,6 +2030,430 @@ void client::log(const std::vector<std::string>&                              pa
                                       pool));
 }
 
+int32_t client::sync_log_cache(const std::string& url) const {
+    auto cache = std::atomic_load(&_log_cache);
+    if (!cache) {
+        throw svn_error(SVN_ERR_INCORRECT_PARAMS, "The log cache is not enabled");
+    }
+
+    child_pool pool(_pool);
+
+    auto raw_url = convert_from_url(url, pool);
+
+    ra_session_cache sessions(_context, pool);
+    auto&            session = sessions.open_root(raw_url, pool);
+
+    svn_opt_revision_t head{svn_opt_revision_head};
+    auto               youngest = session.resolve_revision(head, pool);
+
+    return cache->sync(session.session, session.root, session.uuid, static_cast<int32_t>(youngest), pool);
+}
+
+std::vector<log_entry> client::search_log_cache(const std::string& url, const log_query& query) const {
+    auto cache = std::atomic_load(&_log_cache);
+    if (!cache) {
+        throw svn_error(SVN_ERR_INCORRECT_PARAMS, "The log cache is not enabled");
+    }
+
+    child_pool pool(_pool);
+
+    auto raw_url = convert_from_url(url, pool);
+
+    auto cached = cache->find(raw_url);
+    if (!cached) {
+        check_result(svn_error_createf(SVN_ERR_ILLEGAL_TARGET, nullptr, "'%s' is not in the log cache", raw_url));
+    }
+
+    if (query.path) {
+        return cache->search(cached->first, query);
+    }
+
+    auto scoped = query;
+    scoped.path = std::string("/") + svn_uri_skip_ancestor(cached->first.c_str(), raw_url, pool);
+    return cache->search(cached->first, scoped);
+}
+
+struct mergeinfo_log_baton {
+    callback_data<client::log_callback>& data;
+    const std::vector<merge_range>&      ranges;
+};
+
+static svn_error_t* invoke_mergeinfo_log(void* raw_baton, svn_log_entry_t* raw_entry, apr_pool_t* pool) {
+    auto baton = static_cast<mergeinfo_log_baton*>(raw_baton);
+
+    // the log spans from the oldest to the youngest range, skip the gaps
+    auto range = rangelist::find(baton->ranges, static_cast<int32_t>(raw_entry->revision));
+    if (range == nullptr) {
+        return nullptr;
+    }
+
+    auto entry            = convert_to_log_entry(raw_entry, pool);
+    entry.non_inheritable = !range->inheritable;
+
+    return baton->data.invoke(entry);
+}
+
+void client::mergeinfo_log(const std::string&                                   target,
+                           const std::string&                                   source,
+                           const log_callback&                                  callback,
+                           bool                                                 finding_merged,
+                           const revision&                                      target_peg_revision,
+                           const revision&                                      source_peg_revision,
+                           const revision&                                      source_start_revision,
+                           const revision&                                      source_end_revision,
+                           bool                                                 discover_changed_paths,
+                           svn::depth                                           depth,
+                           const std::optional<const std::vector<std::string>>& revprops) const {
+    child_pool pool(_pool);
+
+    auto raw_target                = convert_from_path_or_url(target, pool);
+    auto raw_source                = convert_from_path_or_url(source, pool);
+    auto raw_target_peg_revision   = convert_from_revision(target_peg_revision);
+    auto raw_source_peg_revision   = convert_from_revision(source_peg_revision);
+    auto raw_source_start_revision = convert_from_revision(source_start_revision);
+    auto raw_source_end_revision   = convert_from_revision(source_end_revision);
+    auto raw_revprops              = convert_from_vector(revprops, pool);
+
+    callback_data<log_callback> data(callback);
+
+    // subtree mergeinfo and working copy sources need the full client algorithm
+    if (depth != svn::depth::empty || !svn_path_is_url(raw_source)) {
+        data.check_result(svn_client_mergeinfo_log2(finding_merged,
+                                                    raw_target,
+                                                    &raw_target_peg_revision,
+                                                    raw_source,
+                                                    &raw_source_peg_revision,
+                                                    &raw_source_start_revision,
+                                                    &raw_source_end_revision,
+                                                    invoke_log,
+                                                    &data,
+                                                    discover_changed_paths,
+                                                    static_cast<svn_depth_t>(depth),
+                                                    raw_revprops,
+                                                    _context,
+                                                    pool));
+        return;
+    }
+
+    ra_session_cache sessions(_context, pool);
+
+    auto target_mergeinfo = _mergeinfo_cache->get_mergeinfo(sessions, raw_target, raw_target_peg_revision, _context, pool);
+
+    auto& session    = sessions.open(raw_source, pool);
+    auto  source_peg = session.resolve_revision(raw_source_peg_revision, pool);
+    auto  segments   = _mergeinfo_cache->get_segments(session, raw_source, source_peg, pool);
+
+    auto source_start = raw_source_start_revision.kind == svn_opt_revision_unspecified
+                            ? source_peg
+                            : session.resolve_revision(raw_source_start_revision, pool);
+    auto source_end   = raw_source_end_revision.kind == svn_opt_revision_unspecified
+                            ? 0
+                            : session.resolve_revision(raw_source_end_revision, pool);
+
+    auto youngest = static_cast<int32_t>(std::max(source_start, source_end));
+    auto oldest   = static_cast<int32_t>(std::min(source_start, source_end));
+
+    // `(oldest - 1, youngest]` in mergeinfo notation
+    std::vector<merge_range> bounds{merge_range{std::max(oldest - 1, 0), youngest, true}};
+
+    std::vector<merge_range>                                      ranges;
+    std::vector<std::pair<const char*, std::vector<merge_range>>> locations;
+    for (auto& segment : segments) {
+        // gaps in history can't be merged
+        if (!segment.path) {
+            continue;
+        }
+
+        std::vector<merge_range> history{merge_range{std::max(segment.range_start - 1, 0), segment.range_end, true}};
+        history = rangelist::intersect(history, bounds);
+        if (history.empty()) {
+            continue;
+        }
+
+        auto url = svn_path_url_add_component2(session.root, segment.path->c_str(), pool);
+        locations.emplace_back(url, history);
+
+        std::vector<merge_range> merged;
+
+        auto entry = target_mergeinfo.find(url);
+        if (entry != target_mergeinfo.end()) {
+            merged = rangelist::intersect(history, entry->second);
+        }
+
+        auto result = finding_merged ? merged : rangelist::remove(merged, history);
+        ranges.insert(ranges.end(), result.begin(), result.end());
+    }
+
+    ranges = rangelist::normalize(std::move(ranges));
+    if (ranges.empty()) {
+        return;
+    }
+
+    // one log request for the whole span, on the location of the source at
+    // its youngest revision, instead of one request per merged range
+    auto youngest_location = std::find_if(locations.begin(), locations.end(), [&ranges](const auto& location) -> bool {
+        return rangelist::find(location.second, ranges.back().end) != nullptr;
+    });
+    if (youngest_location == locations.end()) {
+        check_result(svn_error_createf(SVN_ERR_CLIENT_UNRELATED_RESOURCES,
+                                       nullptr,
+                                       "No location of '%s' covers revision %d",
+                                       raw_source,
+                                       ranges.back().end));
+    }
+
+    auto& log_session = sessions.open(youngest_location->first, pool);
+
+    auto paths                         = apr_array_make(pool, 1, sizeof(const char*));
+    APR_ARRAY_PUSH(paths, const char*) = "";
+
+    mergeinfo_log_baton baton{data, ranges};
+    data.check_result(svn_ra_get_log2(log_session.session,
+                                      paths,
+                                      ranges.front().start + 1,
+                                      ranges.back().end,
+                                      0,
+                                      discover_changed_paths,
+                                      false,
+                                      false,
+                                      raw_revprops,
+                                      invoke_mergeinfo_log,
+                                      &baton,
+                                      pool));
+}
+
+void client::move(const std::vector<std::string>& sources,
+                  const std::string&              destination,
+                  const std::string&              message,
+                  const commit_callback&          callback,
+                  bool                            move_as_child,
+                  bool                            make_parents,
+                  bool                            allow_mixed_revisions,
+                  const string_map&               revprop_table) const {
+    auto message_ref         = std::cref(message);
+    _context->log_msg_baton3 = &message_ref;
+
+    child_pool pool(_pool);
+
+    auto raw_sources     = convert_from_paths_or_urls(sources, pool);
+    auto raw_destination = convert_from_path_or_url(destination, pool);
+    auto raw_props       = convert_from_map(revprop_table, pool);
+
+    callback_data<commit_callback> data(callback);
+    data.check_result(svn_client_move7(raw_sources,
+                                       raw_destination,
+                                       move_as_child,
+                                       make_parents,
+                                       allow_mixed_revisions,
+                                       false,
+                                       raw_props,
+                                       invoke_commit,
+                                       &data,
+                                       _context,
+                                       pool));
+}
+
+// Inherited properties can only be served from the cache when the
+// operation is evaluated at one single revision.
+static bool use_inherited_properties_cache(const char*               target,
+                                           const svn_opt_revision_t& peg_revision,
+                                           const svn_opt_revision_t& revision) {
+    // working copies have their own inherited properties cache in wc.db
+    return svn_path_is_url(target) && get_fixed_revision(peg_revision, revision) != nullptr;
+}
+
+void client::propget(const std::string&                                   name,
+                     const std::vector<std::string>&                      targets,
+                     const property_callback&                             callback,
+                     const revision&                                      peg_revision,
+                     const revision&                                      revision,
+                     svn::depth                                           depth,
+                     bool                                                 get_inherited_props,
+                     const std::optional<const std::vector<std::string>>& changelists) const {
+    child_pool pool(_pool);
+
+    auto raw_name         = convert_from_string(name);
+    auto raw_peg_revision = convert_from_revision(peg_revision);
+    auto raw_revision     = convert_from_revision(revision);
+    auto raw_changelists  = convert_from_vector(changelists, pool);
+
+    if (targets.size() == 0) {
+        throw svn_type_error("");
+    }
+
+    ra_session_cache                 sessions(_context, pool);
+    callback_data<property_callback> data(callback);
+
+    for (auto& target : targets) {
+        child_pool iteration_pool(pool);
+
+        auto raw_target = convert_from_path_or_url(target, iteration_pool);
+
+        auto target_peg_revision = raw_peg_revision;
+        auto target_revision     = raw_revision;
+
+        std::optional<std::vector<inherited_property>> inherited_props;
+
+        auto use_cache = get_inherited_props && use_inherited_properties_cache(raw_target, raw_peg_revision, raw_revision);
+        if (use_cache) {
+            auto& session = sessions.open(raw_target, iteration_pool);
+            auto  revnum  = session.resolve_revision(*get_fixed_revision(raw_peg_revision, raw_revision), iteration_pool);
+
+            // pin HEAD so properties and inherited properties agree
+            target_peg_revision.kind         = svn_opt_revision_number;
+            target_peg_revision.value.number = revnum;
+            target_revision                  = target_peg_revision;
+
+            inherited_props.emplace();
+            for (auto& item : _inherited_properties_cache->get(session, raw_target, revnum, iteration_pool)) {
+                auto value = item.properties.find(name);
+                if (value != item.properties.end()) {
+                    inherited_props->push_back(inherited_property{item.path_or_url, string_map{*value}});
+                }
+            }
+        }
+
+        apr_hash_t*         raw_props;
+        apr_array_header_t* raw_inherited_props = nullptr;
+        data.check_result(svn_client_propget5(&raw_props,
+                                              get_inherited_props && !use_cache ? &raw_inherited_props : nullptr,
+                                              raw_name,
+                                              raw_target,
+                                              &target_peg_revision,
+                                              &target_revision,
+                                              nullptr,
+                                              static_cast<svn_depth_t>(depth),
+                                              raw_changelists,
+                                              _context,
+                                              iteration_pool,
+                                              iteration_pool));
+
+        if (get_inherited_props && !use_cache) {
+            inherited_props = convert_to_inherited_properties(raw_inherited_props, iteration_pool);
+        }
+
+        // the target always comes first, so its inherited properties
+        // are reported even if it doesn't have the property itself
+        if (get_inherited_props) {
+            property_item item{raw_target, string_map(), std::move(inherited_props)};
+
+            auto value = static_cast<svn_string_t*>(apr_hash_get(raw_props, raw_target, APR_HASH_KEY_STRING));
+            if (value != nullptr) {
+                item.properties.emplace(name, std::string(value->data, value->len));
+            }
+
+            data.check_result(data.invoke(item));
+        }
+
+        apr_hash_index_t* index;
+        const char*       path;
+        svn_string_t*     value;
+        for (index = apr_hash_first(iteration_pool, raw_props); index; index = apr_hash_next(index)) {
+            apr_hash_this(index, reinterpret_cast<const void**>(&path), nullptr, reinterpret_cast<void**>(&value));
+
+            if (get_inherited_props && std::strcmp(path, raw_target) == 0) {
+                continue;
+            }
+
+            property_item item{path, string_map(), {}};
+            item.properties.emplace(name, std::string(value->data, value->len));
+
+            data.check_result(data.invoke(item));
+        }
+    }
+}
+
+struct proplist_baton {
+    callback_data<client::property_callback>&       data;
+    const char*                                     target;
+    std::optional<std::vector<inherited_property>>& inherited_props;
+    bool                                            target_reported;
+};
+
+static svn_error_t* invoke_proplist(void*               raw_baton,
+                                    const char*         path,
+                                    apr_hash_t*         prop_hash,
+                                    apr_array_header_t* inherited_props,
+                                    apr_pool_t*         scratch_pool) {
+    auto baton = static_cast<proplist_baton*>(raw_baton);
+
+    property_item item{path, convert_to_string_map(prop_hash, scratch_pool), {}};
+
+    if (std::strcmp(path, baton->target) == 0) {
+        baton->target_reported = true;
+
+        if (baton->inherited_props) {
+            item.inherited_properties = std::move(baton->inherited_props);
+        } else if (inherited_props != nullptr) {
+            item.inherited_properties = convert_to_inherited_properties(inherited_props, scratch_pool);
+        }
+    }
+
+    return baton->data.invoke(item);
+}
+
+void client::proplist(const std::vector<std::string>&                      targets,
+                      const property_callback&                             callback,
+                      const revision&                                      peg_revision,
+                      const revision&                                      revision,
+                      svn::depth                                           depth,
+                      bool                                                 get_inherited_props,
+                      const std::optional<const std::vector<std::string>>& changelists) const {
+    child_pool pool(_pool);
+
+    auto raw_peg_revision = convert_from_revision(peg_revision);
+    auto raw_revision     = convert_from_revision(revision);
+    auto raw_changelists  = convert_from_vector(changelists, pool);
+
+    if (targets.size() == 0) {
+        throw svn_type_error("");
+    }
+
+    ra_session_cache                 sessions(_context, pool);
+    callback_data<property_callback> data(callback);
+
+    for (auto& target : targets) {
+        child_pool iteration_pool(pool);
+
+        auto raw_target = convert_from_path_or_url(target, iteration_pool);
+
+        auto target_peg_revision = raw_peg_revision;
+        auto target_revision     = raw_revision;
+
+        std::optional<std::vector<inherited_property>> inherited_props;
+
+        auto use_cache = get_inherited_props && use_inherited_properties_cache(raw_target, raw_peg_revision, raw_revision);
+        if (use_cache) {
+            auto& session = sessions.open(raw_target, iteration_pool);
+            auto  revnum  = session.resolve_revision(*get_fixed_revision(raw_peg_revision, raw_revision), iteration_pool);
+
+            target_peg_revision.kind         = svn_opt_revision_number;
+            target_peg_revision.value.number = revnum;
+            target_revision                  = target_peg_revision;
+
+            inherited_props = _inherited_properties_cache->get(session, raw_target, revnum, iteration_pool);
+        }
+
+        proplist_baton baton{data, raw_target, inherited_props, false};
+        data.check_result(svn_client_proplist4(raw_target,
+                                               &target_peg_revision,
+                                               &target_revision,
+                                               static_cast<svn_depth_t>(depth),
+                                               raw_changelists,
+                                               get_inherited_props && !use_cache,
+                                               invoke_proplist,
+                                               &baton,
+                                               _context,
+                                               iteration_pool));
+
+        // nodes without explicit properties are not reported by svn
+        if (!baton.target_reported && inherited_props) {
+            property_item item{raw_target, string_map(), std::move(inherited_props)};
+            data.check_result(data.invoke(item));
+        }
+    }
+}
+
 void client::remove(const std::vector<std::string>& paths,
                     const remove_callback&          callback,
                     bool                            force,
@@ -725,12 +2510,115 @@ void client::revert(const std::vector<std::string>&                      paths,
                                     pool));
 }
 
+struct status_baton {
+    callback_data<client::status_callback>& data;
+    const status_filter&                    filter;
+
+    const char*              root;
+    std::vector<const char*> prefixes;
+    apr_array_header_t*      globs;
+};
+
+// Most entries of a large working copy are filtered out here, so they are
+// never converted nor handed to the callback.
+static bool match_status_filter(const status_baton& baton, const svn_client_status_t* status) {
+    auto& filter = baton.filter;
+
+    if (filter.only_conflicted && !status->conflicted) {
+        return false;
+    }
+
+    if (!filter.node_status_in.empty()) {
+        auto node_status = static_cast<status_kind>(status->node_status);
+        if (std::find(filter.node_status_in.begin(), filter.node_status_in.end(), node_status) == filter.node_status_in.end()) {
+            return false;
+        }
+    }
+
+    if (!baton.prefixes.empty()) {
+        auto prefix = std::find_if(baton.prefixes.begin(), baton.prefixes.end(), [status](const char* prefix) -> bool {
+            return svn_dirent_is_ancestor(prefix, status->local_abspath);
+        });
+        if (prefix == baton.prefixes.end()) {
+            return false;
+        }
+    }
+
+    if (baton.globs != nullptr) {
+        auto name = svn_dirent_basename(status->local_abspath, nullptr);
+        if (svn_cstring_match_glob_list(name, baton.globs)) {
+            return false;
+        }
+
+        auto relpath = svn_dirent_skip_ancestor(baton.root, status->local_abspath);
+        if (relpath != nullptr && svn_cstring_match_glob_list(relpath, baton.globs)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 static svn_error_t* invoke_status(void*                      raw_baton,
                                   const char*                path,
                                   const svn_client_status_t* raw_status,
                                   apr_pool_t*                raw_scratch_pool) {
-    auto callback = get_callback_data<client::status_callback>(raw_baton);
-    return callback->invoke(path, convert_to_status(raw_status));
+    auto baton = static_cast<status_baton*>(raw_baton);
+    if (!match_status_filter(*baton, raw_status)) {
+        return nullptr;
+    }
+
+    return baton->data.invoke(path, convert_to_status(raw_status));
+}
+
+void client::stat(const std::vector<std::string>& urls,
+                  const stat_callback&            callback,
+                  const revision&                 revision) const {
+    child_pool pool(_pool);
+
+    auto raw_revision = convert_from_revision(revision);
+
+    if (urls.size() == 0) {
+        throw svn_type_error("");
+    }
+
+    // one session per repository, parented at its root, so each URL
+    // costs a single stat request
+    ra_session_cache sessions(_context, pool);
+
+    for (auto& url : urls) {
+        child_pool iteration_pool(pool);
+
+        stat_item item{url, node_kind::none, -1, {}, 0, {}, {}};
+
+        try {
+            auto raw_url = convert_from_url(url, iteration_pool);
+
+            auto& session = sessions.open_root(raw_url, iteration_pool);
+            auto  revnum  = session.resolve_revision(raw_revision, iteration_pool);
+            auto  relpath = svn_uri_skip_ancestor(session.root, raw_url, iteration_pool);
+
+            svn_dirent_t* dirent;
+            check_result(svn_ra_stat(session.session, relpath, revnum, &dirent, iteration_pool));
+
+            // not found is a result, not an error
+            if (dirent != nullptr) {
+                item.kind        = static_cast<node_kind>(dirent->kind);
+                item.size        = dirent->kind == svn_node_file ? dirent->size : -1;
+                item.created_rev = convert_to_revision_number(dirent->created_rev);
+                item.time        = dirent->time;
+                item.last_author = convert_to_optional_string(dirent->last_author);
+            }
+        } catch (const svn_error& error) {
+            if (error.code == SVN_ERR_CANCELLED) {
+                throw;
+            }
+
+            item.error.emplace(error);
+        }
+
+        callback(item);
+    }
 }
 
 int32_t client::status(const std::string&                                   path,
@@ -743,7 +2631,8 @@ int32_t client::status(const std::string&                                   path
                        bool                                                 no_ignore,
                        bool                                                 ignore_externals,
                        bool                                                 depth_as_sticky,
-                       const std::optional<const std::vector<std::string>>& changelists) const {
+                       const std::optional<const std::vector<std::string>>& changelists,
+                       const status_filter&                                 filter) const {
     child_pool pool(_pool);
 
     auto raw_path        = convert_from_path(path, pool);
@@ -753,6 +2642,19 @@ int32_t client::status(const std::string&                                   path
     svn_revnum_t result_rev;
 
     callback_data<status_callback> data(callback);
+    status_baton                   baton{data, filter, raw_path, {}, nullptr};
+
+    for (auto& prefix : filter.path_prefixes) {
+        baton.prefixes.push_back(convert_from_path(prefix, pool));
+    }
+
+    if (!filter.exclude_globs.empty()) {
+        baton.globs = apr_array_make(pool, static_cast<int>(filter.exclude_globs.size()), sizeof(const char*));
+        for (auto& glob : filter.exclude_globs) {
+            APR_ARRAY_PUSH(baton.globs, const char*) = duplicate_string(pool, glob);
+        }
+    }
+
     data.check_result(svn_client_status6(&result_rev,
                                          _context,
                                          raw_path,
@@ -766,12 +2668,29 @@ int32_t client::status(const std::string&                                   path
                                          depth_as_sticky,
                                          raw_changelists,
                                          invoke_status,
-                                         &data,
+                                         &baton,
                                          pool));
 
     return static_cast<int32_t>(result_rev);
 }
 
+void client::unlock(const std::vector<std::string>& targets,
+                    const lock_callback&            callback,
+                    bool                            break_lock) const {
+    child_pool pool(_pool);
+
+    ra_session_cache sessions(_context, pool);
+    auto             groups = group_lock_targets(targets, sessions, _context, pool);
+
+    callback_data<lock_callback> data(callback);
+    lock_baton                   baton{data, {}};
+    notify_scope                 scope(_context, invoke_lock_notify, &baton);
+
+    for (auto& group : groups) {
+        check_lock_result(baton, group.second, svn_client_unlock(group.second, break_lock, _context, pool));
+    }
+}
+
 void client::update(const std::vector<std::string>& paths,
                     const notify_function&          notify,
                     const revision&                 revision,
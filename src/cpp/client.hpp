@@ -14,6 +14,10 @@ struct apr_pool_t;
 struct svn_client_ctx_t;
 
 namespace svn {
+class blame_cache;
+class fetch_cache;
+class log_cache;
+
 class client : public std::enable_shared_from_this<client> {
   public:
     using simple_auth_provider = std::shared_ptr<std::function<std::optional<simple_auth>(const std::string&,
@@ -22,9 +26,14 @@ class client : public std::enable_shared_from_this<client> {
 
     using get_changelists_callback = std::function<void(const char*, const char*)>;
     using cat_callback             = std::function<void(const char*, size_t)>;
+    using cat_many_callback        = std::function<void(svn::cat_item&)>;
+    using pristine_callback        = std::function<void(svn::pristine_item&)>;
     using commit_callback          = std::function<void(const commit_info&)>;
     using info_callback            = std::function<void(const char*, const svn::info&)>;
+    using lock_callback            = std::function<void(const svn::lock_result&)>;
+    using property_callback        = std::function<void(const svn::property_item&)>;
     using remove_callback          = std::function<void(const commit_info&)>;
+    using stat_callback            = std::function<void(const svn::stat_item&)>;
     using status_callback          = std::function<void(const char*, const svn::status&)>;
 
     using abort_function  = std::function<bool()>;
@@ -40,6 +49,7 @@ class client : public std::enable_shared_from_this<client> {
                                               bool                   local_change)>;
 
     using log_callback = std::function<void(svn::log_entry& entry)>;
+    using history_callback = std::function<void(svn::history_item& item)>;
 
     explicit client(const std::optional<const std::string>& config_path);
     client(client&&);
@@ -60,6 +70,36 @@ class client : public std::enable_shared_from_this<client> {
                                                             const std::optional<const std::string>& username,
                                                             bool                                    may_save);
 
+    // Bounds the in-memory cache of properties inherited by URL targets of
+    // `propget` and `proplist`, 4096 entries by default.
+    void          set_inherited_properties_cache_size(size_t max_entries);
+    cache_metrics get_inherited_properties_cache_metrics() const;
+
+    // Enables the local log cache in `directory`, or disables it. While
+    // enabled, `log` is answered from the cache whenever it covers the
+    // request, see `sync_log_cache`.
+    void set_log_cache(const std::optional<const std::string>& directory);
+
+    // All zeros while the log cache is disabled.
+    cache_metrics get_log_cache_metrics() const;
+
+    // Enables the blame cache in `directory`, or disables it. While enabled,
+    // `blame_compact` of a whole history up to a repository revision is
+    // stored, and extended from the stored one when asked for a younger
+    // revision.
+    void set_blame_cache(const std::optional<const std::string>& directory, int64_t max_size = 256 * 1024 * 1024);
+
+    // All zeros while the blame cache is disabled.
+    blame_cache_metrics get_blame_cache_metrics() const;
+
+    // Enables the fetch cache in `directory`, or disables it. While enabled,
+    // `cat` and `cat_many` of URLs at a fixed revision store file contents
+    // once per checksum and serve them again without downloading.
+    void set_fetch_cache(const std::optional<const std::string>& directory, int64_t max_size = 1024 * 1024 * 1024);
+
+    // All zeros while the fetch cache is disabled.
+    fetch_cache_metrics get_fetch_cache_metrics() const;
+
     void add_to_changelist(const std::vector<std::string>&                      paths,
                            const std::string&                                   changelist,
                            svn::depth                                           depth       = svn::depth::infinity,
@@ -91,6 +131,15 @@ class client : public std::enable_shared_from_this<client> {
                bool                  ignore_mime_type         = false,
                bool                  include_merged_revisions = false) const;
 
+    blame_result blame_compact(const std::string& path,
+                               const revision&    start_revision,
+                               const revision&    end_revision,
+                               const revision&    peg_revision             = revision_kind::working,
+                               diff_ignore_space  ignore_space             = diff_ignore_space::none,
+                               bool               ignore_eol_style         = true,
+                               bool               ignore_mime_type         = false,
+                               bool               include_merged_revisions = false) const;
+
     string_map cat(const std::string&  path,
                    const cat_callback& callback,
                    const revision&     peg_revision    = revision_kind::unspecified,
@@ -101,6 +150,16 @@ class client : public std::enable_shared_from_this<client> {
                    const revision&    op_revision     = revision_kind::unspecified,
                    bool               expand_keywords = true) const;
 
+    void cat_many(const std::vector<std::string>& targets,
+                  const cat_many_callback&        callback,
+                  const revision&                 peg_revision    = revision_kind::unspecified,
+                  const revision&                 op_revision     = revision_kind::unspecified,
+                  bool                            expand_keywords = true) const;
+
+    // Reads the pristine text of working copy files, as stored: without
+    // keyword and eol translation, and without contacting the repository.
+    void pristine(const std::vector<std::string>& paths, const pristine_callback& callback) const;
+
     // return                           parameter                                             Linux x64   Windows x64
     // rax           const svn::client* this,                                                 rdi         rcx
     int32_t checkout(const std::string& url,                                               // rsi         rdx
@@ -131,6 +190,16 @@ class client : public std::enable_shared_from_this<client> {
                 bool                                                 include_file_externals = false,
                 bool                                                 include_dir_externals  = false) const;
 
+    void copy(const std::vector<copy_source>& sources,
+              const std::string&              destination,
+              const std::string&              message,
+              const commit_callback&          callback,
+              bool                            copy_as_child    = true,
+              bool                            make_parents     = false,
+              bool                            ignore_externals = false,
+              bool                            pin_externals    = false,
+              const string_map&               revprop_table    = string_map()) const;
+
     void info(const std::string&                                   path,
               const info_callback&                                 callback,
               const revision&                                      peg_revision      = revision_kind::unspecified,
@@ -141,6 +210,18 @@ class client : public std::enable_shared_from_this<client> {
               bool                                                 include_externals = false,
               const std::optional<const std::vector<std::string>>& changelists       = {}) const;
 
+    void lock(const std::vector<std::string>& targets,
+              const std::string&              comment,
+              const lock_callback&            callback,
+              bool                            steal_lock = false) const;
+
+    void history(const std::string&                                   path_or_url,
+                 const history_callback&                              callback,
+                 const revision&                                      peg_revision           = revision_kind::unspecified,
+                 const std::optional<int32_t>&                        limit                  = {},
+                 bool                                                 discover_changed_paths = false,
+                 const std::optional<const std::vector<std::string>>& revprops               = {}) const;
+
     void log(const std::vector<std::string>&                              paths,
              const log_callback&                                          callback,
              const std::optional<const std::vector<svn::revision_range>>& revision_ranges          = {},
@@ -151,6 +232,58 @@ class client : public std::enable_shared_from_this<client> {
              bool                                                         include_merged_revisions = false,
              const std::optional<const std::vector<std::string>>&         revprops                 = {}) const;
 
+    // Brings the log cache of the repository of `url` up to HEAD. Returns
+    // the youngest cached revision.
+    int32_t sync_log_cache(const std::string& url) const;
+
+    // Queries the log cache of the repository of `url`, without contacting
+    // the server. `url` also limits the results to its path, unless the
+    // query has one.
+    std::vector<log_entry> search_log_cache(const std::string& url, const log_query& query) const;
+
+    std::vector<location_segment> location_segments(const std::string& path_or_url,
+                                                    const revision&    peg_revision   = revision_kind::unspecified,
+                                                    const revision&    start_revision = revision_kind::unspecified,
+                                                    const revision&    end_revision   = revision_kind::unspecified) const;
+
+    void mergeinfo_log(const std::string&                                   target,
+                       const std::string&                                   source,
+                       const log_callback&                                  callback,
+                       bool                                                 finding_merged         = true,
+                       const revision&                                      target_peg_revision    = revision_kind::unspecified,
+                       const revision&                                      source_peg_revision    = revision_kind::unspecified,
+                       const revision&                                      source_start_revision  = revision_kind::unspecified,
+                       const revision&                                      source_end_revision    = revision_kind::unspecified,
+                       bool                                                 discover_changed_paths = false,
+                       svn::depth                                           depth                  = svn::depth::empty,
+                       const std::optional<const std::vector<std::string>>& revprops               = {}) const;
+
+    void move(const std::vector<std::string>& sources,
+              const std::string&              destination,
+              const std::string&              message,
+              const commit_callback&          callback,
+              bool                            move_as_child         = true,
+              bool                            make_parents          = false,
+              bool                            allow_mixed_revisions = true,
+              const string_map&               revprop_table         = string_map()) const;
+
+    void propget(const std::string&                                   name,
+                 const std::vector<std::string>&                      targets,
+                 const property_callback&                             callback,
+                 const revision&                                      peg_revision        = revision_kind::unspecified,
+                 const revision&                                      op_revision         = revision_kind::unspecified,
+                 svn::depth                                           depth               = svn::depth::empty,
+                 bool                                                 get_inherited_props = false,
+                 const std::optional<const std::vector<std::string>>& changelists         = {}) const;
+
+    void proplist(const std::vector<std::string>&                      targets,
+                  const property_callback&                             callback,
+                  const revision&                                      peg_revision        = revision_kind::unspecified,
+                  const revision&                                      op_revision         = revision_kind::unspecified,
+                  svn::depth                                           depth               = svn::depth::empty,
+                  bool                                                 get_inherited_props = false,
+                  const std::optional<const std::vector<std::string>>& changelists         = {}) const;
+
     void remove(const std::vector<std::string>& paths,
                 const remove_callback&          callback,
                 bool                            force         = true,
@@ -168,6 +301,10 @@ class client : public std::enable_shared_from_this<client> {
                 bool                                                 metadata_only     = false,
                 bool                                                 added_keep_local  = false) const;
 
+    void stat(const std::vector<std::string>& urls,
+              const stat_callback&            callback,
+              const revision&                 op_revision = revision_kind::head) const;
+
     int32_t status(const std::string&                                   path,
                    const status_callback&                               callback,
                    const revision&                                      op_revision        = revision_kind::working,
@@ -178,7 +315,12 @@ class client : public std::enable_shared_from_this<client> {
                    bool                                                 no_ignore          = false,
                    bool                                                 ignore_externals   = false,
                    bool                                                 depth_as_sticky    = false,
-                   const std::optional<const std::vector<std::string>>& changelists        = {}) const;
+                   const std::optional<const std::vector<std::string>>& changelists        = {},
+                   const status_filter&                                 filter             = {}) const;
+
+    void unlock(const std::vector<std::string>& targets,
+                const lock_callback&            callback,
+                bool                            break_lock = false) const;
 
     void update(const std::vector<std::string>& paths,
                 const notify_function&          notify,
@@ -193,11 +335,24 @@ class client : public std::enable_shared_from_this<client> {
     std::string get_working_copy_root(const std::string& path) const;
 
   private:
+    struct inherited_properties_cache;
+    struct mergeinfo_cache;
+
     static bool _apr_initialized;
 
     apr_pool_t*       _pool;
     svn_client_ctx_t* _context;
 
+    std::unique_ptr<inherited_properties_cache> _inherited_properties_cache;
+    std::unique_ptr<mergeinfo_cache>            _mergeinfo_cache;
+
+    // swapped by `set_*_cache` while operations may run on other threads,
+    // through `std::atomic_load` and `std::atomic_store` only. Every operation
+    // keeps its own copy until it's done.
+    std::shared_ptr<log_cache>   _log_cache;
+    std::shared_ptr<blame_cache> _blame_cache;
+    std::shared_ptr<fetch_cache> _fetch_cache;
+
     std::optional<abort_function>  _abort_function;
     std::set<simple_auth_provider> _simple_auth_providers;
 };
@@ -0,0 +1,351 @@
+#include "fetch_cache.hpp"
+
+#include <optional>
+#include <vector>
+
+#include <apr_file_info.h>
+#include <apr_file_io.h>
+#include <apr_hash.h>
+#include <apr_pools.h>
+#include <apr_strings.h>
+#include <apr_time.h>
+
+#include <svn_checksum.h>
+#include <svn_dirent_uri.h>
+#include <svn_hash.h>
+#include <svn_io.h>
+#include <svn_props.h>
+#include <svn_ra.h>
+#include <svn_string.h>
+
+#include <private/svn_sqlite.h>
+
+#include "type_conversion.hpp"
+
+namespace svn {
+static svn_error_t* invoke_vector_write(void* raw_baton, const char* data, apr_size_t* length) {
+    auto vector = static_cast<std::vector<char>*>(raw_baton);
+    vector->insert(vector->end(), data, data + *length);
+    return nullptr;
+}
+
+enum statement_index {
+    STMT_CREATE_SCHEMA,
+    STMT_SELECT_LOCATION,
+    STMT_INSERT_LOCATION,
+    STMT_INSERT_OBJECT,
+    STMT_TOUCH_OBJECT,
+    STMT_SELECT_BY_AGE,
+    STMT_DELETE_OBJECT,
+    STMT_DELETE_LOCATIONS,
+    STMT_SELECT_SIZE,
+};
+
+static const char* const statements[] = {
+    // STMT_CREATE_SCHEMA
+    "CREATE TABLE IF NOT EXISTS objects ("
+    "  checksum TEXT PRIMARY KEY,"
+    "  size INTEGER NOT NULL,"
+    "  last_used INTEGER NOT NULL);"
+    "CREATE INDEX IF NOT EXISTS objects_last_used ON objects (last_used);"
+    "CREATE TABLE IF NOT EXISTS locations ("
+    "  uuid TEXT NOT NULL,"
+    "  path TEXT NOT NULL,"
+    "  revision INTEGER NOT NULL,"
+    "  checksum TEXT NOT NULL,"
+    "  props BLOB NOT NULL,"
+    "  PRIMARY KEY (uuid, path, revision));"
+    "CREATE INDEX IF NOT EXISTS locations_checksum ON locations (checksum);",
+
+    // STMT_SELECT_LOCATION
+    "SELECT checksum, props FROM locations WHERE uuid = ?1 AND path = ?2 AND revision = ?3",
+
+    // STMT_INSERT_LOCATION
+    "INSERT OR REPLACE INTO locations (uuid, path, revision, checksum, props) VALUES (?1, ?2, ?3, ?4, ?5)",
+
+    // STMT_INSERT_OBJECT
+    "INSERT OR REPLACE INTO objects (checksum, size, last_used) VALUES (?1, ?2, ?3)",
+
+    // STMT_TOUCH_OBJECT
+    "UPDATE objects SET last_used = ?2 WHERE checksum = ?1",
+
+    // STMT_SELECT_BY_AGE
+    "SELECT checksum, size FROM objects ORDER BY last_used DESC",
+
+    // STMT_DELETE_OBJECT
+    "DELETE FROM objects WHERE checksum = ?1",
+
+    // STMT_DELETE_LOCATIONS
+    "DELETE FROM locations WHERE checksum = ?1",
+
+    // STMT_SELECT_SIZE
+    "SELECT COALESCE(SUM(size), 0) FROM objects",
+
+    nullptr,
+};
+
+// objects are spread over 256 directories by the first byte of their checksum
+static const char* get_object_path(const std::string& directory, const char* checksum, apr_pool_t* pool) {
+    auto prefix = apr_pstrndup(pool, checksum, 2);
+    return svn_dirent_join_many(pool, directory.c_str(), "objects", prefix, checksum + 2, SVN_VA_NULL);
+}
+
+struct location {
+    std::string checksum;
+    apr_hash_t* props;
+};
+
+static std::optional<location> find_location(svn_sqlite__db_t* db,
+                                             const char*       uuid,
+                                             const char*       path,
+                                             int32_t           revision,
+                                             apr_pool_t*       pool) {
+    svn_sqlite__stmt_t* stmt;
+    svn_boolean_t       have_row;
+
+    check_result(svn_sqlite__get_statement(&stmt, db, STMT_SELECT_LOCATION));
+    check_result(svn_sqlite__bindf(stmt, "ssr", uuid, path, static_cast<svn_revnum_t>(revision)));
+    check_result(svn_sqlite__step(&have_row, stmt));
+    if (!have_row) {
+        check_result(svn_sqlite__reset(stmt));
+        return {};
+    }
+
+    location result{svn_sqlite__column_text(stmt, 0, nullptr), apr_hash_make(pool)};
+
+    apr_size_t size;
+    auto       data   = static_cast<const char*>(svn_sqlite__column_blob(stmt, 1, &size, pool));
+    auto       stream = svn_stream_from_string(svn_string_ncreate(data, size, pool), pool);
+    auto       error  = svn_hash_read2(result.props, stream, SVN_HASH_TERMINATOR, pool);
+
+    check_result(svn_sqlite__reset(stmt));
+
+    // a broken entry is only a miss
+    if (error != nullptr) {
+        svn_error_clear(error);
+        return {};
+    }
+
+    return result;
+}
+
+fetch_cache::fetch_cache(const std::string& directory, int64_t max_size)
+    : _max_size(max_size)
+    , _metrics{0, 0, 0, 0, 0} {
+    check_result(apr_pool_create_ex(&_pool, nullptr, nullptr, nullptr));
+
+    apr_pool_t* pool;
+    check_result(apr_pool_create_ex(&pool, _pool, nullptr, nullptr));
+
+    try {
+        auto raw_directory = convert_from_path(directory, pool);
+        check_result(svn_io_make_dir_recursively(raw_directory, pool));
+        _directory = raw_directory;
+
+        check_result(svn_sqlite__open(&_db,
+                                      svn_dirent_join(raw_directory, "fetch.db", pool),
+                                      svn_sqlite__mode_rwcreate,
+                                      statements,
+                                      0,
+                                      nullptr,
+                                      0,
+                                      _pool,
+                                      pool));
+        check_result(svn_sqlite__exec_statements(_db, STMT_CREATE_SCHEMA));
+    } catch (...) {
+        apr_pool_destroy(_pool);
+        throw;
+    }
+
+    apr_pool_destroy(pool);
+}
+
+fetch_cache::~fetch_cache() {
+    // closes the database
+    apr_pool_destroy(_pool);
+}
+
+void fetch_cache::get_file(svn_ra_session_t*  session,
+                           const char*        uuid,
+                           const char*        path,
+                           int32_t            revision,
+                           std::vector<char>& content,
+                           apr_hash_t**       props,
+                           apr_pool_t*        pool) {
+    std::optional<location> found;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        found = find_location(_db, uuid, path, revision, pool);
+        if (found && read_object(found->checksum.c_str(), content, pool)) {
+            *props = found->props;
+            return;
+        }
+    }
+
+    // the properties tell the revision the file last changed in, which may
+    // have been fetched before
+    apr_hash_t* raw_props;
+    check_result(svn_ra_get_file(session, path, revision, nullptr, nullptr, &raw_props, pool));
+
+    auto         committed_rev = static_cast<svn_string_t*>(svn_hash_gets(raw_props, SVN_PROP_ENTRY_COMMITTED_REV));
+    svn_revnum_t changed       = committed_rev != nullptr ? SVN_STR_TO_REV(committed_rev->data) : SVN_INVALID_REVNUM;
+
+    if (SVN_IS_VALID_REVNUM(changed) && changed != revision) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        found = find_location(_db, uuid, path, static_cast<int32_t>(changed), pool);
+        if (found && read_object(found->checksum.c_str(), content, pool)) {
+            add_location(uuid, path, revision, found->checksum.c_str(), raw_props, pool);
+
+            *props = raw_props;
+            return;
+        }
+    }
+
+    auto stream = svn_stream_create(&content, pool);
+    svn_stream_set_write(stream, invoke_vector_write);
+
+    check_result(svn_ra_get_file(session, path, revision, stream, nullptr, nullptr, pool));
+    *props = raw_props;
+
+    svn_checksum_t* checksum;
+    check_result(svn_checksum(&checksum, svn_checksum_sha1, content.data(), content.size(), pool));
+    auto raw_checksum = svn_checksum_to_cstring_display(checksum, pool);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _metrics.misses++;
+    _metrics.bytes_fetched += content.size();
+
+    if (static_cast<int64_t>(content.size()) > _max_size) {
+        return;
+    }
+
+    write_object(raw_checksum, content, pool);
+    add_location(uuid, path, revision, raw_checksum, raw_props, pool);
+    if (SVN_IS_VALID_REVNUM(changed) && changed != revision) {
+        add_location(uuid, path, static_cast<int32_t>(changed), raw_checksum, raw_props, pool);
+    }
+
+    evict(pool);
+}
+
+fetch_cache_metrics fetch_cache::get_metrics() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    svn_sqlite__stmt_t* stmt;
+    svn_boolean_t       have_row;
+
+    check_result(svn_sqlite__get_statement(&stmt, _db, STMT_SELECT_SIZE));
+    check_result(svn_sqlite__step(&have_row, stmt));
+
+    auto result = _metrics;
+    result.size = have_row ? svn_sqlite__column_int64(stmt, 0) : 0;
+
+    check_result(svn_sqlite__reset(stmt));
+    return result;
+}
+
+bool fetch_cache::read_object(const char* checksum, std::vector<char>& content, apr_pool_t* pool) {
+    apr_file_t* file;
+    auto        error = svn_io_file_open(&file, get_object_path(_directory, checksum, pool), APR_READ, APR_OS_DEFAULT, pool);
+    if (error != nullptr) {
+        // evicted by another process, fetch it again
+        if (APR_STATUS_IS_ENOENT(error->apr_err)) {
+            svn_error_clear(error);
+            return false;
+        }
+        check_result(error);
+    }
+
+    apr_finfo_t info;
+    check_result(svn_io_file_info_get(&info, APR_FINFO_SIZE, file, pool));
+
+    // read in place, the content is the largest allocation of a fetch
+    content.resize(static_cast<size_t>(info.size));
+    check_result(svn_io_file_read_full2(file, content.data(), content.size(), nullptr, nullptr, pool));
+    check_result(svn_io_file_close(file, pool));
+
+    svn_sqlite__stmt_t* stmt;
+    check_result(svn_sqlite__get_statement(&stmt, _db, STMT_TOUCH_OBJECT));
+    check_result(svn_sqlite__bind_text(stmt, 1, checksum));
+    check_result(svn_sqlite__bind_int64(stmt, 2, apr_time_now()));
+    check_result(svn_sqlite__update(nullptr, stmt));
+
+    _metrics.hits++;
+    _metrics.bytes_served += content.size();
+
+    return true;
+}
+
+void fetch_cache::write_object(const char* checksum, const std::vector<char>& content, apr_pool_t* pool) {
+    auto path = get_object_path(_directory, checksum, pool);
+
+    svn_node_kind_t kind;
+    check_result(svn_io_check_path(path, &kind, pool));
+    if (kind == svn_node_none) {
+        check_result(svn_io_make_dir_recursively(svn_dirent_dirname(path, pool), pool));
+        check_result(svn_io_write_atomic2(path, content.data(), content.size(), nullptr, false, pool));
+    }
+
+    svn_sqlite__stmt_t* stmt;
+    check_result(svn_sqlite__get_statement(&stmt, _db, STMT_INSERT_OBJECT));
+    check_result(svn_sqlite__bind_text(stmt, 1, checksum));
+    check_result(svn_sqlite__bind_int64(stmt, 2, static_cast<apr_int64_t>(content.size())));
+    check_result(svn_sqlite__bind_int64(stmt, 3, apr_time_now()));
+
+    apr_int64_t row;
+    check_result(svn_sqlite__insert(&row, stmt));
+}
+
+void fetch_cache::add_location(const char* uuid,
+                               const char* path,
+                               int32_t     revision,
+                               const char* checksum,
+                               apr_hash_t* props,
+                               apr_pool_t* pool) {
+    auto buffer = svn_stringbuf_create_empty(pool);
+    check_result(svn_hash_write2(props, svn_stream_from_stringbuf(buffer, pool), SVN_HASH_TERMINATOR, pool));
+
+    svn_sqlite__stmt_t* stmt;
+    check_result(svn_sqlite__get_statement(&stmt, _db, STMT_INSERT_LOCATION));
+    check_result(svn_sqlite__bindf(stmt, "ssrs", uuid, path, static_cast<svn_revnum_t>(revision), checksum));
+    check_result(svn_sqlite__bind_blob(stmt, 5, buffer->data, buffer->len));
+
+    apr_int64_t row;
+    check_result(svn_sqlite__insert(&row, stmt));
+}
+
+void fetch_cache::evict(apr_pool_t* pool) {
+    std::vector<std::string> evicted;
+
+    svn_sqlite__stmt_t* stmt;
+    svn_boolean_t       have_row;
+
+    // keeps the most recently used objects that fit
+    int64_t total = 0;
+    check_result(svn_sqlite__get_statement(&stmt, _db, STMT_SELECT_BY_AGE));
+    check_result(svn_sqlite__step(&have_row, stmt));
+    while (have_row) {
+        total += svn_sqlite__column_int64(stmt, 1);
+        if (total > _max_size) {
+            evicted.emplace_back(svn_sqlite__column_text(stmt, 0, nullptr));
+        }
+        check_result(svn_sqlite__step(&have_row, stmt));
+    }
+    check_result(svn_sqlite__reset(stmt));
+
+    for (auto& checksum : evicted) {
+        check_result(svn_sqlite__get_statement(&stmt, _db, STMT_DELETE_LOCATIONS));
+        check_result(svn_sqlite__bind_text(stmt, 1, checksum.c_str()));
+        check_result(svn_sqlite__step_done(stmt));
+
+        check_result(svn_sqlite__get_statement(&stmt, _db, STMT_DELETE_OBJECT));
+        check_result(svn_sqlite__bind_text(stmt, 1, checksum.c_str()));
+        check_result(svn_sqlite__step_done(stmt));
+
+        check_result(svn_io_remove_file2(get_object_path(_directory, checksum.c_str(), pool), true, pool));
+    }
+}
+} // namespace svn
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <cpp/types.hpp>
+
+struct apr_hash_t;
+struct apr_pool_t;
+struct svn_ra_session_t;
+struct svn_sqlite__db_t;
+
+namespace svn {
+// File contents fetched from repositories, stored once per SHA-1 checksum
+// no matter how many paths and revisions they appear at, and evicted least
+// recently used first once they take more than a size limit.
+//
+// A path in a revision never changes, so once it is known it's served
+// without the server. Otherwise only the properties are fetched first: the
+// last changed revision they carry finds the same file revision fetched at
+// another revision.
+class fetch_cache {
+  public:
+    fetch_cache(const std::string& directory, int64_t max_size);
+    ~fetch_cache();
+
+    fetch_cache(const fetch_cache&) = delete;
+    fetch_cache& operator=(const fetch_cache&) = delete;
+
+    // Like `svn_ra_get_file`, `path` is relative to the session URL, so
+    // `session` must be parented at the repository root.
+    // `content` must be empty, it's filled in place.
+    void get_file(svn_ra_session_t*  session,
+                  const char*        uuid,
+                  const char*        path,
+                  int32_t            revision,
+                  std::vector<char>& content,
+                  apr_hash_t**       props,
+                  apr_pool_t*        pool);
+
+    fetch_cache_metrics get_metrics();
+
+  private:
+    bool read_object(const char* checksum, std::vector<char>& content, apr_pool_t* pool);
+    void write_object(const char* checksum, const std::vector<char>& content, apr_pool_t* pool);
+    void add_location(const char* uuid, const char* path, int32_t revision, const char* checksum, apr_hash_t* props, apr_pool_t* pool);
+    void evict(apr_pool_t* pool);
+
+    std::mutex        _mutex;
+    std::string       _directory;
+    int64_t           _max_size;
+    apr_pool_t*       _pool;
+    svn_sqlite__db_t* _db;
+
+    fetch_cache_metrics _metrics;
+};
+} // namespace svn
@@ -0,0 +1,663 @@
+#include "log_cache.hpp"
+
+#include <algorithm>
+
+#include <apr_hash.h>
+#include <apr_pools.h>
+
+#include <svn_dirent_uri.h>
+#include <svn_io.h>
+#include <svn_props.h>
+#include <svn_ra.h>
+#include <svn_time.h>
+
+#include <private/svn_sqlite.h>
+
+#include "type_conversion.hpp"
+
+namespace svn {
+// revisions are committed in batches, so an interrupted sync keeps most of
+// its work without paying a transaction per revision
+static const int32_t sync_batch_size = 1000;
+
+enum statement_index {
+    STMT_CREATE_SCHEMA,
+    STMT_SELECT_INFO,
+    STMT_INSERT_INFO,
+    STMT_UPDATE_INFO,
+    STMT_INSERT_REVISION,
+    STMT_INSERT_MESSAGE,
+    STMT_INSERT_CHANGED_PATH,
+    STMT_SELECT_REVISION,
+    STMT_SELECT_CHANGED_PATHS,
+    STMT_SELECT_REVISIONS,
+    STMT_SELECT_PATH_REVISIONS,
+    STMT_SELECT_CREATION,
+    STMT_SEARCH,
+    STMT_SEARCH_PATH,
+};
+
+static const char* const statements[] = {
+    // STMT_CREATE_SCHEMA
+    "CREATE TABLE IF NOT EXISTS cache_info ("
+    "  id INTEGER PRIMARY KEY,"
+    "  root TEXT NOT NULL,"
+    "  uuid TEXT NOT NULL,"
+    "  youngest INTEGER NOT NULL);"
+    "CREATE TABLE IF NOT EXISTS revisions ("
+    "  revision INTEGER PRIMARY KEY,"
+    "  author TEXT,"
+    "  date INTEGER,"
+    "  message TEXT);"
+    "CREATE INDEX IF NOT EXISTS revisions_author ON revisions (author, revision);"
+    "CREATE INDEX IF NOT EXISTS revisions_date ON revisions (date);"
+    "CREATE TABLE IF NOT EXISTS changed_paths ("
+    "  path TEXT NOT NULL,"
+    "  revision INTEGER NOT NULL,"
+    "  action TEXT NOT NULL,"
+    "  copyfrom_path TEXT,"
+    "  copyfrom_rev INTEGER,"
+    "  node_kind INTEGER NOT NULL,"
+    "  text_modified INTEGER,"
+    "  props_modified INTEGER,"
+    "  PRIMARY KEY (path, revision)) WITHOUT ROWID;"
+    "CREATE INDEX IF NOT EXISTS changed_paths_revision ON changed_paths (revision);"
+    "CREATE VIRTUAL TABLE IF NOT EXISTS messages USING fts5 ("
+    "  message, content = 'revisions', content_rowid = 'revision');",
+
+    // STMT_SELECT_INFO
+    "SELECT root, uuid, youngest FROM cache_info WHERE id = 0",
+
+    // STMT_INSERT_INFO
+    "INSERT OR IGNORE INTO cache_info (id, root, uuid, youngest) VALUES (0, ?1, ?2, -1)",
+
+    // STMT_UPDATE_INFO
+    "UPDATE cache_info SET root = ?1, youngest = ?2 WHERE id = 0",
+
+    // STMT_INSERT_REVISION
+    "INSERT INTO revisions (revision, author, date, message) VALUES (?1, ?2, ?3, ?4)",
+
+    // STMT_INSERT_MESSAGE
+    "INSERT INTO messages (rowid, message) VALUES (?1, ?2)",
+
+    // STMT_INSERT_CHANGED_PATH
+    "INSERT INTO changed_paths"
+    "  (path, revision, action, copyfrom_path, copyfrom_rev, node_kind, text_modified, props_modified)"
+    "  VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8)",
+
+    // STMT_SELECT_REVISION
+    "SELECT author, date, message FROM revisions WHERE revision = ?1",
+
+    // STMT_SELECT_CHANGED_PATHS
+    "SELECT path, action, copyfrom_path, copyfrom_rev, node_kind, text_modified, props_modified"
+    "  FROM changed_paths WHERE revision = ?1",
+
+    // STMT_SELECT_REVISIONS
+    "SELECT revision FROM revisions WHERE revision BETWEEN ?1 AND ?2 ORDER BY revision DESC",
+
+    // STMT_SELECT_PATH_REVISIONS
+    // '0' follows '/', so the range holds exactly the descendants of ?1
+    "SELECT DISTINCT revision FROM changed_paths"
+    "  WHERE (path = ?1 OR (path > ?1 || '/' AND path < ?1 || '0'))"
+    "    AND revision BETWEEN ?2 AND ?3"
+    "  ORDER BY revision DESC",
+
+    // STMT_SELECT_CREATION
+    "SELECT revision, copyfrom_path, copyfrom_rev FROM changed_paths"
+    "  WHERE path = ?1 AND revision BETWEEN ?2 AND ?3 AND action IN ('A', 'R')"
+    "  ORDER BY revision DESC LIMIT 1",
+
+    // STMT_SEARCH
+    "SELECT revision FROM revisions"
+    "  WHERE (?1 IS NULL OR author = ?1)"
+    "    AND (?2 IS NULL OR date >= ?2)"
+    "    AND (?3 IS NULL OR date <= ?3)"
+    "    AND (?4 IS NULL OR revision IN (SELECT rowid FROM messages WHERE messages MATCH ?4))"
+    "  ORDER BY revision DESC LIMIT ?5",
+
+    // STMT_SEARCH_PATH
+    "SELECT DISTINCT c.revision FROM changed_paths AS c"
+    "  JOIN revisions AS r ON r.revision = c.revision"
+    "  WHERE (c.path = ?6 OR (c.path > ?6 || '/' AND c.path < ?6 || '0'))"
+    "    AND (?1 IS NULL OR r.author = ?1)"
+    "    AND (?2 IS NULL OR r.date >= ?2)"
+    "    AND (?3 IS NULL OR r.date <= ?3)"
+    "    AND (?4 IS NULL OR r.revision IN (SELECT rowid FROM messages WHERE messages MATCH ?4))"
+    "  ORDER BY c.revision DESC LIMIT ?5",
+
+    nullptr,
+};
+
+static svn_error_t* bind_optional(svn_sqlite__stmt_t* stmt, int slot, const std::optional<std::string>& value) {
+    return svn_sqlite__bind_text(stmt, slot, value ? value->c_str() : nullptr);
+}
+
+static svn_error_t* bind_optional(svn_sqlite__stmt_t* stmt, int slot, const std::optional<int64_t>& value) {
+    if (value) {
+        return svn_sqlite__bind_int64(stmt, slot, *value);
+    }
+    return svn_sqlite__bind_text(stmt, slot, nullptr);
+}
+
+static svn_error_t* bind_tristate(svn_sqlite__stmt_t* stmt, int slot, svn_tristate_t value) {
+    if (value == svn_tristate_unknown) {
+        return svn_sqlite__bind_text(stmt, slot, nullptr);
+    }
+    return svn_sqlite__bind_int(stmt, slot, value == svn_tristate_true);
+}
+
+static std::optional<std::string> column_optional_text(svn_sqlite__stmt_t* stmt, int column) {
+    if (svn_sqlite__column_is_null(stmt, column)) {
+        return {};
+    }
+    return std::string(svn_sqlite__column_text(stmt, column, nullptr));
+}
+
+static std::optional<bool> column_optional_bool(svn_sqlite__stmt_t* stmt, int column) {
+    if (svn_sqlite__column_is_null(stmt, column)) {
+        return {};
+    }
+    return svn_sqlite__column_boolean(stmt, column) != 0;
+}
+
+static svn_error_t* update_info(svn_sqlite__db_t* db, const char* root, int32_t youngest) {
+    svn_sqlite__stmt_t* stmt;
+    SVN_ERR(svn_sqlite__get_statement(&stmt, db, STMT_UPDATE_INFO));
+    SVN_ERR(svn_sqlite__bind_text(stmt, 1, root));
+    SVN_ERR(svn_sqlite__bind_int64(stmt, 2, youngest));
+    return svn_sqlite__update(nullptr, stmt);
+}
+
+static std::vector<int32_t> select_revisions(svn_sqlite__stmt_t* stmt) {
+    std::vector<int32_t> result;
+
+    svn_boolean_t have_row;
+    check_result(svn_sqlite__step(&have_row, stmt));
+    while (have_row) {
+        result.push_back(static_cast<int32_t>(svn_sqlite__column_revnum(stmt, 0)));
+        check_result(svn_sqlite__step(&have_row, stmt));
+    }
+    check_result(svn_sqlite__reset(stmt));
+
+    return result;
+}
+
+static log_entry read_entry(svn_sqlite__db_t* db, int32_t revision, bool discover_changed_paths) {
+    log_entry entry{revision, {}, {}, {}, {}, false, {}, false, false};
+
+    svn_sqlite__stmt_t* stmt;
+    svn_boolean_t       have_row;
+
+    check_result(svn_sqlite__get_statement(&stmt, db, STMT_SELECT_REVISION));
+    check_result(svn_sqlite__bind_revnum(stmt, 1, revision));
+    check_result(svn_sqlite__step(&have_row, stmt));
+    if (have_row) {
+        entry.author  = column_optional_text(stmt, 0);
+        entry.message = column_optional_text(stmt, 2);
+        if (!svn_sqlite__column_is_null(stmt, 1)) {
+            entry.date = svn_sqlite__column_int64(stmt, 1);
+        }
+    }
+    check_result(svn_sqlite__reset(stmt));
+
+    if (discover_changed_paths) {
+        check_result(svn_sqlite__get_statement(&stmt, db, STMT_SELECT_CHANGED_PATHS));
+        check_result(svn_sqlite__bind_revnum(stmt, 1, revision));
+        check_result(svn_sqlite__step(&have_row, stmt));
+        while (have_row) {
+            auto action = svn_sqlite__column_text(stmt, 1, nullptr);
+
+            entry.changed_paths.emplace(std::string(svn_sqlite__column_text(stmt, 0, nullptr)),
+                                        log_changed_path{action[0],
+                                                         column_optional_text(stmt, 2),
+                                                         static_cast<int32_t>(svn_sqlite__column_revnum(stmt, 3)),
+                                                         static_cast<node_kind>(svn_sqlite__column_int(stmt, 4)),
+                                                         column_optional_bool(stmt, 5),
+                                                         column_optional_bool(stmt, 6)});
+            check_result(svn_sqlite__step(&have_row, stmt));
+        }
+        check_result(svn_sqlite__reset(stmt));
+    }
+
+    return entry;
+}
+
+struct sync_baton {
+    svn_sqlite__db_t* db;
+    const char*       root;
+    int32_t           youngest;
+    int32_t           committed;
+    int32_t           pending;
+};
+
+static svn_error_t* invoke_sync(void* raw_baton, svn_log_entry_t* entry, apr_pool_t* pool) {
+    auto baton = static_cast<sync_baton*>(raw_baton);
+
+    const char* author;
+    const char* date;
+    const char* message;
+    svn_compat_log_revprops_out(&author, &date, &message, entry->revprops);
+
+    svn_sqlite__stmt_t* stmt;
+    apr_int64_t         row;
+
+    SVN_ERR(svn_sqlite__get_statement(&stmt, baton->db, STMT_INSERT_REVISION));
+    SVN_ERR(svn_sqlite__bind_revnum(stmt, 1, entry->revision));
+    SVN_ERR(svn_sqlite__bind_text(stmt, 2, author));
+    if (date != nullptr) {
+        apr_time_t time;
+        SVN_ERR(svn_time_from_cstring(&time, date, pool));
+        SVN_ERR(svn_sqlite__bind_int64(stmt, 3, time));
+    } else {
+        SVN_ERR(svn_sqlite__bind_text(stmt, 3, nullptr));
+    }
+    SVN_ERR(svn_sqlite__bind_text(stmt, 4, message));
+    SVN_ERR(svn_sqlite__insert(&row, stmt));
+
+    if (message != nullptr) {
+        SVN_ERR(svn_sqlite__get_statement(&stmt, baton->db, STMT_INSERT_MESSAGE));
+        SVN_ERR(svn_sqlite__bind_revnum(stmt, 1, entry->revision));
+        SVN_ERR(svn_sqlite__bind_text(stmt, 2, message));
+        SVN_ERR(svn_sqlite__insert(&row, stmt));
+    }
+
+    if (entry->changed_paths2 != nullptr) {
+        for (auto index = apr_hash_first(pool, entry->changed_paths2); index; index = apr_hash_next(index)) {
+            auto path    = static_cast<const char*>(apr_hash_this_key(index));
+            auto changed = static_cast<svn_log_changed_path2_t*>(apr_hash_this_val(index));
+
+            const char action[] = {changed->action, '\0'};
+
+            SVN_ERR(svn_sqlite__get_statement(&stmt, baton->db, STMT_INSERT_CHANGED_PATH));
+            SVN_ERR(svn_sqlite__bind_text(stmt, 1, path));
+            SVN_ERR(svn_sqlite__bind_revnum(stmt, 2, entry->revision));
+            SVN_ERR(svn_sqlite__bind_text(stmt, 3, action));
+            SVN_ERR(svn_sqlite__bind_text(stmt, 4, changed->copyfrom_path));
+            SVN_ERR(svn_sqlite__bind_revnum(stmt, 5, changed->copyfrom_rev));
+            SVN_ERR(svn_sqlite__bind_int(stmt, 6, changed->node_kind));
+            SVN_ERR(bind_tristate(stmt, 7, changed->text_modified));
+            SVN_ERR(bind_tristate(stmt, 8, changed->props_modified));
+            SVN_ERR(svn_sqlite__insert(&row, stmt));
+        }
+    }
+
+    baton->youngest = static_cast<int32_t>(entry->revision);
+    baton->pending++;
+
+    if (baton->pending >= sync_batch_size) {
+        SVN_ERR(update_info(baton->db, baton->root, baton->youngest));
+        SVN_ERR(svn_sqlite__finish_transaction(baton->db, nullptr));
+        baton->committed = baton->youngest;
+        baton->pending   = 0;
+
+        SVN_ERR(svn_sqlite__begin_transaction(baton->db));
+    }
+
+    return nullptr;
+}
+
+log_cache::log_cache(const std::string& directory)
+    : _directory(directory)
+    , _metrics{0, 0, 0, 0} {
+    check_result(apr_pool_create_ex(&_pool, nullptr, nullptr, nullptr));
+
+    apr_pool_t* pool;
+    check_result(apr_pool_create_ex(&pool, _pool, nullptr, nullptr));
+
+    try {
+        auto raw_directory = convert_from_path(_directory, pool);
+        check_result(svn_io_make_dir_recursively(raw_directory, pool));
+
+        // caches of repositories that were synced before can answer queries
+        // before talking to the server again
+        apr_hash_t* dirents;
+        check_result(svn_io_get_dirents3(&dirents, raw_directory, true, pool, pool));
+        for (auto index = apr_hash_first(pool, dirents); index; index = apr_hash_next(index)) {
+            auto name = static_cast<const char*>(apr_hash_this_key(index));
+            auto length = strlen(name);
+            if (length <= 3 || strcmp(name + length - 3, ".db") != 0) {
+                continue;
+            }
+
+            try {
+                open(svn_dirent_join(raw_directory, name, pool), nullptr, nullptr);
+            } catch (const svn_error&) {
+                // not a cache, or a broken one, `sync` recreates it
+            }
+        }
+    } catch (...) {
+        apr_pool_destroy(_pool);
+        throw;
+    }
+
+    apr_pool_destroy(pool);
+}
+
+log_cache::~log_cache() {
+    // closes the databases
+    apr_pool_destroy(_pool);
+}
+
+log_cache::repository& log_cache::open(const char* path, const char* root, const char* uuid) {
+    // statements are prepared lazily into the result pool of the database,
+    // while queries on different repositories run side by side, so each
+    // one needs a pool of its own, it lives as long as the database
+    apr_pool_t* db_pool;
+    check_result(apr_pool_create_ex(&db_pool, _pool, nullptr, nullptr));
+
+    apr_pool_t* pool;
+    check_result(apr_pool_create_ex(&pool, _pool, nullptr, nullptr));
+
+    svn_sqlite__db_t* db;
+    auto              result = svn_sqlite__open(&db,
+                                   path,
+                                   svn_sqlite__mode_rwcreate,
+                                   statements,
+                                   0,
+                                   nullptr,
+                                   0,
+                                   db_pool,
+                                   pool);
+    if (result == nullptr) {
+        result = svn_sqlite__exec_statements(db, STMT_CREATE_SCHEMA);
+    }
+
+    svn_sqlite__stmt_t* stmt;
+    if (result == nullptr && root != nullptr) {
+        result = svn_sqlite__get_statement(&stmt, db, STMT_INSERT_INFO);
+        if (result == nullptr) {
+            result = svn_sqlite__bindf(stmt, "ss", root, uuid);
+        }
+        if (result == nullptr) {
+            apr_int64_t row;
+            result = svn_sqlite__insert(&row, stmt);
+        }
+    }
+
+    svn_boolean_t have_row = false;
+    if (result == nullptr) {
+        result = svn_sqlite__get_statement(&stmt, db, STMT_SELECT_INFO);
+    }
+    if (result == nullptr) {
+        result = svn_sqlite__step(&have_row, stmt);
+    }
+
+    apr_pool_destroy(pool);
+    if (result == nullptr && !have_row) {
+        result = svn_error_compose_create(svn_sqlite__reset(stmt),
+                                          svn_error_createf(SVN_ERR_SQLITE_ERROR, nullptr, "'%s' is not a log cache", path));
+    }
+
+    if (result != nullptr) {
+        // closes the database
+        apr_pool_destroy(db_pool);
+        check_result(result);
+    }
+
+    _repositories.emplace_back();
+
+    auto& repository    = _repositories.back();
+    repository.root     = root != nullptr ? root : svn_sqlite__column_text(stmt, 0, nullptr);
+    repository.uuid     = svn_sqlite__column_text(stmt, 1, nullptr);
+    repository.youngest = static_cast<int32_t>(svn_sqlite__column_revnum(stmt, 2));
+    repository.db       = db;
+    check_result(svn_sqlite__reset(stmt));
+
+    return repository;
+}
+
+log_cache::repository* log_cache::find_repository(const std::string& root) {
+    for (auto& repository : _repositories) {
+        if (repository.root == root) {
+            return &repository;
+        }
+    }
+    return nullptr;
+}
+
+int32_t log_cache::sync(svn_ra_session_t* session, const char* root, const char* uuid, int32_t head, apr_pool_t* pool) {
+    repository* target = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (auto& repository : _repositories) {
+            if (repository.uuid == uuid) {
+                target = &repository;
+                break;
+            }
+        }
+
+        if (target == nullptr) {
+            auto file = std::string(uuid) + ".db";
+            target    = &open(svn_dirent_join(_directory.c_str(), file.c_str(), pool), root, uuid);
+        }
+
+        // the repository may have moved since the last sync
+        target->root = root;
+    }
+
+    std::lock_guard<std::mutex> lock(target->mutex);
+
+    if (target->youngest >= head) {
+        return target->youngest;
+    }
+
+    sync_baton baton{target->db, root, target->youngest, target->youngest, 0};
+
+    auto paths                         = apr_array_make(pool, 1, sizeof(const char*));
+    APR_ARRAY_PUSH(paths, const char*) = "";
+
+    auto revprops                         = apr_array_make(pool, 3, sizeof(const char*));
+    APR_ARRAY_PUSH(revprops, const char*) = SVN_PROP_REVISION_AUTHOR;
+    APR_ARRAY_PUSH(revprops, const char*) = SVN_PROP_REVISION_DATE;
+    APR_ARRAY_PUSH(revprops, const char*) = SVN_PROP_REVISION_LOG;
+
+    check_result(svn_sqlite__begin_transaction(target->db));
+
+    auto result = svn_ra_get_log2(session,
+                                  paths,
+                                  target->youngest + 1,
+                                  head,
+                                  0,
+                                  true,
+                                  false,
+                                  false,
+                                  revprops,
+                                  invoke_sync,
+                                  &baton,
+                                  pool);
+    if (result == nullptr) {
+        result = update_info(target->db, root, baton.youngest);
+    }
+
+    // an error rolls back the current batch only
+    result           = svn_sqlite__finish_transaction(target->db, result);
+    target->youngest = result == nullptr ? baton.youngest : baton.committed;
+    check_result(result);
+
+    return target->youngest;
+}
+
+std::optional<std::pair<std::string, int32_t>> log_cache::find(const char* url) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (auto& repository : _repositories) {
+        auto& root = repository.root;
+        if (strncmp(url, root.c_str(), root.size()) == 0 && (url[root.size()] == '\0' || url[root.size()] == '/')) {
+            std::lock_guard<std::mutex> lock(repository.mutex);
+            return std::make_pair(root, repository.youngest);
+        }
+    }
+
+    return {};
+}
+
+void log_cache::log(const std::string&  root,
+                    const std::string&  path,
+                    int32_t             peg,
+                    int32_t             start,
+                    int32_t             end,
+                    int32_t             limit,
+                    bool                discover_changed_paths,
+                    bool                strict_node_history,
+                    const log_callback& callback) {
+    repository* target;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        target = find_repository(root);
+        if (target != nullptr) {
+            _metrics.hits++;
+        }
+    }
+
+    if (target == nullptr) {
+        throw svn_error(SVN_ERR_ILLEGAL_TARGET, "The repository is not in the log cache");
+    }
+
+    auto oldest   = std::min(start, end);
+    auto youngest = std::max(start, end);
+
+    std::vector<int32_t>   revisions;
+    std::vector<log_entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(target->mutex);
+
+        svn_sqlite__stmt_t* stmt;
+
+        // walks the node backwards from the peg revision, one location at a
+        // time, like the server does for `svn_ra_get_log2`
+        auto current     = path;
+        auto current_peg = peg;
+        while (current_peg >= oldest) {
+            if (current == "/") {
+                check_result(svn_sqlite__get_statement(&stmt, target->db, STMT_SELECT_REVISIONS));
+                check_result(svn_sqlite__bind_revnum(stmt, 1, oldest));
+                check_result(svn_sqlite__bind_revnum(stmt, 2, current_peg));
+
+                auto segment = select_revisions(stmt);
+                revisions.insert(revisions.end(), segment.begin(), segment.end());
+                break;
+            }
+
+            // the node was created by the youngest add or replace of itself or
+            // one of its parents
+            int32_t                    created = -1;
+            std::optional<std::string> copyfrom_path;
+            int32_t                    copyfrom_rev = -1;
+            size_t                     created_size = 0;
+
+            for (auto parent = current; parent != "/"; parent = parent.substr(0, std::max<size_t>(parent.rfind('/'), 1))) {
+                svn_boolean_t have_row;
+
+                check_result(svn_sqlite__get_statement(&stmt, target->db, STMT_SELECT_CREATION));
+                check_result(svn_sqlite__bind_text(stmt, 1, parent.c_str()));
+                check_result(svn_sqlite__bind_revnum(stmt, 2, std::max(oldest, created)));
+                check_result(svn_sqlite__bind_revnum(stmt, 3, current_peg));
+                check_result(svn_sqlite__step(&have_row, stmt));
+                if (have_row) {
+                    auto revision = static_cast<int32_t>(svn_sqlite__column_revnum(stmt, 0));
+                    if (revision > created) {
+                        created       = revision;
+                        copyfrom_path = column_optional_text(stmt, 1);
+                        copyfrom_rev  = static_cast<int32_t>(svn_sqlite__column_revnum(stmt, 2));
+                        created_size  = parent.size();
+                    }
+                }
+                check_result(svn_sqlite__reset(stmt));
+            }
+
+            check_result(svn_sqlite__get_statement(&stmt, target->db, STMT_SELECT_PATH_REVISIONS));
+            check_result(svn_sqlite__bind_text(stmt, 1, current.c_str()));
+            check_result(svn_sqlite__bind_revnum(stmt, 2, std::max(oldest, created)));
+            check_result(svn_sqlite__bind_revnum(stmt, 3, current_peg));
+
+            auto segment = select_revisions(stmt);
+            revisions.insert(revisions.end(), segment.begin(), segment.end());
+
+            // a copy of a parent changes no path below it
+            if (created != -1 && (revisions.empty() || revisions.back() != created)) {
+                revisions.push_back(created);
+            }
+
+            if (created == -1 || !copyfrom_path || strict_node_history) {
+                break;
+            }
+
+            current     = *copyfrom_path + current.substr(created_size);
+            current_peg = copyfrom_rev;
+        }
+
+        revisions.erase(std::remove_if(revisions.begin(),
+                                       revisions.end(),
+                                       [youngest](int32_t revision) -> bool { return revision > youngest; }),
+                        revisions.end());
+
+        if (start < end) {
+            std::reverse(revisions.begin(), revisions.end());
+        }
+
+        if (limit > 0 && revisions.size() > static_cast<size_t>(limit)) {
+            revisions.resize(limit);
+        }
+
+        for (auto revision : revisions) {
+            entries.push_back(read_entry(target->db, revision, discover_changed_paths));
+        }
+    }
+
+    // outside of the lock, so the callback can use the cache again
+    for (auto& entry : entries) {
+        callback(entry);
+    }
+}
+
+std::vector<log_entry> log_cache::search(const std::string& root, const log_query& query) {
+    repository* target;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        target = find_repository(root);
+    }
+
+    if (target == nullptr) {
+        throw svn_error(SVN_ERR_ILLEGAL_TARGET, "The repository is not in the log cache");
+    }
+
+    std::lock_guard<std::mutex> lock(target->mutex);
+
+    auto path = query.path && *query.path != "/" ? query.path : std::nullopt;
+
+    svn_sqlite__stmt_t* stmt;
+    check_result(svn_sqlite__get_statement(&stmt, target->db, path ? STMT_SEARCH_PATH : STMT_SEARCH));
+    check_result(bind_optional(stmt, 1, query.author));
+    check_result(bind_optional(stmt, 2, query.date_from));
+    check_result(bind_optional(stmt, 3, query.date_to));
+    check_result(bind_optional(stmt, 4, query.message));
+    check_result(svn_sqlite__bind_int64(stmt, 5, query.limit.value_or(-1)));
+    if (path) {
+        check_result(svn_sqlite__bind_text(stmt, 6, path->c_str()));
+    }
+
+    std::vector<log_entry> result;
+    for (auto revision : select_revisions(stmt)) {
+        result.push_back(read_entry(target->db, revision, query.discover_changed_paths));
+    }
+    return result;
+}
+
+void log_cache::add_miss() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _metrics.misses++;
+}
+
+cache_metrics log_cache::get_metrics() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto result = _metrics;
+    for (auto& repository : _repositories) {
+        std::lock_guard<std::mutex> lock(repository.mutex);
+        // revisions 0 to `youngest`, -1 before the first sync
+        result.entries += repository.youngest + 1;
+    }
+    return result;
+}
+} // namespace svn
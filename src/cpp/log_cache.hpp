@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <cpp/types.hpp>
+
+struct apr_pool_t;
+struct svn_ra_session_t;
+struct svn_sqlite__db_t;
+
+namespace svn {
+// A local copy of the log of repositories, one SQLite database per
+// repository UUID, so history queries don't need the server.
+//
+// Only `svn:author`, `svn:date` and `svn:log` are kept as revision
+// properties, plus the changed paths of every revision.
+class log_cache {
+  public:
+    using log_callback = std::function<void(log_entry&)>;
+
+    explicit log_cache(const std::string& directory);
+    ~log_cache();
+
+    log_cache(const log_cache&) = delete;
+    log_cache& operator=(const log_cache&) = delete;
+
+    // Fetches the revisions after the youngest cached one, up to `head`.
+    // `session` must be parented at `root`. Returns the youngest cached
+    // revision.
+    int32_t sync(svn_ra_session_t* session, const char* root, const char* uuid, int32_t head, apr_pool_t* pool);
+
+    // The root of the cached repository `url` belongs to, and its youngest
+    // cached revision. Works without the server.
+    std::optional<std::pair<std::string, int32_t>> find(const char* url);
+
+    // Reports the log of the node at `path` (relative to the root with a
+    // leading slash) in `peg`, between `start` and `end`, following copies
+    // unless `strict_node_history`, like `svn_ra_get_log2` does. The caller
+    // checks the revisions are cached.
+    void log(const std::string&  root,
+             const std::string&  path,
+             int32_t             peg,
+             int32_t             start,
+             int32_t             end,
+             int32_t             limit,
+             bool                discover_changed_paths,
+             bool                strict_node_history,
+             const log_callback& callback);
+
+    std::vector<log_entry> search(const std::string& root, const log_query& query);
+
+    // Counts a `log` the cache couldn't answer, the server did.
+    void add_miss();
+
+    // `entries` are the cached revisions of every repository, nothing is
+    // ever evicted.
+    cache_metrics get_metrics();
+
+  private:
+    struct repository {
+        std::string       root;
+        std::string       uuid;
+        int32_t           youngest;
+        svn_sqlite__db_t* db;
+        std::mutex        mutex;
+    };
+
+    repository& open(const char* path, const char* root, const char* uuid);
+    repository* find_repository(const std::string& root);
+
+    std::mutex            _mutex;
+    std::string           _directory;
+    apr_pool_t*           _pool;
+    std::list<repository> _repositories;
+    cache_metrics         _metrics;
+};
+} // namespace svn
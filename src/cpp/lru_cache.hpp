@@ -0,0 +1,91 @@
+#pragma once
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "types.hpp"
+
+namespace svn {
+// A small thread-safe, size bounded cache that evicts the least recently used
+// entry. Values are copied in and out, so entries stay valid after eviction.
+template <class Key, class Value>
+class lru_cache {
+  public:
+    explicit lru_cache(size_t capacity)
+        : _capacity(capacity) {}
+
+    std::optional<Value> get(const Key& key) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto entry = _index.find(key);
+        if (entry == _index.end()) {
+            _metrics.misses++;
+            return {};
+        }
+
+        _metrics.hits++;
+        _items.splice(_items.begin(), _items, entry->second);
+        return entry->second->second;
+    }
+
+    void set(const Key& key, Value value) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto entry = _index.find(key);
+        if (entry != _index.end()) {
+            entry->second->second = std::move(value);
+            _items.splice(_items.begin(), _items, entry->second);
+            return;
+        }
+
+        _items.emplace_front(key, std::move(value));
+        _index.emplace(key, _items.begin());
+
+        evict();
+    }
+
+    // Evicts the least recently used entries right away when shrinking.
+    void set_capacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _capacity = capacity;
+        evict();
+    }
+
+    cache_metrics get_metrics() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto result    = _metrics;
+        result.entries = static_cast<int64_t>(_items.size());
+        return result;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _index.clear();
+        _items.clear();
+    }
+
+  private:
+    using list_type = std::list<std::pair<Key, Value>>;
+
+    void evict() {
+        while (_items.size() > _capacity) {
+            _index.erase(_items.back().first);
+            _items.pop_back();
+            _metrics.evictions++;
+        }
+    }
+
+    mutable std::mutex _mutex;
+    size_t             _capacity;
+    cache_metrics      _metrics{};
+
+    list_type                                    _items;
+    std::map<Key, typename list_type::iterator> _index;
+};
+} // namespace svn
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <cpp/types.hpp>
+
+// Set operations on sorted lists of `(start, end]` revision ranges, the same
+// semantics as `svn_rangelist_*` but on plain vectors so they can be cached
+// and evaluated without an apr pool.
+namespace svn::rangelist {
+// Sorts the ranges and merges overlapping or adjacent ones. Where ranges of
+// different inheritability overlap, the overlap is inheritable, the same as
+// `svn_rangelist_merge2`, so the result is always sorted and disjoint.
+static std::vector<merge_range> normalize(std::vector<merge_range> value) {
+    // +1 where a range starts and -1 where it ends, per inheritability
+    struct edge {
+        int32_t revision;
+        int32_t delta;
+        bool    inheritable;
+    };
+
+    std::vector<edge> edges;
+    edges.reserve(value.size() * 2);
+    for (auto& range : value) {
+        if (range.start >= range.end) {
+            continue;
+        }
+
+        edges.push_back(edge{range.start, 1, range.inheritable});
+        edges.push_back(edge{range.end, -1, range.inheritable});
+    }
+
+    std::sort(edges.begin(), edges.end(), [](const edge& left, const edge& right) -> bool {
+        return left.revision < right.revision;
+    });
+
+    std::vector<merge_range> result;
+
+    int32_t inheritable     = 0;
+    int32_t non_inheritable = 0;
+    for (size_t i = 0; i < edges.size();) {
+        auto revision = edges[i].revision;
+        for (; i < edges.size() && edges[i].revision == revision; i++) {
+            (edges[i].inheritable ? inheritable : non_inheritable) += edges[i].delta;
+        }
+
+        if (i == edges.size() || (inheritable == 0 && non_inheritable == 0)) {
+            continue;
+        }
+
+        merge_range range{revision, edges[i].revision, inheritable != 0};
+        if (!result.empty() && result.back().end == range.start && result.back().inheritable == range.inheritable) {
+            result.back().end = range.end;
+        } else {
+            result.push_back(range);
+        }
+    }
+    return result;
+}
+
+static std::vector<merge_range> intersect(const std::vector<merge_range>& left,
+                                          const std::vector<merge_range>& right) {
+    std::vector<merge_range> result;
+
+    auto i = left.begin();
+    auto j = right.begin();
+    while (i != left.end() && j != right.end()) {
+        auto start = std::max(i->start, j->start);
+        auto end   = std::min(i->end, j->end);
+        if (start < end) {
+            result.push_back(merge_range{start, end, i->inheritable && j->inheritable});
+        }
+
+        if (i->end < j->end) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+
+    return result;
+}
+
+// Returns the part of `whiteboard` that is not covered by `eraser`.
+static std::vector<merge_range> remove(const std::vector<merge_range>& eraser,
+                                       const std::vector<merge_range>& whiteboard) {
+    std::vector<merge_range> result;
+
+    auto j = eraser.begin();
+    for (auto range : whiteboard) {
+        while (j != eraser.end() && j->end <= range.start) {
+            j++;
+        }
+
+        auto k = j;
+        while (k != eraser.end() && k->start < range.end) {
+            if (k->start > range.start) {
+                result.push_back(merge_range{range.start, k->start, range.inheritable});
+            }
+            range.start = std::max(range.start, k->end);
+            k++;
+        }
+
+        if (range.start < range.end) {
+            result.push_back(range);
+        }
+    }
+
+    return result;
+}
+
+static const merge_range* find(const std::vector<merge_range>& value, int32_t revision) {
+    auto range = std::upper_bound(value.begin(), value.end(), revision, [](int32_t revision, const merge_range& range) -> bool {
+        return revision <= range.end;
+    });
+
+    if (range != value.end() && range->start < revision) {
+        return &*range;
+    }
+
+    return nullptr;
+}
+} // namespace svn::rangelist
@@ -0,0 +1,1522 @@
+#include "repos.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <apr_errno.h>
+#include <apr_general.h>
+#include <apr_hash.h>
+#include <apr_pools.h>
+
+#include <svn_cache_config.h>
+#include <svn_dirent_uri.h>
+#include <svn_fs.h>
+#include <svn_hash.h>
+#include <svn_io.h>
+#include <svn_props.h>
+#include <svn_repos.h>
+#include <svn_string.h>
+
+#include <private/svn_fs_fs_private.h>
+#include <private/svn_fspath.h>
+#include <private/svn_repos_private.h>
+
+#include "type_conversion.hpp"
+
+namespace svn {
+struct root_pool {
+    root_pool()
+        : _pool(create()) {
+    }
+
+    operator apr_pool_t*() const {
+        return _pool;
+    }
+
+    ~root_pool() {
+        apr_pool_destroy(_pool);
+    }
+
+  private:
+    static apr_pool_t* create() {
+        apr_pool_t* result;
+        check_result(apr_pool_create_ex(&result, nullptr, nullptr, nullptr));
+        return result;
+    }
+
+    apr_pool_t* const _pool;
+};
+
+// libsvn_fs sets up its shared state the first time it's used, which isn't
+// safe to race on from the worker threads.
+static void initialize() {
+    static std::once_flag flag;
+    std::call_once(flag, []() -> void {
+        check_result(apr_initialize());
+
+        // every open handle shares the same fs caches, only takes effect if
+        // no repository was accessed (e.g. over ra_local) before
+        auto settings            = *svn_cache_config_get();
+        settings.cache_size      = std::max<apr_uint64_t>(settings.cache_size, 128 * 1024 * 1024);
+        settings.single_threaded = false;
+        svn_cache_config_set(&settings);
+
+        // lives as long as the process
+        apr_pool_t* pool;
+        check_result(apr_pool_create_ex(&pool, nullptr, nullptr, nullptr));
+        check_result(svn_fs_initialize(pool));
+    });
+}
+
+// Repository paths are accepted with or without a leading slash.
+static const char* convert_from_fspath(const std::string& value, apr_pool_t* pool) {
+    if (value.find('\0') != std::string::npos) {
+        throw svn_type_error("");
+    }
+
+    return svn_fspath__canonicalize(value.c_str(), pool);
+}
+
+static svn_revnum_t resolve_revision(svn_fs_t* fs, int32_t revision, apr_pool_t* pool) {
+    if (revision >= 0) {
+        return revision;
+    }
+
+    svn_revnum_t youngest;
+    check_result(svn_fs_youngest_rev(&youngest, fs, pool));
+    return youngest;
+}
+
+static svn_fs_root_t* get_revision_root(svn_fs_t* fs, int32_t revision, apr_pool_t* pool) {
+    svn_fs_root_t* root;
+    check_result(svn_fs_revision_root(&root, fs, resolve_revision(fs, revision, pool), pool));
+    return root;
+}
+
+// Newly created repositories only have revision 0, in the first shard
+// whatever its size, so the layout can still be changed.
+static void set_shard_size(const char* db_path, int32_t shard_size, apr_pool_t* pool) {
+    auto path = svn_dirent_join(db_path, "format", pool);
+
+    svn_stringbuf_t* content;
+    check_result(svn_stringbuf_from_file2(&content, path, pool));
+
+    std::string format(content->data, content->len);
+
+    const std::string layout = "layout sharded ";
+    auto              start  = format.find(layout);
+    if (start == std::string::npos) {
+        check_result(svn_error_create(SVN_ERR_UNSUPPORTED_FEATURE,
+                                      nullptr,
+                                      "This repository format doesn't support sharding"));
+    }
+
+    start += layout.size();
+    format.replace(start, format.find('\n', start) - start, std::to_string(shard_size));
+
+    check_result(svn_io_set_file_read_write(path, false, pool));
+    check_result(svn_io_write_atomic2(path, format.data(), format.size(), nullptr, true, pool));
+    check_result(svn_io_set_file_read_only(path, false, pool));
+}
+
+static void set_compression(const char* db_path, const std::string& fs_type, const std::string& compression, apr_pool_t* pool) {
+    auto path = svn_dirent_join(db_path, fs_type == SVN_FS_TYPE_FSX ? "fsx.conf" : "fsfs.conf", pool);
+
+    // the file only has commented out defaults, a repeated section merges
+    // with the previous one
+    auto section = "\n[deltification]\ncompression = " + compression + "\n";
+
+    apr_file_t* file;
+    check_result(svn_io_file_open(&file, path, APR_WRITE | APR_APPEND, APR_OS_DEFAULT, pool));
+    check_result(svn_io_file_write_full(file, section.data(), section.size(), nullptr, pool));
+    check_result(svn_io_file_close(file, pool));
+}
+
+void repos::create(const std::string& path, const repos_create_options& options) {
+    if (options.fs_type != SVN_FS_TYPE_FSFS && options.fs_type != SVN_FS_TYPE_FSX) {
+        throw svn_type_error("fs_type must be fsfs or fsx");
+    }
+
+    if (options.compression && *options.compression != "lz4" && *options.compression != "zlib" && *options.compression != "none") {
+        throw svn_type_error("compression must be lz4, zlib or none");
+    }
+
+    if (options.shard_size && *options.shard_size <= 0) {
+        throw svn_type_error("shard_size must be positive");
+    }
+
+    initialize();
+
+    root_pool pool;
+
+    auto raw_path = convert_from_path(path, pool);
+
+    auto fs_config = apr_hash_make(pool);
+    svn_hash_sets(fs_config, SVN_FS_CONFIG_FS_TYPE, options.fs_type.c_str());
+    if (options.compatible_version) {
+        svn_hash_sets(fs_config, SVN_FS_CONFIG_COMPATIBLE_VERSION, convert_from_string(*options.compatible_version));
+    }
+
+    svn_repos_t* repos;
+    check_result(svn_repos_create(&repos, raw_path, nullptr, nullptr, nullptr, fs_config, pool));
+
+    try {
+        auto db_path = svn_repos_db_env(repos, pool);
+
+        if (options.shard_size) {
+            set_shard_size(db_path, *options.shard_size, pool);
+        }
+
+        if (options.compression) {
+            set_compression(db_path, options.fs_type, *options.compression, pool);
+        }
+
+        // the backend reads its configuration when opening, e.g. lz4 is
+        // rejected when the compatible version predates it
+        root_pool scratch_pool;
+        check_result(svn_repos_open3(&repos, raw_path, nullptr, scratch_pool, scratch_pool));
+    } catch (...) {
+        // don't leave a repository with only some of the options behind
+        svn_error_clear(svn_repos_delete(raw_path, pool));
+        throw;
+    }
+}
+
+// Shared by the notify and cancel functions of long running operations.
+// libsvn_repos can't be unwound through, so a throwing callback is recorded
+// and turned into a cancellation the next time libsvn_repos checks for one.
+struct operation_baton {
+    std::function<void(const svn_repos_notify_t&)> notify;
+    const repos::abort_function&                   abort;
+    std::exception_ptr                             exception;
+};
+
+static void invoke_operation_notify(void* raw_baton, const svn_repos_notify_t* notify, apr_pool_t* pool) {
+    auto baton = static_cast<operation_baton*>(raw_baton);
+    if (baton->exception || !baton->notify) {
+        return;
+    }
+
+    try {
+        baton->notify(*notify);
+    } catch (...) {
+        baton->exception = std::current_exception();
+    }
+}
+
+static svn_error_t* invoke_operation_cancel(void* raw_baton) {
+    auto baton = static_cast<operation_baton*>(raw_baton);
+    if (baton->exception || (baton->abort && baton->abort())) {
+        return svn_error_create(SVN_ERR_CANCELLED, nullptr, nullptr);
+    }
+    return nullptr;
+}
+
+static void check_operation(svn_error_t* error, const operation_baton& baton) {
+    if (baton.exception) {
+        svn_error_clear(error);
+        std::rethrow_exception(baton.exception);
+    }
+
+    check_result(error);
+}
+
+// Where FSFS and FSX keep revision files, `shard_size` is zero for the
+// linear layout.
+struct revs_layout {
+    int32_t shard_size;
+    int32_t min_unpacked_rev;
+};
+
+static revs_layout read_revs_layout(const char* db_path, apr_pool_t* pool) {
+    revs_layout result{0, 0};
+
+    svn_stringbuf_t* content;
+    check_result(svn_stringbuf_from_file2(&content, svn_dirent_join(db_path, "format", pool), pool));
+
+    const char* layout = "layout sharded ";
+    if (auto start = std::strstr(content->data, layout)) {
+        result.shard_size = std::atoi(start + std::strlen(layout));
+    }
+
+    // only exists once the format supports packing
+    auto error = svn_stringbuf_from_file2(&content, svn_dirent_join(db_path, "min-unpacked-rev", pool), pool);
+    if (error != nullptr && APR_STATUS_IS_ENOENT(error->apr_err)) {
+        svn_error_clear(error);
+        return result;
+    }
+    check_result(error);
+
+    result.min_unpacked_rev = std::atoi(content->data);
+    return result;
+}
+
+static int64_t get_file_size(const char* path, apr_pool_t* pool) {
+    apr_finfo_t info;
+    auto        error = svn_io_stat(&info, path, APR_FINFO_SIZE, pool);
+    if (error != nullptr && APR_STATUS_IS_ENOENT(error->apr_err)) {
+        svn_error_clear(error);
+        return 0;
+    }
+    check_result(error);
+
+    return info.size;
+}
+
+// The size of the revision files holding `start` to `end`, a packed shard
+// is always counted as a whole.
+static int64_t get_revisions_size(const char* db_path, const revs_layout& layout, svn_revnum_t start, svn_revnum_t end, apr_pool_t* pool) {
+    auto revs_path = svn_dirent_join(db_path, "revs", pool);
+
+    if (layout.shard_size == 0) {
+        int64_t result = 0;
+        for (auto revision = start; revision <= end; revision++) {
+            result += get_file_size(svn_dirent_join(revs_path, std::to_string(revision).c_str(), pool), pool);
+        }
+        return result;
+    }
+
+    if (start < layout.min_unpacked_rev) {
+        auto shard = std::to_string(start / layout.shard_size) + ".pack";
+        return get_file_size(svn_dirent_join_many(pool, revs_path, shard.c_str(), "pack", nullptr), pool);
+    }
+
+    int64_t result = 0;
+    for (auto revision = start; revision <= end; revision++) {
+        auto shard = std::to_string(revision / layout.shard_size);
+        result += get_file_size(svn_dirent_join_many(pool, revs_path, shard.c_str(), std::to_string(revision).c_str(), nullptr), pool);
+    }
+    return result;
+}
+
+// Holds back the caller so that on average no more than `limit` bytes are
+// reported per second. Sleeps in short steps to notice aborts.
+//
+// The sleeping thread is usually one of the libuv pool, a throttled hotcopy
+// keeps it from running other work until it's done.
+class throttle {
+  public:
+    throttle(int64_t limit, const repos::abort_function& abort)
+        : _limit(limit)
+        , _abort(abort)
+        , _start(std::chrono::steady_clock::now())
+        , _total(0) {
+    }
+
+    void consume(int64_t bytes) {
+        _total += bytes;
+
+        auto due = _start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                std::chrono::duration<double>(static_cast<double>(_total) / _limit));
+
+        while (true) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= due || (_abort && _abort())) {
+                return;
+            }
+
+            std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(due - now, std::chrono::milliseconds(100)));
+        }
+    }
+
+  private:
+    const int64_t                               _limit;
+    const repos::abort_function&                _abort;
+    const std::chrono::steady_clock::time_point _start;
+    int64_t                                     _total;
+};
+
+void repos::hotcopy(const std::string&           source,
+                    const std::string&           destination,
+                    const repos_hotcopy_options& options,
+                    const hotcopy_callback&      callback,
+                    const abort_function&        abort) {
+    if (options.rate_limit_bytes_per_sec < 0) {
+        throw svn_type_error("rate_limit_bytes_per_sec must not be negative");
+    }
+
+    initialize();
+
+    root_pool pool;
+
+    auto raw_source      = convert_from_path(source, pool);
+    auto raw_destination = convert_from_path(destination, pool);
+
+    auto db_path = svn_dirent_join(raw_source, "db", pool);
+    auto layout  = read_revs_layout(db_path, pool);
+
+    throttle limiter(options.rate_limit_bytes_per_sec, abort);
+
+    apr_pool_t* iteration_pool;
+    check_result(apr_pool_create_ex(&iteration_pool, pool, nullptr, nullptr));
+
+    auto notify = [&](const svn_repos_notify_t& info) -> void {
+        if (info.action != svn_repos_notify_hotcopy_rev_range) {
+            return;
+        }
+
+        apr_pool_clear(iteration_pool);
+
+        repos_hotcopy_progress item{static_cast<int32_t>(info.start_revision),
+                                    static_cast<int32_t>(info.end_revision),
+                                    get_revisions_size(db_path, layout, info.start_revision, info.end_revision, iteration_pool)};
+
+        if (options.rate_limit_bytes_per_sec != 0) {
+            limiter.consume(item.bytes);
+        }
+
+        callback(item);
+    };
+
+    operation_baton baton{notify, abort, nullptr};
+
+    // an incremental hotcopy with nothing to copy never checks
+    check_result(invoke_operation_cancel(&baton));
+
+    auto error = svn_repos_hotcopy3(raw_source,
+                                    raw_destination,
+                                    options.clean_logs,
+                                    options.incremental,
+                                    invoke_operation_notify,
+                                    &baton,
+                                    invoke_operation_cancel,
+                                    &baton,
+                                    pool);
+    check_operation(error, baton);
+}
+
+// Counts the shards packed so far to stop once there are enough of them,
+// which looks like a cancellation to libsvn_repos.
+struct pack_baton : operation_baton {
+    int32_t remaining_shards;
+};
+
+static svn_error_t* invoke_pack_cancel(void* raw_baton) {
+    auto baton = static_cast<pack_baton*>(raw_baton);
+    if (baton->remaining_shards == 0) {
+        return svn_error_create(SVN_ERR_CANCELLED, nullptr, nullptr);
+    }
+    return invoke_operation_cancel(static_cast<operation_baton*>(baton));
+}
+
+void repos::pack(const std::string&        path,
+                 const repos_pack_options& options,
+                 const pack_callback&      callback,
+                 const abort_function&     abort) {
+    if (options.shards_per_run < 0) {
+        throw svn_type_error("shards_per_run must not be negative");
+    }
+
+    initialize();
+
+    root_pool pool;
+
+    svn_repos_t* repos;
+    check_result(svn_repos_open3(&repos, convert_from_path(path, pool), nullptr, pool, pool));
+
+    pack_baton baton{{nullptr, abort, nullptr}, options.shards_per_run == 0 ? -1 : options.shards_per_run};
+
+    baton.notify = [&baton, &callback](const svn_repos_notify_t& info) -> void {
+        repos_pack_progress item{nullptr, info.shard};
+
+        switch (info.action) {
+            case svn_repos_notify_pack_shard_start:
+                item.action = "start";
+                break;
+            case svn_repos_notify_pack_shard_end:
+                item.action = "end";
+                if (baton.remaining_shards > 0) {
+                    baton.remaining_shards--;
+                }
+                break;
+            case svn_repos_notify_pack_shard_start_revprop:
+                item.action = "start_revprop";
+                break;
+            case svn_repos_notify_pack_shard_end_revprop:
+                item.action = "end_revprop";
+                break;
+            default:
+                return;
+        }
+
+        callback(item);
+    };
+
+    auto operation = static_cast<operation_baton*>(&baton);
+    check_result(invoke_operation_cancel(operation));
+
+    auto error = svn_repos_fs_pack2(repos, invoke_operation_notify, operation, invoke_pack_cancel, &baton, pool);
+
+    // a run that stopped after `shards_per_run` shards succeeded
+    if (error != nullptr && error->apr_err == SVN_ERR_CANCELLED && baton.remaining_shards == 0 && !baton.exception) {
+        svn_error_clear(error);
+        return;
+    }
+
+    check_operation(error, baton);
+}
+
+static repos_representation_stats convert_representation_stats(const svn_fs_fs__representation_stats_t& raw) {
+    return repos_representation_stats{raw.total.count,
+                                      raw.total.packed_size,
+                                      raw.total.expanded_size,
+                                      raw.references,
+                                      raw.total.count != 0 ? static_cast<double>(raw.chain_len) / raw.total.count : 0};
+}
+
+static std::vector<repos_histogram_line> convert_histogram(const svn_fs_fs__histogram_t& raw) {
+    std::vector<repos_histogram_line> result;
+    for (auto& line : raw.lines) {
+        result.push_back({line.count, line.sum});
+    }
+
+    while (!result.empty() && result.back().count == 0) {
+        result.pop_back();
+    }
+    return result;
+}
+
+static repos_layout_stats convert_layout_stats(const svn_fs_fs__stats_t& raw, apr_pool_t* pool) {
+    repos_layout_stats result;
+    result.total_size     = raw.total_size;
+    result.revision_count = raw.revision_count;
+    result.change_count   = raw.change_count;
+
+    result.file_count = raw.file_node_stats.count;
+    result.dir_count  = raw.dir_node_stats.count;
+
+    result.file_representations      = convert_representation_stats(raw.file_rep_stats);
+    result.dir_representations       = convert_representation_stats(raw.dir_rep_stats);
+    result.file_prop_representations = convert_representation_stats(raw.file_prop_rep_stats);
+    result.dir_prop_representations  = convert_representation_stats(raw.dir_prop_rep_stats);
+
+    result.representation_sizes = convert_histogram(raw.rep_size_histogram);
+    result.node_sizes           = convert_histogram(raw.node_size_histogram);
+
+    if (raw.largest_changes != nullptr) {
+        for (apr_size_t i = 0; i < raw.largest_changes->count; i++) {
+            auto change = raw.largest_changes->changes[i];
+            if (change->path == nullptr || change->path->len == 0) {
+                continue;
+            }
+
+            result.largest_changes.push_back({std::string(change->path->data, change->path->len),
+                                              static_cast<int32_t>(change->revision),
+                                              change->size});
+        }
+
+        std::sort(result.largest_changes.begin(), result.largest_changes.end(), [](const repos_large_change& left, const repos_large_change& right) -> bool {
+            return left.size > right.size;
+        });
+    }
+
+    for (auto index = apr_hash_first(pool, raw.by_extension); index; index = apr_hash_next(index)) {
+        auto info = static_cast<const svn_fs_fs__extension_info_t*>(apr_hash_this_val(index));
+        result.extensions.push_back({info->extension,
+                                     info->node_histogram.total.count,
+                                     info->node_histogram.total.sum,
+                                     info->rep_histogram.total.count,
+                                     info->rep_histogram.total.sum});
+    }
+
+    std::sort(result.extensions.begin(), result.extensions.end(), [](const repos_extension_stats& left, const repos_extension_stats& right) -> bool {
+        return left.representation_size > right.representation_size;
+    });
+
+    return result;
+}
+
+struct stats_baton : operation_baton {
+    const repos::stats_callback& callback;
+};
+
+static void invoke_stats_progress(svn_revnum_t revision, void* raw_baton, apr_pool_t* pool) {
+    auto baton = static_cast<stats_baton*>(raw_baton);
+    if (baton->exception || !baton->callback) {
+        return;
+    }
+
+    try {
+        baton->callback(static_cast<int32_t>(revision));
+    } catch (...) {
+        baton->exception = std::current_exception();
+    }
+}
+
+repos_stats repos::stats(const std::string&         path,
+                         const repos_stats_options& options,
+                         const stats_callback&      callback,
+                         const abort_function&      abort) {
+    initialize();
+
+    root_pool pool;
+
+    svn_repos_t* repos;
+    check_result(svn_repos_open3(&repos, convert_from_path(path, pool), nullptr, pool, pool));
+
+    auto fs = svn_repos_fs(repos);
+
+    repos_stats result{0, 0, 0, 0};
+
+    svn_revnum_t youngest;
+    check_result(svn_fs_youngest_rev(&youngest, fs, pool));
+    result.youngest = static_cast<int32_t>(youngest);
+
+    const svn_fs_info_placeholder_t* info;
+    check_result(svn_fs_info(&info, fs, pool, pool));
+
+    if (std::strcmp(info->fs_type, SVN_FS_TYPE_FSFS) == 0) {
+        auto fsfs_info          = reinterpret_cast<const svn_fs_fsfs_info_t*>(info);
+        result.shard_size       = fsfs_info->shard_size;
+        result.min_unpacked_rev = static_cast<int32_t>(fsfs_info->min_unpacked_rev);
+    } else if (std::strcmp(info->fs_type, SVN_FS_TYPE_FSX) == 0) {
+        auto fsx_info           = reinterpret_cast<const svn_fs_fsx_info_t*>(info);
+        result.shard_size       = fsx_info->shard_size;
+        result.min_unpacked_rev = static_cast<int32_t>(fsx_info->min_unpacked_rev);
+    }
+
+    // the youngest shard can't be packed until it's complete
+    if (result.shard_size != 0) {
+        result.unpacked_shards = (result.youngest + 1) / result.shard_size - result.min_unpacked_rev / result.shard_size;
+    }
+
+    if (!options.detailed) {
+        return result;
+    }
+
+    if (std::strcmp(info->fs_type, SVN_FS_TYPE_FSFS) != 0) {
+        check_result(svn_error_create(SVN_ERR_UNSUPPORTED_FEATURE, nullptr, "Detailed statistics are only available for FSFS"));
+    }
+
+    stats_baton baton{{nullptr, abort, nullptr}, callback};
+
+    auto operation = static_cast<operation_baton*>(&baton);
+    check_result(invoke_operation_cancel(operation));
+
+    svn_fs_fs__stats_t* stats;
+    auto                error = svn_fs_fs__get_stats(&stats, fs, invoke_stats_progress, &baton, invoke_operation_cancel, operation, pool, pool);
+    check_operation(error, baton);
+
+    result.layout = convert_layout_stats(*stats, pool);
+
+    return result;
+}
+
+// Splits `start` to `end` into at most `count` contiguous ranges of about
+// the same size.
+static std::vector<std::pair<svn_revnum_t, svn_revnum_t>> split_revisions(svn_revnum_t start, svn_revnum_t end, int32_t count) {
+    auto total      = end - start + 1;
+    auto chunk_size = (total + count - 1) / count;
+
+    std::vector<std::pair<svn_revnum_t, svn_revnum_t>> result;
+    for (auto chunk_start = start; chunk_start <= end; chunk_start += chunk_size) {
+        result.emplace_back(chunk_start, std::min(chunk_start + chunk_size - 1, end));
+    }
+    return result;
+}
+
+// Rethrows what made one of the threads fail, in favor of the cancellations
+// it caused in the others.
+static void rethrow_first_failure(const std::vector<std::exception_ptr>& exceptions, const repos::abort_function& abort) {
+    for (auto& exception : exceptions) {
+        if (!exception) {
+            continue;
+        }
+
+        try {
+            std::rethrow_exception(exception);
+        } catch (const svn_error& error) {
+            if (error.code != SVN_ERR_CANCELLED || (abort && abort())) {
+                throw;
+            }
+        }
+    }
+
+    for (auto& exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+struct verify_baton : operation_baton {
+    const repos::verify_callback& callback;
+    std::mutex&                   callback_mutex;
+    bool                          corrupted;
+};
+
+static svn_error_t* invoke_verify(void* raw_baton, svn_revnum_t revision, svn_error_t* verify_error, apr_pool_t* pool) {
+    auto baton = static_cast<verify_baton*>(raw_baton);
+    if (baton->exception) {
+        return svn_error_create(SVN_ERR_CANCELLED, nullptr, nullptr);
+    }
+
+    baton->corrupted = true;
+
+    try {
+        repos_verify_result item{static_cast<int32_t>(revision), copy_error(*svn_error_purge_tracing(verify_error))};
+
+        std::lock_guard<std::mutex> lock(baton->callback_mutex);
+        baton->callback(item);
+    } catch (...) {
+        baton->exception = std::current_exception();
+    }
+
+    // keep going with the next revision
+    return nullptr;
+}
+
+void repos::verify(const std::string&          path,
+                   const repos_verify_options& options,
+                   const verify_callback&      callback,
+                   const abort_function&       abort) {
+    if (options.start < 0) {
+        throw svn_type_error("start must not be negative");
+    }
+
+    if (options.parallelism <= 0) {
+        throw svn_type_error("parallelism must be positive");
+    }
+
+    initialize();
+
+    root_pool pool;
+
+    auto raw_path = convert_from_path(path, pool);
+
+    svn_repos_t* repos;
+    check_result(svn_repos_open3(&repos, raw_path, nullptr, pool, pool));
+
+    auto start = static_cast<svn_revnum_t>(options.start);
+    auto end   = resolve_revision(svn_repos_fs(repos), options.end, pool);
+    if (start > end) {
+        throw svn_type_error("start must not be after end");
+    }
+
+    // the backend's metadata is only checked once, by the first chunk
+    auto chunks = split_revisions(start, end, options.metadata_only ? 1 : options.parallelism);
+
+    std::mutex callback_mutex;
+
+    // stops the other chunks when one of them fails
+    std::atomic<bool>     failed(false);
+    repos::abort_function chunk_abort = [&abort, &failed]() -> bool {
+        return failed.load() || (abort && abort());
+    };
+
+    auto verify_chunk = [&](svn_revnum_t chunk_start, svn_revnum_t chunk_end, svn_repos_t* chunk_repos, apr_pool_t* chunk_pool) -> void {
+        verify_baton baton{{nullptr, chunk_abort, nullptr}, callback, callback_mutex, false};
+
+        baton.notify = [&baton](const svn_repos_notify_t& info) -> void {
+            if (info.action != svn_repos_notify_verify_rev_end) {
+                return;
+            }
+
+            repos_verify_result item{static_cast<int32_t>(info.revision), {}};
+
+            std::lock_guard<std::mutex> lock(baton.callback_mutex);
+            baton.callback(item);
+        };
+
+        auto operation = static_cast<operation_baton*>(&baton);
+        check_result(invoke_operation_cancel(operation));
+
+        auto error = svn_repos_verify_fs3(chunk_repos,
+                                          chunk_start,
+                                          chunk_end,
+                                          options.check_normalization,
+                                          options.metadata_only,
+                                          invoke_operation_notify,
+                                          operation,
+                                          invoke_verify,
+                                          &baton,
+                                          invoke_operation_cancel,
+                                          operation,
+                                          chunk_pool);
+
+        // corrupted revisions have all been reported
+        if (error != nullptr && baton.corrupted && error->apr_err != SVN_ERR_CANCELLED && !baton.exception) {
+            svn_error_clear(error);
+            return;
+        }
+
+        check_operation(error, baton);
+    };
+
+    if (chunks.size() == 1) {
+        verify_chunk(start, end, repos, pool);
+        return;
+    }
+
+    std::vector<std::thread>        threads;
+    std::vector<std::exception_ptr> exceptions(chunks.size());
+    for (size_t index = 0; index < chunks.size(); index++) {
+        auto chunk_start = chunks[index].first;
+        auto chunk_end   = chunks[index].second;
+
+        threads.emplace_back([&, index, chunk_start, chunk_end]() -> void {
+            try {
+                // a filesystem can't be shared between threads
+                root_pool    chunk_pool;
+                svn_repos_t* chunk_repos;
+                check_result(svn_repos_open3(&chunk_repos, raw_path, nullptr, chunk_pool, chunk_pool));
+
+                verify_chunk(chunk_start, chunk_end, chunk_repos, chunk_pool);
+            } catch (...) {
+                exceptions[index] = std::current_exception();
+                failed.store(true);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    rethrow_first_failure(exceptions, abort);
+}
+
+// Collects what libsvn_repos writes and hands it to `callback` in chunks.
+struct chunked_stream_baton {
+    const repos::dump_callback& callback;
+    std::exception_ptr&         exception;
+    std::vector<char>           buffer;
+};
+
+static const size_t dump_chunk_size = 64 * 1024;
+
+static svn_error_t* flush_chunked_stream(void* raw_baton) {
+    auto baton = static_cast<chunked_stream_baton*>(raw_baton);
+    if (baton->buffer.empty()) {
+        return nullptr;
+    }
+
+    try {
+        baton->callback(baton->buffer);
+        baton->buffer.clear();
+        baton->buffer.reserve(dump_chunk_size);
+        return nullptr;
+    } catch (...) {
+        baton->exception = std::current_exception();
+        return svn_error_create(SVN_ERR_CANCELLED, nullptr, nullptr);
+    }
+}
+
+static svn_error_t* invoke_chunked_write(void* raw_baton, const char* data, apr_size_t* length) {
+    auto baton = static_cast<chunked_stream_baton*>(raw_baton);
+    baton->buffer.insert(baton->buffer.end(), data, data + *length);
+
+    if (baton->buffer.size() >= dump_chunk_size) {
+        return flush_chunked_stream(raw_baton);
+    }
+    return nullptr;
+}
+
+static void dump_revisions(svn_repos_t*     repos,
+                           svn_stream_t*    stream,
+                           svn_revnum_t     start,
+                           svn_revnum_t     end,
+                           bool             incremental,
+                           bool             deltas,
+                           operation_baton& baton,
+                           apr_pool_t*      pool) {
+    check_result(invoke_operation_cancel(&baton));
+
+    auto error = svn_repos_dump_fs4(repos,
+                                    stream,
+                                    start,
+                                    end,
+                                    incremental,
+                                    deltas,
+                                    true,
+                                    true,
+                                    nullptr,
+                                    nullptr,
+                                    nullptr,
+                                    nullptr,
+                                    invoke_operation_cancel,
+                                    &baton,
+                                    pool);
+    if (error == nullptr) {
+        error = svn_stream_close(stream);
+    }
+
+    check_operation(error, baton);
+}
+
+static std::pair<svn_revnum_t, svn_revnum_t> resolve_dump_range(svn_repos_t* repos, const repos_dump_options& options, apr_pool_t* pool) {
+    if (options.start < 0) {
+        throw svn_type_error("start must not be negative");
+    }
+
+    auto end = resolve_revision(svn_repos_fs(repos), options.end, pool);
+    if (options.start > end) {
+        throw svn_type_error("start must not be after end");
+    }
+
+    return {options.start, end};
+}
+
+void repos::dump(const std::string&        path,
+                 const repos_dump_options& options,
+                 const dump_callback&      callback,
+                 const abort_function&     abort) {
+    initialize();
+
+    root_pool pool;
+
+    svn_repos_t* repos;
+    check_result(svn_repos_open3(&repos, convert_from_path(path, pool), nullptr, pool, pool));
+
+    auto range = resolve_dump_range(repos, options, pool);
+
+    operation_baton      baton{nullptr, abort, nullptr};
+    chunked_stream_baton stream_baton{callback, baton.exception, {}};
+    stream_baton.buffer.reserve(dump_chunk_size);
+
+    auto stream = svn_stream_create(&stream_baton, pool);
+    svn_stream_set_write(stream, invoke_chunked_write);
+    svn_stream_set_close(stream, flush_chunked_stream);
+
+    dump_revisions(repos, stream, range.first, range.second, options.incremental, options.deltas, baton, pool);
+}
+
+std::vector<repos_dump_range> repos::dump_parallel(const std::string&              path,
+                                                   const std::vector<std::string>& files,
+                                                   const repos_dump_options&       options,
+                                                   const abort_function&           abort) {
+    if (files.empty()) {
+        throw svn_type_error("files must not be empty");
+    }
+
+    initialize();
+
+    root_pool pool;
+
+    auto raw_path = convert_from_path(path, pool);
+
+    svn_repos_t* repos;
+    check_result(svn_repos_open3(&repos, raw_path, nullptr, pool, pool));
+
+    auto range  = resolve_dump_range(repos, options, pool);
+    auto chunks = split_revisions(range.first, range.second, static_cast<int32_t>(files.size()));
+
+    std::vector<repos_dump_range> result;
+    for (size_t index = 0; index < chunks.size(); index++) {
+        result.push_back({files[index], static_cast<int32_t>(chunks[index].first), static_cast<int32_t>(chunks[index].second)});
+    }
+
+    // stops the other ranges when one of them fails
+    std::atomic<bool>     failed(false);
+    repos::abort_function chunk_abort = [&abort, &failed]() -> bool {
+        return failed.load() || (abort && abort());
+    };
+
+    std::vector<std::thread>        threads;
+    std::vector<std::exception_ptr> exceptions(chunks.size());
+    for (size_t index = 0; index < chunks.size(); index++) {
+        threads.emplace_back([&, index]() -> void {
+            try {
+                root_pool chunk_pool;
+
+                // a filesystem can't be shared between threads
+                svn_repos_t* chunk_repos;
+                check_result(svn_repos_open3(&chunk_repos, raw_path, nullptr, chunk_pool, chunk_pool));
+
+                svn_stream_t* stream;
+                check_result(svn_stream_open_writable(&stream, convert_from_path(files[index], chunk_pool), chunk_pool, chunk_pool));
+
+                operation_baton baton{nullptr, chunk_abort, nullptr};
+                dump_revisions(chunk_repos,
+                               stream,
+                               chunks[index].first,
+                               chunks[index].second,
+                               index == 0 ? options.incremental : true,
+                               options.deltas,
+                               baton,
+                               chunk_pool);
+            } catch (...) {
+                exceptions[index] = std::current_exception();
+                failed.store(true);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    rethrow_first_failure(exceptions, abort);
+
+    return result;
+}
+
+// Pulls the dump file from `read` one chunk at a time.
+struct pull_stream_baton {
+    const repos::read_function& read;
+    std::exception_ptr&         exception;
+    std::vector<char>           chunk;
+    size_t                      offset;
+    bool                        eof;
+};
+
+static svn_error_t* read_pull_stream(pull_stream_baton* baton, char* buffer, apr_size_t* length, bool full) {
+    apr_size_t copied = 0;
+    while (copied < *length) {
+        if (baton->offset == baton->chunk.size()) {
+            // a partial read returns what is at hand
+            if (baton->eof || (copied != 0 && !full)) {
+                break;
+            }
+
+            try {
+                baton->chunk.clear();
+                baton->offset = 0;
+                baton->eof    = !baton->read(baton->chunk);
+            } catch (...) {
+                baton->exception = std::current_exception();
+                return svn_error_create(SVN_ERR_CANCELLED, nullptr, nullptr);
+            }
+            continue;
+        }
+
+        auto count = std::min(*length - copied, baton->chunk.size() - baton->offset);
+        std::memcpy(buffer + copied, baton->chunk.data() + baton->offset, count);
+        copied += count;
+        baton->offset += count;
+    }
+
+    *length = copied;
+    return nullptr;
+}
+
+static svn_error_t* invoke_pull_read(void* raw_baton, char* buffer, apr_size_t* length) {
+    return read_pull_stream(static_cast<pull_stream_baton*>(raw_baton), buffer, length, false);
+}
+
+static svn_error_t* invoke_pull_read_full(void* raw_baton, char* buffer, apr_size_t* length) {
+    return read_pull_stream(static_cast<pull_stream_baton*>(raw_baton), buffer, length, true);
+}
+
+static svn_repos_load_uuid convert_from_uuid_action(const std::string& value) {
+    if (value == "default") {
+        return svn_repos_load_uuid_default;
+    }
+
+    if (value == "ignore") {
+        return svn_repos_load_uuid_ignore;
+    }
+
+    if (value == "force") {
+        return svn_repos_load_uuid_force;
+    }
+
+    throw svn_type_error("uuid_action must be default, ignore or force");
+}
+
+void repos::load(const std::string&        path,
+                 const read_function&      read,
+                 const repos_load_options& options,
+                 const load_callback&      callback,
+                 const abort_function&     abort) {
+    auto uuid_action = convert_from_uuid_action(options.uuid_action);
+
+    initialize();
+
+    root_pool pool;
+
+    auto fs_config = apr_hash_make(pool);
+    if (options.batch_fsync) {
+        svn_hash_sets(fs_config, SVN_FS_CONFIG_NO_FLUSH_TO_DISK, "1");
+    }
+
+    svn_repos_t* repos;
+    check_result(svn_repos_open3(&repos, convert_from_path(path, pool), fs_config, pool, pool));
+
+    operation_baton baton{nullptr, abort, nullptr};
+
+    baton.notify = [&callback](const svn_repos_notify_t& info) -> void {
+        if (info.action != svn_repos_notify_load_txn_committed) {
+            return;
+        }
+
+        repos_load_progress item{static_cast<int32_t>(info.new_revision), static_cast<int32_t>(info.old_revision)};
+        callback(item);
+    };
+
+    pull_stream_baton stream_baton{read, baton.exception, {}, 0, false};
+
+    auto stream = svn_stream_create(&stream_baton, pool);
+    svn_stream_set_read2(stream, invoke_pull_read, invoke_pull_read_full);
+
+    auto parent_dir = options.parent_dir ? convert_from_fspath(*options.parent_dir, pool) : nullptr;
+
+    check_result(invoke_operation_cancel(&baton));
+
+    auto error = svn_repos_load_fs6(repos,
+                                    stream,
+                                    SVN_INVALID_REVNUM,
+                                    SVN_INVALID_REVNUM,
+                                    uuid_action,
+                                    parent_dir,
+                                    false,
+                                    false,
+                                    options.validate_props,
+                                    options.ignore_dates,
+                                    options.normalize_props,
+                                    invoke_operation_notify,
+                                    &baton,
+                                    invoke_operation_cancel,
+                                    &baton,
+                                    pool);
+    check_operation(error, baton);
+}
+
+static void write_file(svn_fs_root_t* root, const char* path, const std::vector<char>& content, apr_pool_t* pool) {
+    svn_stream_t* stream;
+    check_result(svn_fs_apply_text(&stream, root, path, nullptr, pool));
+    apr_size_t length = content.size();
+    check_result(svn_stream_write(stream, content.data(), &length));
+    check_result(svn_stream_close(stream));
+}
+
+static void apply_operation(svn_fs_t* fs, svn_fs_root_t* root, const repos_commit_operation& operation, apr_pool_t* pool) {
+    auto path = convert_from_fspath(operation.path, pool);
+
+    switch (operation.action) {
+        case repos_commit_action::add:
+            check_result(svn_fs_make_file(root, path, pool));
+            write_file(root, path, operation.content, pool);
+            break;
+        case repos_commit_action::put: {
+            svn_node_kind_t kind;
+            check_result(svn_fs_check_path(&kind, root, path, pool));
+            if (kind == svn_node_none) {
+                check_result(svn_fs_make_file(root, path, pool));
+            }
+            write_file(root, path, operation.content, pool);
+            break;
+        }
+        case repos_commit_action::remove:
+            check_result(svn_fs_delete(root, path, pool));
+            break;
+        case repos_commit_action::mkdir:
+            check_result(svn_fs_make_dir(root, path, pool));
+            break;
+        case repos_commit_action::copy: {
+            auto copyfrom_rev = operation.copyfrom_rev >= 0 ? operation.copyfrom_rev : svn_fs_txn_root_base_revision(root);
+
+            svn_fs_root_t* copyfrom_root;
+            check_result(svn_fs_revision_root(&copyfrom_root, fs, copyfrom_rev, pool));
+            check_result(svn_fs_copy(copyfrom_root, convert_from_fspath(operation.copyfrom_path, pool), root, path, pool));
+            break;
+        }
+        case repos_commit_action::propset: {
+            auto value = operation.value ? svn_string_ncreate(operation.value->data(), operation.value->size(), pool) : nullptr;
+            check_result(svn_fs_change_node_prop(root, path, convert_from_string(operation.name), value, pool));
+            break;
+        }
+    }
+}
+
+static repos_commit_result commit_revision(svn_repos_t*                repos,
+                                           const repos_commit_info&    info,
+                                           const repos_commit_options& options,
+                                           apr_pool_t*                 pool) {
+    auto fs = svn_repos_fs(repos);
+
+    svn_revnum_t youngest;
+    check_result(svn_fs_youngest_rev(&youngest, fs, pool));
+
+    auto revprops = apr_hash_make(pool);
+    for (auto& pair : info.revprops) {
+        svn_hash_sets(revprops, convert_from_string(pair.first), svn_string_ncreate(pair.second.data(), pair.second.size(), pool));
+    }
+    if (info.author) {
+        svn_hash_sets(revprops, SVN_PROP_REVISION_AUTHOR, svn_string_create(info.author->c_str(), pool));
+    }
+    svn_hash_sets(revprops, SVN_PROP_REVISION_LOG, svn_string_ncreate(info.message.data(), info.message.size(), pool));
+
+    svn_fs_txn_t* txn;
+    if (options.bypass_hooks) {
+        check_result(svn_fs_begin_txn2(&txn, fs, youngest, 0, pool));
+        check_result(svn_fs_change_txn_props(txn, svn_prop_hash_to_array(revprops, pool), pool));
+    } else {
+        check_result(svn_repos_fs_begin_txn_for_commit2(&txn, repos, youngest, revprops, pool));
+    }
+
+    const char*  conflict     = nullptr;
+    svn_revnum_t new_revision = SVN_INVALID_REVNUM;
+
+    std::optional<std::string> post_commit_error;
+
+    try {
+        svn_fs_root_t* root;
+        check_result(svn_fs_txn_root(&root, txn, pool));
+
+        apr_pool_t* iteration_pool;
+        check_result(apr_pool_create_ex(&iteration_pool, pool, nullptr, nullptr));
+        for (auto& operation : info.operations) {
+            apr_pool_clear(iteration_pool);
+            apply_operation(fs, root, operation, iteration_pool);
+        }
+        apr_pool_destroy(iteration_pool);
+
+        auto error = options.bypass_hooks ? svn_fs_commit_txn(&conflict, &new_revision, txn, pool)
+                                          : svn_repos_fs_commit_txn(&conflict, repos, &new_revision, txn, pool);
+
+        // only the post-commit hook can fail after the revision is created
+        if (error != nullptr && SVN_IS_VALID_REVNUM(new_revision)) {
+            post_commit_error.emplace(svn_repos__post_commit_error_str(error, pool));
+            svn_error_clear(error);
+        } else {
+            check_result(error);
+        }
+    } catch (...) {
+        svn_error_clear(svn_fs_abort_txn(txn, pool));
+        throw;
+    }
+
+    return repos_commit_result{static_cast<int32_t>(new_revision), std::move(post_commit_error)};
+}
+
+std::vector<repos_commit_result> repos::commit(const std::string&                    path,
+                                               const std::vector<repos_commit_info>& commits,
+                                               const repos_commit_options&           options) {
+    initialize();
+
+    root_pool pool;
+
+    svn_repos_t* repos;
+    check_result(svn_repos_open3(&repos, convert_from_path(path, pool), nullptr, pool, pool));
+
+    std::vector<repos_commit_result> result;
+    result.reserve(commits.size());
+
+    apr_pool_t* iteration_pool;
+    check_result(apr_pool_create_ex(&iteration_pool, pool, nullptr, nullptr));
+    for (auto& info : commits) {
+        apr_pool_clear(iteration_pool);
+        result.push_back(commit_revision(repos, info, options, iteration_pool));
+    }
+    apr_pool_destroy(iteration_pool);
+
+    return result;
+}
+
+struct repos::handle {
+    explicit handle(const char* path) {
+        root_pool scratch_pool;
+
+        auto fs_config = apr_hash_make(scratch_pool);
+        svn_hash_sets(fs_config, SVN_FS_CONFIG_FSFS_CACHE_DELTAS, "1");
+        svn_hash_sets(fs_config, SVN_FS_CONFIG_FSFS_CACHE_FULLTEXTS, "1");
+        svn_hash_sets(fs_config, SVN_FS_CONFIG_FSFS_CACHE_NODEPROPS, "1");
+
+        check_result(svn_repos_open3(&repository, path, fs_config, pool, scratch_pool));
+        fs = svn_repos_fs(repository);
+    }
+
+    root_pool    pool;
+    svn_repos_t* repository;
+    svn_fs_t*    fs;
+};
+
+struct repos::lease {
+    explicit lease(svn::repos& owner)
+        : _owner(owner)
+        , _handle(owner.acquire()) {
+    }
+
+    ~lease() {
+        _owner.release(std::move(_handle));
+    }
+
+    handle* operator->() const {
+        return _handle.get();
+    }
+
+  private:
+    svn::repos&             _owner;
+    std::unique_ptr<handle> _handle;
+};
+
+static std::mutex                                       open_repos_mutex;
+static std::map<std::string, std::weak_ptr<svn::repos>> open_repos;
+
+std::shared_ptr<repos> repos::open(const std::string& path) {
+    initialize();
+
+    std::string key;
+    {
+        root_pool pool;
+        key = convert_from_path(path, pool);
+    }
+
+    std::lock_guard<std::mutex> lock(open_repos_mutex);
+
+    auto entry = open_repos.find(key);
+    if (entry != open_repos.end()) {
+        if (auto result = entry->second.lock()) {
+            return result;
+        }
+    }
+
+    // drops the repositories released since, `key`'s too
+    for (auto it = open_repos.begin(); it != open_repos.end();) {
+        it = it->second.expired() ? open_repos.erase(it) : std::next(it);
+    }
+
+    auto result     = std::shared_ptr<repos>(new repos(key));
+    open_repos[key] = result;
+    return result;
+}
+
+repos::repos(const std::string& path)
+    : _path(path) {
+    // fails early when `path` isn't a repository
+    _idle.push_back(std::make_unique<handle>(_path.c_str()));
+}
+
+repos::~repos() {
+}
+
+std::unique_ptr<repos::handle> repos::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (!_idle.empty()) {
+            auto result = std::move(_idle.back());
+            _idle.pop_back();
+            return result;
+        }
+    }
+
+    return std::make_unique<handle>(_path.c_str());
+}
+
+void repos::release(std::unique_ptr<handle> handle) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _idle.push_back(std::move(handle));
+}
+
+int32_t repos::youngest() {
+    lease     handle(*this);
+    root_pool pool;
+
+    svn_revnum_t result;
+    check_result(svn_fs_youngest_rev(&result, handle->fs, pool));
+    return static_cast<int32_t>(result);
+}
+
+static void list_directory(svn_fs_root_t*              root,
+                           const char*                 path,
+                           const std::string&          relpath,
+                           bool                        recursive,
+                           const repos::tree_callback& callback,
+                           apr_pool_t*                 pool) {
+    apr_hash_t* entries;
+    check_result(svn_fs_dir_entries(&entries, root, path, pool));
+
+    std::vector<svn_fs_dirent_t*> sorted;
+    sorted.reserve(apr_hash_count(entries));
+    for (auto index = apr_hash_first(pool, entries); index; index = apr_hash_next(index)) {
+        sorted.push_back(static_cast<svn_fs_dirent_t*>(apr_hash_this_val(index)));
+    }
+    std::sort(sorted.begin(), sorted.end(), [](svn_fs_dirent_t* left, svn_fs_dirent_t* right) -> bool {
+        return std::strcmp(left->name, right->name) < 0;
+    });
+
+    apr_pool_t* iteration_pool;
+    check_result(apr_pool_create_ex(&iteration_pool, pool, nullptr, nullptr));
+
+    for (auto entry : sorted) {
+        apr_pool_clear(iteration_pool);
+
+        auto child = svn_fspath__join(path, entry->name, iteration_pool);
+
+        repos_dirent item{relpath.empty() ? entry->name : relpath + "/" + entry->name,
+                          static_cast<svn::node_kind>(entry->kind),
+                          -1,
+                          0};
+
+        if (entry->kind == svn_node_file) {
+            svn_filesize_t size;
+            check_result(svn_fs_file_length(&size, root, child, iteration_pool));
+            item.size = size;
+        }
+
+        svn_revnum_t created_rev;
+        check_result(svn_fs_node_created_rev(&created_rev, root, child, iteration_pool));
+        item.created_rev = static_cast<int32_t>(created_rev);
+
+        callback(item);
+
+        if (recursive && entry->kind == svn_node_dir) {
+            list_directory(root, child, item.path, recursive, callback, iteration_pool);
+        }
+    }
+
+    apr_pool_destroy(iteration_pool);
+}
+
+void repos::tree(int32_t revision, const std::string& path, bool recursive, const tree_callback& callback) {
+    lease     handle(*this);
+    root_pool pool;
+
+    auto root = get_revision_root(handle->fs, revision, pool);
+    list_directory(root, convert_from_fspath(path, pool), "", recursive, callback, pool);
+}
+
+void repos::cat(int32_t revision, const std::string& path, const cat_callback& callback) {
+    lease     handle(*this);
+    root_pool pool;
+
+    auto root = get_revision_root(handle->fs, revision, pool);
+
+    svn_stream_t* stream;
+    check_result(svn_fs_file_contents(&stream, root, convert_from_fspath(path, pool), pool));
+
+    std::vector<char> buffer(64 * 1024);
+    while (true) {
+        auto length = buffer.size();
+        check_result(svn_stream_read_full(stream, buffer.data(), &length));
+
+        if (length != 0) {
+            callback(buffer.data(), length);
+        }
+
+        if (length < buffer.size()) {
+            break;
+        }
+    }
+
+    check_result(svn_stream_close(stream));
+}
+
+std::map<std::string, log_changed_path> repos::changed_paths(int32_t revision) {
+    lease     handle(*this);
+    root_pool pool;
+
+    auto root = get_revision_root(handle->fs, revision, pool);
+
+    svn_fs_path_change_iterator_t* iterator;
+    check_result(svn_fs_paths_changed3(&iterator, root, pool, pool));
+
+    std::map<std::string, log_changed_path> result;
+
+    svn_fs_path_change3_t* change;
+    check_result(svn_fs_path_change_get(&change, iterator));
+    while (change != nullptr) {
+        log_changed_path item{'M', {}, -1, static_cast<svn::node_kind>(change->node_kind), change->text_mod != 0, change->prop_mod != 0};
+
+        switch (change->change_kind) {
+            case svn_fs_path_change_add:
+                item.action = 'A';
+                break;
+            case svn_fs_path_change_delete:
+                item.action = 'D';
+                break;
+            case svn_fs_path_change_replace:
+                item.action = 'R';
+                break;
+            default:
+                break;
+        }
+
+        if (item.action == 'A' || item.action == 'R') {
+            svn_revnum_t copyfrom_rev  = change->copyfrom_rev;
+            const char*  copyfrom_path = change->copyfrom_path;
+            if (!change->copyfrom_known) {
+                check_result(svn_fs_copied_from(&copyfrom_rev, &copyfrom_path, root, change->path.data, pool));
+            }
+
+            if (copyfrom_path != nullptr && SVN_IS_VALID_REVNUM(copyfrom_rev)) {
+                item.copyfrom_path.emplace(copyfrom_path);
+                item.copyfrom_rev = static_cast<int32_t>(copyfrom_rev);
+            }
+        }
+
+        result.emplace(std::piecewise_construct,
+                       std::forward_as_tuple(change->path.data, change->path.len),
+                       std::forward_as_tuple(std::move(item)));
+
+        check_result(svn_fs_path_change_get(&change, iterator));
+    }
+
+    return result;
+}
+
+string_map repos::proplist(int32_t revision, const std::string& path) {
+    lease     handle(*this);
+    root_pool pool;
+
+    auto root = get_revision_root(handle->fs, revision, pool);
+
+    apr_hash_t* props;
+    check_result(svn_fs_node_proplist(&props, root, convert_from_fspath(path, pool), pool));
+    return convert_to_string_map(props, pool);
+}
+
+string_map repos::revision_proplist(int32_t revision) {
+    lease     handle(*this);
+    root_pool pool;
+
+    apr_hash_t* props;
+    check_result(svn_fs_revision_proplist2(&props, handle->fs, resolve_revision(handle->fs, revision, pool), false, pool, pool));
+    return convert_to_string_map(props, pool);
+}
+
+struct history_baton {
+    const repos::history_callback& callback;
+    std::exception_ptr             exception;
+};
+
+static svn_error_t* invoke_history(void* raw_baton, const char* path, svn_revnum_t revision, apr_pool_t* pool) {
+    auto baton = static_cast<history_baton*>(raw_baton);
+
+    try {
+        repos_location item{path, static_cast<int32_t>(revision)};
+        baton->callback(item);
+        return nullptr;
+    } catch (...) {
+        // don't unwind through libsvn_repos
+        baton->exception = std::current_exception();
+        return svn_error_create(SVN_ERR_CANCELLED, nullptr, nullptr);
+    }
+}
+
+void repos::history(int32_t revision, const std::string& path, const history_callback& callback) {
+    lease     handle(*this);
+    root_pool pool;
+
+    history_baton baton{callback, nullptr};
+
+    auto error = svn_repos_history2(handle->fs,
+                                    convert_from_fspath(path, pool),
+                                    invoke_history,
+                                    &baton,
+                                    nullptr,
+                                    nullptr,
+                                    0,
+                                    resolve_revision(handle->fs, revision, pool),
+                                    true,
+                                    pool);
+
+    if (baton.exception) {
+        svn_error_clear(error);
+        std::rethrow_exception(baton.exception);
+    }
+
+    check_result(error);
+}
+} // namespace svn
@@ -0,0 +1,395 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <cpp/types.hpp>
+
+struct apr_pool_t;
+struct svn_fs_t;
+struct svn_repos_t;
+
+namespace svn {
+struct repos_create_options {
+    /** `fsfs` or `fsx`. */
+    std::string fs_type = "fsfs";
+
+    /** `lz4`, `zlib` or `none`, the backend's default when not set. */
+    std::optional<std::string> compression;
+
+    /** Revisions per shard, the backend's default when not set. */
+    std::optional<int32_t> shard_size;
+
+    /**
+     * The oldest Subversion version, like "1.9", that must be able to read
+     * the repository. The newest format when not set.
+     */
+    std::optional<std::string> compatible_version;
+};
+
+struct repos_hotcopy_options {
+    /** Only copies what changed since the last hotcopy to the destination. */
+    bool incremental = false;
+
+    /** Removes Berkeley DB log files that are no longer in use. */
+    bool clean_logs = false;
+
+    /**
+     * Zero for no limit. The calling thread sleeps to keep the rate, it's
+     * taken for the whole copy.
+     */
+    int64_t rate_limit_bytes_per_sec = 0;
+};
+
+struct repos_hotcopy_progress {
+    /** Packed shards are copied at once, revisions one by one. */
+    int32_t start_revision;
+    int32_t end_revision;
+    /** The size of the revision files copied for the range. */
+    int64_t bytes;
+};
+
+struct repos_pack_options {
+    /** Stops after packing that many shards, zero for no limit. */
+    int32_t shards_per_run = 0;
+};
+
+struct repos_pack_progress {
+    /** `start`, `end`, `start_revprop` or `end_revprop`. */
+    const char* action;
+    int64_t     shard;
+};
+
+struct repos_stats_options {
+    /**
+     * Reads every revision for the `layout` report, instead of only looking
+     * at the format. FSFS only.
+     */
+    bool detailed = false;
+};
+
+struct repos_representation_stats {
+    int64_t count;
+    /** On disk, after deltification and compression. */
+    int64_t packed_size;
+    /** Fully expanded. */
+    int64_t expanded_size;
+    /** Nodes using the representations, some of them are shared. */
+    int64_t references;
+    /** The average length of the delta chains that have to be combined to read one. */
+    double average_chain_length;
+};
+
+struct repos_histogram_line {
+    /** The line covers sizes below `2^index`. */
+    int64_t count;
+    int64_t size;
+};
+
+struct repos_large_change {
+    std::string path;
+    int32_t     revision;
+    int64_t     size;
+};
+
+struct repos_extension_stats {
+    /** `(none)` for files without extension. */
+    std::string extension;
+    int64_t     node_count;
+    int64_t     node_size;
+    int64_t     representation_count;
+    int64_t     representation_size;
+};
+
+struct repos_layout_stats {
+    int64_t total_size;
+    int64_t revision_count;
+    int64_t change_count;
+
+    int64_t file_count;
+    int64_t dir_count;
+
+    repos_representation_stats file_representations;
+    repos_representation_stats dir_representations;
+    repos_representation_stats file_prop_representations;
+    repos_representation_stats dir_prop_representations;
+
+    /** Trailing empty lines are left out. */
+    std::vector<repos_histogram_line> representation_sizes;
+    std::vector<repos_histogram_line> node_sizes;
+
+    /** Largest first. */
+    std::vector<repos_large_change> largest_changes;
+    /** Largest representation size first. */
+    std::vector<repos_extension_stats> extensions;
+};
+
+struct repos_stats {
+    int32_t youngest;
+    /** Zero when the repository isn't sharded. */
+    int32_t shard_size;
+    /** Revisions before it are packed. */
+    int32_t min_unpacked_rev;
+    /** Complete shards `pack` would pack. */
+    int32_t unpacked_shards;
+
+    /** Only with `repos_stats_options::detailed`. */
+    std::optional<repos_layout_stats> layout;
+};
+
+struct repos_verify_options {
+    int32_t start = 0;
+    /** Negative for the youngest revision. */
+    int32_t end = -1;
+    /** The number of threads verifying revision ranges side by side. */
+    int32_t parallelism = 1;
+    /** Only checks the backend's metadata, not the revisions' content. */
+    bool metadata_only = false;
+    /** Reports paths that only differ in Unicode normalization. */
+    bool check_normalization = false;
+};
+
+struct repos_verify_result {
+    /** `-1` for problems not tied to a revision. */
+    int32_t                  revision;
+    std::optional<svn_error> error;
+};
+
+struct repos_dump_options {
+    int32_t start = 0;
+    /** Negative for the youngest revision. */
+    int32_t end = -1;
+    /** Only dumps what changed in `start`, instead of everything it has. */
+    bool incremental = false;
+    /** Dumps file contents as deltas against their previous versions. */
+    bool deltas = false;
+};
+
+struct repos_dump_range {
+    std::string file;
+    int32_t     start;
+    int32_t     end;
+};
+
+struct repos_load_options {
+    /** `default`, `ignore` or `force`, what to do with the dump file's UUID. */
+    std::string uuid_action = "default";
+
+    /** Loads everything below this directory instead of the root. */
+    std::optional<std::string> parent_dir;
+
+    bool validate_props  = false;
+    bool ignore_dates    = false;
+    bool normalize_props = false;
+
+    /**
+     * Doesn't flush every revision to disk as it's committed, they are as
+     * durable as the operating system's write cache makes them.
+     */
+    bool batch_fsync = false;
+};
+
+struct repos_load_progress {
+    /** The revision committed to the repository. */
+    int32_t revision;
+    /** Its number in the dump file. */
+    int32_t original_revision;
+};
+
+enum class repos_commit_action {
+    // creates a file, failing when it exists
+    add,
+    // creates or overwrites a file
+    put,
+    remove,
+    mkdir,
+    copy,
+    propset,
+};
+
+struct repos_commit_operation {
+    repos_commit_action action;
+    std::string         path;
+
+    /** For `add` and `put`. */
+    std::vector<char> content;
+
+    /** For `copy`, a negative revision stands for the transaction's base. */
+    std::string copyfrom_path;
+    int32_t     copyfrom_rev = -1;
+
+    /** For `propset`, a value that isn't set deletes the property. */
+    std::string                name;
+    std::optional<std::string> value;
+};
+
+struct repos_commit_info {
+    /** `svn:author` is not set without one. */
+    std::optional<std::string> author;
+    std::string message;
+    /** Additional revision properties. */
+    string_map revprops;
+
+    std::vector<repos_commit_operation> operations;
+};
+
+struct repos_commit_options {
+    /** Doesn't run the start-commit, pre-commit and post-commit hooks. */
+    bool bypass_hooks = false;
+};
+
+struct repos_commit_result {
+    int32_t revision;
+    /** Set when the post-commit hook failed, the revision is committed anyway. */
+    std::optional<std::string> post_commit_error;
+};
+
+struct repos_dirent {
+    /** Relative to the listed directory. */
+    std::string    path;
+    svn::node_kind kind;
+    /** `-1` for directories. */
+    int64_t size;
+    /** The revision the node was last changed in. */
+    int32_t created_rev;
+};
+
+struct repos_location {
+    /** With a leading slash. */
+    std::string path;
+    int32_t     revision;
+};
+
+// Repositories on local disk, used through libsvn_repos and libsvn_fs
+// directly instead of a client and a ra_local session.
+//
+// Every operation works on pools of its own, so they can run on any thread.
+// A negative revision stands for the youngest one.
+class repos {
+  public:
+    using cat_callback     = std::function<void(const char*, size_t)>;
+    using tree_callback    = std::function<void(repos_dirent&)>;
+    using history_callback = std::function<void(repos_location&)>;
+    using hotcopy_callback = std::function<void(repos_hotcopy_progress&)>;
+    using pack_callback    = std::function<void(repos_pack_progress&)>;
+    using verify_callback  = std::function<void(repos_verify_result&)>;
+    using dump_callback    = std::function<void(std::vector<char>&)>;
+    using load_callback    = std::function<void(repos_load_progress&)>;
+    // Called with the revision being read.
+    using stats_callback = std::function<void(int32_t)>;
+
+    // Fills the chunk with the next part of the dump file, returns `false`
+    // at its end.
+    using read_function = std::function<bool(std::vector<char>&)>;
+
+    // Polled while long running operations go on, they fail with
+    // `SVN_ERR_CANCELLED` once it returns `true`.
+    using abort_function = std::function<bool()>;
+
+    static void create(const std::string& path, const repos_create_options& options = {});
+
+    static void hotcopy(const std::string&           source,
+                        const std::string&           destination,
+                        const repos_hotcopy_options& options,
+                        const hotcopy_callback&      callback,
+                        const abort_function&        abort = {});
+
+    // Packs complete shards, oldest first. Packing can be stopped and resumed
+    // at any point, `shards_per_run` bounds the work done by one call.
+    static void pack(const std::string&        path,
+                     const repos_pack_options& options,
+                     const pack_callback&      callback,
+                     const abort_function&     abort = {});
+
+    static repos_stats stats(const std::string&         path,
+                             const repos_stats_options& options  = {},
+                             const stats_callback&      callback = {},
+                             const abort_function&      abort    = {});
+
+    // Splits the range into `parallelism` chunks, each verified on a thread
+    // and filesystem handle of its own. Results of different chunks are
+    // interleaved, but `callback` is never called concurrently. Corrupted
+    // revisions are reported to `callback` instead of failing the call.
+    static void verify(const std::string&          path,
+                       const repos_verify_options& options,
+                       const verify_callback&      callback,
+                       const abort_function&       abort = {});
+
+    // Hands the dump file to `callback` in chunks of 64 KiB.
+    static void dump(const std::string&        path,
+                     const repos_dump_options& options,
+                     const dump_callback&      callback,
+                     const abort_function&     abort = {});
+
+    // Dumps one range of revisions to each of `files` side by side. All but
+    // the first are incremental, so they concatenate to one valid dump file.
+    static std::vector<repos_dump_range> dump_parallel(const std::string&              path,
+                                                       const std::vector<std::string>& files,
+                                                       const repos_dump_options&       options,
+                                                       const abort_function&           abort = {});
+
+    // Creates one revision per commit, in order. Stops at the first one that
+    // fails, the revisions before it stay.
+    static std::vector<repos_commit_result> commit(const std::string&                    path,
+                                                   const std::vector<repos_commit_info>& commits,
+                                                   const repos_commit_options&           options = {});
+
+    static void load(const std::string&        path,
+                     const read_function&      read,
+                     const repos_load_options& options,
+                     const load_callback&      callback,
+                     const abort_function&     abort = {});
+
+    // Handles are shared: opening a repository that is already open in the
+    // process returns the same handle, with the same fs caches.
+    static std::shared_ptr<repos> open(const std::string& path);
+
+    ~repos();
+
+    repos(const repos&) = delete;
+    repos& operator=(const repos&) = delete;
+
+    const std::string& path() const {
+        return _path;
+    }
+
+    int32_t youngest();
+
+    // Lists `path` in `revision`, depth first when `recursive`.
+    void tree(int32_t revision, const std::string& path, bool recursive, const tree_callback& callback);
+
+    void cat(int32_t revision, const std::string& path, const cat_callback& callback);
+
+    // Keyed by paths with a leading slash.
+    std::map<std::string, log_changed_path> changed_paths(int32_t revision);
+
+    string_map proplist(int32_t revision, const std::string& path);
+    string_map revision_proplist(int32_t revision);
+
+    // The revisions `path` in `revision` changed in, newest first, following
+    // copies.
+    void history(int32_t revision, const std::string& path, const history_callback& callback);
+
+  private:
+    struct handle;
+    struct lease;
+
+    explicit repos(const std::string& path);
+
+    // A filesystem can only be used by one thread at a time. When every
+    // handle is busy, another one is opened next to them.
+    std::unique_ptr<handle> acquire();
+    void                    release(std::unique_ptr<handle> handle);
+
+    const std::string _path;
+
+    std::mutex                           _mutex;
+    std::vector<std::unique_ptr<handle>> _idle;
+};
+} // namespace svn
@@ -0,0 +1,345 @@
+#include "status_watcher.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <apr_pools.h>
+
+#include "svn_error.hpp"
+#include "type_conversion.hpp"
+
+namespace svn {
+static const size_t max_removed = 64 * 1024;
+
+static const char* admin_directory = ".svn";
+
+static bool is_ancestor(const std::string& ancestor, const std::string& path) {
+    return path.size() > ancestor.size() &&
+           path.compare(0, ancestor.size(), ancestor) == 0 &&
+           path[ancestor.size()] == '/';
+}
+
+static bool in_scope(const std::string& path, const std::string& scope, svn::depth scope_depth) {
+    if (path == scope) {
+        return true;
+    }
+
+    switch (scope_depth) {
+        case depth::empty:
+            return false;
+        case depth::files:
+        case depth::immediates:
+            return is_ancestor(scope, path) && path.find('/', scope.size() + 1) == std::string::npos;
+        default:
+            return is_ancestor(scope, path);
+    }
+}
+
+static status_entry convert_to_status_entry(const status& status) {
+    auto optional_string = [](const char* value) -> std::optional<std::string> {
+        if (value == nullptr) {
+            return {};
+        }
+        return std::string(value);
+    };
+
+    return status_entry{status.local_abspath,
+                        status.kind,
+                        status.versioned,
+                        status.conflicted,
+                        status.node_status,
+                        status.text_status,
+                        status.prop_status,
+                        status.copied,
+                        status.revision,
+                        status.changed_rev,
+                        status.changed_date,
+                        optional_string(status.changed_author),
+                        status.file_external,
+                        optional_string(status.changelist),
+                        status.node_depth};
+}
+
+#ifdef __linux__
+static bool exists(const std::string& path) {
+    struct stat info;
+    return lstat(path.c_str(), &info) == 0;
+}
+#else
+static bool exists(const std::string&) {
+    return true;
+}
+#endif
+
+std::string status_watcher::canonicalize(const std::string& path) {
+    apr_pool_t* pool;
+    check_result(apr_pool_create_ex(&pool, nullptr, nullptr, nullptr));
+
+    try {
+        std::string result = convert_from_path(path, pool);
+        apr_pool_destroy(pool);
+        return result;
+    } catch (...) {
+        apr_pool_destroy(pool);
+        throw;
+    }
+}
+
+status_watcher::status_watcher(std::shared_ptr<const client> client, const std::string& path)
+    : _client(std::move(client))
+    , _root(canonicalize(path))
+    , _fd(-1)
+    , _degraded(false)
+    , _generation(1)
+    , _base(1) {
+#ifdef __linux__
+    // watch before the initial scan, so nothing that happens during it is missed
+    _fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_fd == -1) {
+        _degraded = true;
+    } else {
+        std::vector<std::string> added;
+        add_watches(_root, added);
+
+        auto admin = _root + "/" + admin_directory;
+        auto wd    = inotify_add_watch(_fd, admin.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE | IN_ONLYDIR);
+        if (wd != -1) {
+            _watches[wd] = admin;
+        }
+    }
+#else
+    _degraded = true;
+#endif
+
+    rescan(_root, depth::infinity);
+}
+
+status_watcher::~status_watcher() {
+#ifdef __linux__
+    if (_fd != -1) {
+        close(_fd);
+    }
+#endif
+}
+
+status_watcher::changes status_watcher::get_changes(int64_t since) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_degraded) {
+        _dirty.clear();
+        _dirty[_root] = depth::infinity;
+    } else {
+        read_events();
+    }
+
+    if (!_dirty.empty()) {
+        _generation++;
+
+        auto dirty = std::move(_dirty);
+        _dirty.clear();
+
+        for (auto& pair : dirty) {
+            rescan(pair.first, pair.second);
+        }
+
+        if (_removed.size() > max_removed) {
+            _removed.clear();
+            _base = _generation;
+        }
+    }
+
+    changes result{_generation, since < _base, {}, {}};
+    for (auto& pair : _index) {
+        if (result.reset || pair.second.generation > since) {
+            result.changed.push_back(pair.second.entry);
+        }
+    }
+
+    if (!result.reset) {
+        for (auto& pair : _removed) {
+            if (pair.second > since) {
+                result.removed.push_back(pair.first);
+            }
+        }
+    }
+
+    return result;
+}
+
+void status_watcher::add_watches(const std::string& directory, std::vector<std::string>& added) {
+#ifdef __linux__
+    const uint32_t mask = IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB | IN_ONLYDIR;
+
+    auto wd = inotify_add_watch(_fd, directory.c_str(), mask);
+    if (wd == -1) {
+        // out of watches, don't pretend to be up to date
+        if (errno == ENOSPC || errno == ENOMEM) {
+            _degraded = true;
+        }
+        return;
+    }
+    _watches[wd] = directory;
+    added.push_back(directory);
+
+    auto handle = opendir(directory.c_str());
+    if (handle == nullptr) {
+        return;
+    }
+
+    while (auto entry = readdir(handle)) {
+        if (entry->d_type != DT_DIR) {
+            continue;
+        }
+
+        if (std::strcmp(entry->d_name, ".") == 0 ||
+            std::strcmp(entry->d_name, "..") == 0 ||
+            std::strcmp(entry->d_name, admin_directory) == 0) {
+            continue;
+        }
+
+        add_watches(directory + "/" + entry->d_name, added);
+        if (_degraded) {
+            break;
+        }
+    }
+
+    closedir(handle);
+#endif
+}
+
+void status_watcher::read_events() {
+#ifdef __linux__
+    auto mark = [this](const std::string& path, svn::depth path_depth) -> void {
+        for (auto& pair : _dirty) {
+            if (pair.second == depth::infinity && is_ancestor(pair.first, path)) {
+                return;
+            }
+        }
+
+        if (path_depth == depth::infinity) {
+            for (auto it = _dirty.begin(); it != _dirty.end();) {
+                it = is_ancestor(path, it->first) ? _dirty.erase(it) : std::next(it);
+            }
+        }
+
+        auto& value = _dirty[path];
+        if (static_cast<int32_t>(path_depth) > static_cast<int32_t>(value)) {
+            value = path_depth;
+        }
+    };
+
+    alignas(inotify_event) char buffer[64 * 1024];
+    while (true) {
+        auto length = read(_fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;
+        }
+
+        for (auto pointer = buffer; pointer < buffer + length;) {
+            auto event = reinterpret_cast<const inotify_event*>(pointer);
+            pointer += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                _dirty.clear();
+                _dirty[_root] = depth::infinity;
+                continue;
+            }
+
+            auto watch = _watches.find(event->wd);
+            if (watch == _watches.end()) {
+                continue;
+            }
+
+            if (event->mask & IN_IGNORED) {
+                _watches.erase(watch);
+                continue;
+            }
+
+            std::string name = event->len > 0 ? event->name : "";
+
+            // svn operations (commit, revert, update...) change the status
+            // of any node without touching it, only the working copy database
+            // tells about them
+            if (watch->second == _root + "/" + admin_directory) {
+                if (name.compare(0, 5, "wc.db") == 0) {
+                    mark(_root, depth::infinity);
+                }
+                continue;
+            }
+
+            if (name.empty() || name == admin_directory) {
+                continue;
+            }
+
+            // only what changed is rescanned, a directory moved in with its
+            // content is rescanned one level at a time
+            auto path = watch->second + "/" + name;
+            if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO))) {
+                std::vector<std::string> added;
+                add_watches(path, added);
+                for (auto& directory : added) {
+                    mark(directory, depth::immediates);
+                }
+            } else if ((event->mask & IN_ISDIR) && (event->mask & (IN_DELETE | IN_MOVED_FROM))) {
+                mark(path, depth::immediates);
+            } else {
+                mark(path, depth::empty);
+            }
+        }
+    }
+#endif
+}
+
+void status_watcher::rescan(const std::string& path, svn::depth path_depth) {
+    std::map<std::string, status_entry> found;
+
+    try {
+        _client->status(path,
+                        [&found](const char*, const status& status) -> void {
+                            found.emplace(status.local_abspath, convert_to_status_entry(status));
+                        },
+                        revision_kind::working,
+                        path_depth);
+    } catch (const svn_error&) {
+        // the path is gone, or was never versioned, so nothing is reported
+        // for it anymore
+    }
+
+    // nothing below a directory that's gone is left, whatever depth it's
+    // scanned at
+    auto scope_depth = path_depth;
+    if (scope_depth != depth::infinity && !exists(path)) {
+        scope_depth = depth::infinity;
+    }
+
+    for (auto it = _index.begin(); it != _index.end();) {
+        if (in_scope(it->first, path, scope_depth) && found.find(it->first) == found.end()) {
+            _removed[it->first] = _generation;
+            it                  = _index.erase(it);
+        } else {
+            it++;
+        }
+    }
+
+    for (auto& pair : found) {
+        auto entry = _index.find(pair.first);
+        if (entry != _index.end()) {
+            if (entry->second.entry != pair.second) {
+                entry->second = indexed_entry{std::move(pair.second), _generation};
+            }
+            continue;
+        }
+
+        _removed.erase(pair.first);
+        _index.emplace(pair.first, indexed_entry{std::move(pair.second), _generation});
+    }
+}
+} // namespace svn
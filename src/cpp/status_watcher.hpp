@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <cpp/client.hpp>
+#include <cpp/types.hpp>
+
+namespace svn {
+// Keeps the status of a working copy up to date from file system events, so
+// asking for it again only rescans what changed since the last time.
+//
+// Every change to the index is tagged with a generation. A consumer passes
+// the last generation it has seen and receives only the entries that changed
+// or disappeared after it.
+//
+// On Linux the events come from inotify. Elsewhere, or when inotify can't
+// keep up (queue overflow, out of watches), every call falls back to a full
+// rescan, which still yields deltas but costs a full status.
+class status_watcher {
+  public:
+    struct changes {
+        int64_t generation;
+
+        // `since` is too old (or 0), `changed` holds the whole index and
+        // everything the consumer has should be dropped first.
+        bool reset;
+
+        std::vector<status_entry> changed;
+        std::vector<std::string>  removed;
+    };
+
+    // Runs the initial full status. The client is kept alive until the
+    // watcher is gone, which may be after its owner disposed of it.
+    status_watcher(std::shared_ptr<const client> client, const std::string& path);
+    ~status_watcher();
+
+    status_watcher(const status_watcher&) = delete;
+    status_watcher& operator=(const status_watcher&) = delete;
+
+    changes get_changes(int64_t since);
+
+    // The absolute path in the form svn reports, two paths of the same
+    // working copy root map to the same watcher.
+    static std::string canonicalize(const std::string& path);
+
+  private:
+    struct indexed_entry {
+        status_entry entry;
+        int64_t      generation;
+    };
+
+    // Appends the directories that got a watch to `added`.
+    void add_watches(const std::string& directory, std::vector<std::string>& added);
+    void read_events();
+    void rescan(const std::string& path, svn::depth path_depth);
+
+    std::shared_ptr<const client> _client;
+    std::string                   _root;
+
+    int                        _fd;
+    bool                       _degraded;
+    std::map<int, std::string> _watches;
+
+    // paths to rescan on the next call, with the depth they need
+    std::map<std::string, depth> _dirty;
+
+    std::map<std::string, indexed_entry> _index;
+    std::map<std::string, int64_t>       _removed;
+
+    int64_t _generation;
+    // the oldest generation deltas can still be computed from
+    int64_t _base;
+
+    std::mutex _mutex;
+};
+} // namespace svn
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <cstring>
 #include <optional>
 #include <string>
 
 #include <apr_pools.h>
 #include <svn_client.h>
+#include <svn_compat.h>
+#include <svn_mergeinfo.h>
 #include <svn_opt.h>
 #include <svn_path.h>
+#include <svn_props.h>
+#include <svn_time.h>
 
 #include <cpp/svn_type_error.hpp>
 #include <cpp/types.hpp>
@@ -99,6 +104,30 @@ static const char* convert_from_path(const std::optional<const std::string>& val
     return convert_from_path(*value, pool);
 }
 
+static const char* convert_from_path_or_url(const std::string& value,
+                                            apr_pool_t*        pool) {
+    if (svn_path_is_url(convert_from_string(value))) {
+        return convert_from_url(value, pool);
+    }
+
+    return convert_from_path(value, pool);
+}
+
+static const apr_array_header_t* convert_from_paths_or_urls(const std::vector<std::string>& value,
+                                                            apr_pool_t*                     pool) {
+    if (value.size() == 0) {
+        throw svn::svn_type_error("");
+    }
+
+    auto result = apr_array_make(pool, static_cast<int>(value.size()), sizeof(const char*));
+
+    for (auto& item : value) {
+        APR_ARRAY_PUSH(result, const char*) = convert_from_path_or_url(item, pool);
+    }
+
+    return result;
+}
+
 static const apr_array_header_t* convert_from_vector(const std::vector<std::string>& value,
                                                      apr_pool_t*                     pool,
                                                      bool                            path = false) {
@@ -157,10 +186,169 @@ static apr_hash_t* convert_from_map(const svn::string_map& map, apr_pool_t* pool
     return result;
 }
 
+static svn::string_map convert_to_string_map(apr_hash_t* raw, apr_pool_t* pool) {
+    svn::string_map result;
+
+    if (raw == nullptr)
+        return result;
+
+    apr_hash_index_t* index;
+    const char*       key;
+    apr_ssize_t       key_size;
+    svn_string_t*     value;
+    for (index = apr_hash_first(pool, raw); index; index = apr_hash_next(index)) {
+        apr_hash_this(index, reinterpret_cast<const void**>(&key), &key_size, reinterpret_cast<void**>(&value));
+
+        result.emplace(std::piecewise_construct,
+                       std::forward_as_tuple(key, key_size),
+                       std::forward_as_tuple(value->data, value->len));
+    }
+
+    return result;
+}
+
+static std::vector<svn::inherited_property> convert_to_inherited_properties(const apr_array_header_t* raw, apr_pool_t* pool) {
+    std::vector<svn::inherited_property> result;
+
+    if (raw == nullptr)
+        return result;
+
+    result.reserve(raw->nelts);
+    for (auto i = 0; i < raw->nelts; i++) {
+        auto item = APR_ARRAY_IDX(raw, i, svn_prop_inherited_item_t*);
+        result.push_back(svn::inherited_property{item->path_or_url, convert_to_string_map(item->prop_hash, pool)});
+    }
+
+    return result;
+}
+
+static std::optional<bool> convert_to_tristate(svn_tristate_t value) {
+    switch (value) {
+        case svn_tristate_true:
+            return true;
+        case svn_tristate_false:
+            return false;
+        default:
+            return {};
+    }
+}
+
+static std::optional<std::string> convert_to_optional_string(const char* value) {
+    if (value == nullptr)
+        return {};
+
+    return value;
+}
+
+static svn::log_entry convert_to_log_entry(const svn_log_entry_t* raw, apr_pool_t* pool) {
+    if (raw == nullptr)
+        throw svn::svn_type_error("");
+
+    svn::log_entry result{
+        static_cast<int32_t>(raw->revision),
+        {},
+        {},
+        {},
+        {},
+        static_cast<bool>(raw->has_children),
+        std::map<std::string, svn::log_changed_path>(),
+        static_cast<bool>(raw->non_inheritable),
+        static_cast<bool>(raw->subtractive_merge)};
+
+    const char* author;
+    const char* date;
+    const char* message;
+    svn_compat_log_revprops_out(&author, &date, &message, raw->revprops);
+
+    result.author  = convert_to_optional_string(author);
+    result.message = convert_to_optional_string(message);
+
+    apr_time_t time;
+    if (date != nullptr) {
+        auto error = svn_time_from_cstring(&time, date, pool);
+        if (error == nullptr) {
+            result.date = time;
+        }
+        svn_error_clear(error);
+    }
+
+    if (raw->revprops != nullptr) {
+        apr_hash_index_t* index;
+        const char*       name;
+        svn_string_t*     value;
+        for (index = apr_hash_first(pool, raw->revprops); index; index = apr_hash_next(index)) {
+            apr_hash_this(index, reinterpret_cast<const void**>(&name), nullptr, reinterpret_cast<void**>(&value));
+
+            if (std::strcmp(name, SVN_PROP_REVISION_AUTHOR) == 0 ||
+                std::strcmp(name, SVN_PROP_REVISION_DATE) == 0 ||
+                std::strcmp(name, SVN_PROP_REVISION_LOG) == 0) {
+                continue;
+            }
+
+            if (!result.revprops) {
+                result.revprops.emplace();
+            }
+            result.revprops->emplace(name, std::string(value->data, value->len));
+        }
+    }
+
+    if (raw->changed_paths2 == nullptr)
+        return result;
+
+    apr_hash_index_t*        index;
+    const char*              path;
+    svn_log_changed_path2_t* value;
+    for (index = apr_hash_first(pool, raw->changed_paths2); index; index = apr_hash_next(index)) {
+        apr_hash_this(index, reinterpret_cast<const void**>(&path), nullptr, reinterpret_cast<void**>(&value));
+
+        result.changed_paths.emplace(path,
+                                     svn::log_changed_path{
+                                         value->action,
+                                         convert_to_optional_string(value->copyfrom_path),
+                                         static_cast<int32_t>(value->copyfrom_rev),
+                                         static_cast<svn::node_kind>(value->node_kind),
+                                         convert_to_tristate(value->text_modified),
+                                         convert_to_tristate(value->props_modified)});
+    }
+
+    return result;
+}
+
+static svn::mergeinfo convert_to_mergeinfo(apr_hash_t* raw, apr_pool_t* pool) {
+    svn::mergeinfo result;
+
+    if (raw == nullptr)
+        return result;
+
+    apr_hash_index_t*   index;
+    const char*         source;
+    apr_array_header_t* ranges;
+    for (index = apr_hash_first(pool, raw); index; index = apr_hash_next(index)) {
+        apr_hash_this(index, reinterpret_cast<const void**>(&source), nullptr, reinterpret_cast<void**>(&ranges));
+
+        auto& item = result[source];
+        item.reserve(ranges->nelts);
+        for (auto i = 0; i < ranges->nelts; i++) {
+            auto range = APR_ARRAY_IDX(ranges, i, svn_merge_range_t*);
+            item.push_back(svn::merge_range{static_cast<int32_t>(range->start),
+                                            static_cast<int32_t>(range->end),
+                                            static_cast<bool>(range->inheritable)});
+        }
+    }
+
+    return result;
+}
+
 static svn_opt_revision_t convert_from_revision(const svn::revision& value) {
-    auto result       = svn_opt_revision_t();
-    result.kind       = static_cast<svn_opt_revision_kind>(value.kind);
-    result.value.date = static_cast<apr_time_t>(value.date);
+    auto result = svn_opt_revision_t();
+    result.kind = static_cast<svn_opt_revision_kind>(value.kind);
+
+    // `number` only fills the low half of the union
+    if (value.kind == svn::revision_kind::number)
+        result.value.number = static_cast<svn_revnum_t>(value.number);
+    else
+        result.value.date = static_cast<apr_time_t>(value.date);
+
     return result;
 }
 
@@ -282,7 +470,7 @@ static svn::commit_info convert_to_commit_info(const svn_commit_info_t* raw) {
         raw->repos_root};
 }
 
-void* operator new(size_t size, apr_pool_t* pool) {
+inline void* operator new(size_t size, apr_pool_t* pool) {
     auto result = apr_palloc(pool, size);
     if (result == nullptr) {
         static const std::bad_alloc error;
@@ -313,3 +501,22 @@ static apr_array_header_t* convert_from_revision_ranges(const std::optional<cons
 
     return result;
 }
+
+static const apr_array_header_t* convert_from_copy_sources(const std::vector<svn::copy_source>& value, apr_pool_t* pool) {
+    if (value.size() == 0) {
+        throw svn::svn_type_error("");
+    }
+
+    auto result = apr_array_make(pool, static_cast<int>(value.size()), sizeof(svn_client_copy_source_t*));
+
+    for (auto& item : value) {
+        auto source          = new (pool) svn_client_copy_source_t;
+        source->path         = convert_from_path_or_url(item.path, pool);
+        source->revision     = new (pool) svn_opt_revision_t(convert_from_revision(item.revision));
+        source->peg_revision = new (pool) svn_opt_revision_t(convert_from_revision(item.peg_revision));
+
+        APR_ARRAY_PUSH(result, svn_client_copy_source_t*) = source;
+    }
+
+    return result;
+}
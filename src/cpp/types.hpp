@@ -2,7 +2,9 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
@@ -153,6 +155,27 @@ struct lock {
     int64_t expiration_date;
 };
 
+/**
+ * The outcome of locking or unlocking one target.
+ */
+struct lock_result {
+    /** The working copy path or URL of the target. */
+    std::string path;
+
+    /** Whether the target was locked (or unlocked). */
+    bool succeeded;
+
+    /** The lock created by `lock`, empty for `unlock` and failures. */
+    std::optional<std::string> token;
+    std::optional<std::string> owner;
+    std::optional<std::string> comment;
+    int64_t                    creation_date;
+    int64_t                    expiration_date;
+
+    /** Why the target could not be locked (or unlocked). */
+    std::optional<svn_error> error;
+};
+
 /**
   * Structure for holding the "status" of a working copy item.
   *
@@ -322,6 +345,72 @@ struct status {
     const char* moved_to_abspath;
 };
 
+/**
+ * An owned copy of the parts of `status` a status index keeps, valid after
+ * the status callback returns.
+ */
+struct status_entry {
+    std::string path;
+
+    node_kind   kind;
+    bool        versioned;
+    bool        conflicted;
+    status_kind node_status;
+    status_kind text_status;
+    status_kind prop_status;
+    bool        copied;
+
+    std::optional<int32_t>     revision;
+    std::optional<int32_t>     changed_rev;
+    int64_t                    changed_date;
+    std::optional<std::string> changed_author;
+
+    bool                       file_external;
+    std::optional<std::string> changelist;
+    depth                      node_depth;
+
+    bool operator==(const status_entry& other) const {
+        return path == other.path &&
+               kind == other.kind &&
+               versioned == other.versioned &&
+               conflicted == other.conflicted &&
+               node_status == other.node_status &&
+               text_status == other.text_status &&
+               prop_status == other.prop_status &&
+               copied == other.copied &&
+               revision == other.revision &&
+               changed_rev == other.changed_rev &&
+               changed_date == other.changed_date &&
+               changed_author == other.changed_author &&
+               file_external == other.file_external &&
+               changelist == other.changelist &&
+               node_depth == other.node_depth;
+    }
+
+    bool operator!=(const status_entry& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * Which entries `client::status` reports, checked before an entry is
+ * converted. Empty lists don't filter.
+ */
+struct status_filter {
+    /** Only report entries with one of these node statuses. */
+    std::vector<status_kind> node_status_in;
+
+    /** Only report entries at or below one of these paths. Relative paths are
+        resolved against the current directory, like the status target. */
+    std::vector<std::string> path_prefixes;
+
+    /** Skip entries whose name or path relative to the status target matches
+        one of these `fnmatch` patterns. */
+    std::vector<std::string> exclude_globs;
+
+    bool only_conflicted;
+};
+
 /**
   * Various types of checksums.
   *
@@ -639,6 +728,151 @@ struct cat_result {
     string_map        properties;
 };
 
+struct pristine_item {
+    /** The path as passed in. */
+    std::string path;
+
+    /**
+     * The pristine text, a read-only memory mapping of the pristine store
+     * file when possible. Null when the file has none, like an added one.
+     */
+    std::shared_ptr<const char> content;
+    size_t                      content_size;
+
+    /** Why the text could not be read, the other targets are still read. */
+    std::optional<svn_error> error;
+};
+
+/**
+ * Counters of a cache since it was enabled.
+ */
+struct cache_metrics {
+    int64_t hits;
+    int64_t misses;
+    int64_t evictions;
+
+    /** The number of entries currently cached. */
+    int64_t entries;
+};
+
+/**
+ * Counters of the blame cache since it was enabled.
+ */
+struct blame_cache_metrics {
+    int64_t hits;
+    int64_t misses;
+    int64_t evictions;
+
+    /** The number of entries currently cached. */
+    int64_t entries;
+
+    /** Hits on an older annotation that were extended, the others were blamed again. */
+    int64_t extensions;
+};
+
+/**
+ * Counters of the content cache of `cat` and `cat_many`.
+ */
+struct fetch_cache_metrics {
+    int64_t hits;
+    int64_t misses;
+
+    /** File content served from the cache. */
+    int64_t bytes_served;
+    /** File content downloaded from repositories. */
+    int64_t bytes_fetched;
+
+    /** The size of the stored content. */
+    int64_t size;
+};
+
+/**
+ * The last changed information of a node in the repository.
+ */
+struct stat_item {
+    /** The URL as passed in. */
+    std::string path;
+
+    /** `svn::node_kind::none` if the node doesn't exist at the revision. */
+    svn::node_kind kind;
+
+    /** Length of the file text, or -1 for directories. */
+    int64_t size;
+
+    std::optional<int32_t>     created_rev;
+    int64_t                    time;
+    std::optional<std::string> last_author;
+
+    /** Why the node could not be checked, e.g. an unreachable repository. */
+    std::optional<svn_error> error;
+};
+
+struct cat_item {
+    /** The path or URL as passed in. */
+    std::string       path;
+    string_map        properties;
+    std::vector<char> content;
+
+    /** Why the file could not be fetched, the other targets are still fetched. */
+    std::optional<svn_error> error;
+};
+
+/**
+ * The author and date of one revision that appears in a `blame_result`.
+ */
+struct blame_revision {
+    int32_t                    revision;
+    std::optional<std::string> author;
+    /** The `svn:date` revision property, parsed to microseconds since epoch. */
+    std::optional<int64_t> date;
+};
+
+/**
+ * A whole annotation in a few flat arrays instead of one record per line.
+ *
+ * `content` is the text of the file in the end revision, with keywords not
+ * expanded and line endings translated like `cat` does. Line `i` is
+ * `content[line_offsets[i], line_offsets[i + 1])` including its end of line,
+ * so `line_offsets` has one entry more than there are lines.
+ * Revisions are `-1` where svn reports none, e.g. for local changes.
+ */
+struct blame_result {
+    std::vector<char>     content;
+    std::vector<uint32_t> line_offsets;
+    std::vector<int32_t>  revisions;
+    std::vector<int32_t>  merged_revisions;
+
+    /** Every revision referenced above once, sorted by revision. */
+    std::vector<blame_revision> revision_table;
+};
+
+/**
+ * Properties one node inherits from one of its parents.
+ */
+struct inherited_property {
+    /** The URL of the parent the properties are set on. */
+    std::string path_or_url;
+
+    /** The explicit properties of that parent. */
+    string_map properties;
+};
+
+/**
+ * The (explicit and optionally inherited) properties of one node, as
+ * reported by `propget` and `proplist`.
+ */
+struct property_item {
+    /** The working copy path or URL of the node. */
+    std::string path;
+
+    /** The explicit properties of the node. */
+    string_map properties;
+
+    /** The properties inherited from its parents, ordered from the
+     * repository root down. Only reported for the operation targets. */
+    std::optional<std::vector<inherited_property>> inherited_properties;
+};
+
 struct simple_auth {
     simple_auth(std::string&& username,
                 std::string&& password,
@@ -659,6 +893,30 @@ struct revision_range {
     const revision end;
 };
 
+/**
+ * A path or URL to copy from, at an optional revision.
+ */
+struct copy_source {
+    std::string   path;
+    svn::revision revision;
+    svn::revision peg_revision;
+};
+
+/**
+ * A range of revisions `(start, end]` in mergeinfo, i.e. `start` itself is
+ * not part of the range.
+ */
+struct merge_range {
+    int32_t start;
+    int32_t end;
+
+    /** Whether the range applies to the children of the path, too. */
+    bool inheritable;
+};
+
+/** Maps repository URLs to their sorted, non-overlapping ranges. */
+using mergeinfo = std::map<std::string, std::vector<merge_range>>;
+
 /**
  * A structure to represent a path that changed for a log entry.
  *
@@ -673,7 +931,7 @@ struct log_changed_path {
     char action;
 
     /** Source path of copy (if any). */
-    const char* copyfrom_path;
+    std::optional<std::string> copyfrom_path;
 
     /** Source revision of copy (if any). */
     int32_t copyfrom_rev;
@@ -706,14 +964,14 @@ struct log_entry {
     /** The revision of the commit. */
     int32_t revision;
 
-    /** The hash of requested revision properties, which may be NULL if it
-   * would contain no revprops.  Maps (const char *) property name to
-   * (svn_string_t *) property value. */
+    /** The requested revision properties, except `svn:author`, `svn:date`
+   * and `svn:log`, which are split into the fields below. */
     std::optional<std::unordered_map<std::string, std::string>> revprops;
 
-    const char* author;
-    const char* date;
-    const char* message;
+    std::optional<std::string> author;
+    /** The `svn:date` revision property, parsed to microseconds since epoch. */
+    std::optional<int64_t>     date;
+    std::optional<std::string> message;
 
     /**
    * Whether or not this message has children.
@@ -773,4 +1031,51 @@ struct log_entry {
      Also, if you add fields here, you have to update
      svn_log_entry_dup(). */
 };
+
+/**
+ * Filters of `client::search_log_cache`, unset ones match everything.
+ */
+struct log_query {
+    std::optional<std::string> author;
+
+    /** An FTS5 query on the log message. */
+    std::optional<std::string> message;
+
+    /** Only revisions that changed this repository path or below. */
+    std::optional<std::string> path;
+
+    /** Both inclusive, in microseconds since epoch. */
+    std::optional<int64_t> date_from;
+    std::optional<int64_t> date_to;
+
+    std::optional<int32_t> limit;
+
+    bool discover_changed_paths;
+};
+
+/**
+ * A representation of a segment of an object's version history with an
+ * emphasis on the object's location in the repository as of various
+ * revisions.
+ */
+struct location_segment {
+    /** The beginning (oldest) and ending (youngest) revisions for this
+        segment, both inclusive. */
+    int32_t range_start;
+    int32_t range_end;
+
+    /** The absolute (sans leading slash) path for this segment.  May be
+        empty to indicate gaps in an object's history.  */
+    std::optional<std::string> path;
+};
+
+/**
+ * One commit in the history of a node, with the path the node had in that
+ * commit, so renames show up as a change of `path`.
+ */
+struct history_item {
+    /** The absolute (sans leading slash) path of the node in this revision. */
+    std::string path;
+    log_entry   entry;
+};
 } // namespace svn
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include <node/error.hpp>
+#include <node/v8.hpp>
+
+#include <objects/object.hpp>
+
+namespace no {
+// Mirrors an `AbortSignal` into a flag the worker threads can poll, the
+// returned function reports whether the signal has been aborted.
+//
+// The listener is removed from the signal when the last copy of the function
+// is released. Work queued with `uv::queue_work` is deleted back on the
+// JavaScript thread once it settled, so capture the function there only.
+class abort_signal {
+  public:
+    static std::function<bool()> watch(v8::Isolate* isolate, const v8::Local<v8::Value>& value) {
+        if (value->IsUndefined()) {
+            return {};
+        }
+
+        if (!value->IsObject()) {
+            throw no::type_error("signal must be an AbortSignal");
+        }
+
+        no::object signal(value.As<v8::Object>());
+
+        auto aborted = std::make_shared<std::atomic<bool>>(signal["aborted"]->BooleanValue());
+        if (!aborted->load()) {
+            auto add_event_listener = signal["addEventListener"];
+            if (!add_event_listener->IsFunction()) {
+                throw no::type_error("signal must be an AbortSignal");
+            }
+
+            auto context  = isolate->GetCurrentContext();
+            auto listener = new abort_signal(isolate, aborted);
+
+            no::object options(isolate);
+            options["once"] = true;
+
+            const auto           argc       = 3;
+            v8::Local<v8::Value> argv[argc] = {no::data(isolate, "abort"), listener->_function.Get(isolate), options};
+            no::check_result(add_event_listener.as<v8::Function>()->Call(context, value, argc, argv));
+
+            auto registration = std::make_shared<abort_signal::registration>(isolate, value.As<v8::Object>(), listener->_function.Get(isolate));
+            return [aborted, registration]() -> bool { return aborted->load(); };
+        }
+
+        return [aborted]() -> bool { return aborted->load(); };
+    }
+
+  private:
+    // Calls `removeEventListener` when destroyed, signals without it keep the
+    // listener until they're collected.
+    class registration {
+      public:
+        registration(v8::Isolate* isolate, const v8::Local<v8::Object>& signal, const v8::Local<v8::Function>& function)
+            : _isolate(isolate)
+            , _context(isolate, isolate->GetCurrentContext())
+            , _signal(isolate, signal)
+            , _function(isolate, function) {
+        }
+
+        ~registration() {
+            v8::HandleScope scope(_isolate);
+
+            auto context = _context.Get(_isolate);
+            v8::Context::Scope context_scope(context);
+
+            auto signal = _signal.Get(_isolate);
+
+            v8::Local<v8::Value> remove_event_listener;
+            if (!signal->Get(context, no::data(_isolate, "removeEventListener")).ToLocal(&remove_event_listener) ||
+                !remove_event_listener->IsFunction()) {
+                return;
+            }
+
+            const auto           argc       = 2;
+            v8::Local<v8::Value> argv[argc] = {no::data(_isolate, "abort"), _function.Get(_isolate)};
+            // nothing to report the failure to, the operation has settled
+            static_cast<void>(remove_event_listener.As<v8::Function>()->Call(context, signal, argc, argv));
+        }
+
+      private:
+        v8::Isolate*             _isolate;
+        v8::Global<v8::Context>  _context;
+        v8::Global<v8::Object>   _signal;
+        v8::Global<v8::Function> _function;
+    };
+
+    // Lives as long as the signal holds on to the listener function.
+    abort_signal(v8::Isolate* isolate, std::shared_ptr<std::atomic<bool>> aborted)
+        : _aborted(std::move(aborted)) {
+        auto context  = isolate->GetCurrentContext();
+        auto function = no::data<v8::Function>(context, invoke, no::data(isolate, this));
+
+        _function.Reset(isolate, function);
+        _function.SetWeak(this, weak_callback, v8::WeakCallbackType::kParameter);
+    }
+
+    static void invoke(const v8::FunctionCallbackInfo<v8::Value>& args) {
+        auto _this = static_cast<abort_signal*>(args.Data().As<v8::External>()->Value());
+        _this->_aborted->store(true);
+    }
+
+    static void weak_callback(const v8::WeakCallbackInfo<abort_signal>& info) {
+        auto _this = info.GetParameter();
+        _this->_function.Reset();
+        delete _this;
+    }
+
+    std::shared_ptr<std::atomic<bool>> _aborted;
+    v8::Global<v8::Function>           _function;
+};
+} // namespace no
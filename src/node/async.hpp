@@ -0,0 +1,153 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <uv/async.hpp>
+#include <uv/future.hpp>
+#include <uv/work.hpp>
+
+#include <cpp/svn_error.hpp>
+
+#include <node/batch.hpp>
+#include <node/iterable.hpp>
+#include <node/type_conversion.hpp>
+#include <node/v8.hpp>
+
+#include <objects/resolver.hpp>
+
+// Converts one batch of items collected by `no::batch` into a JS array
+// and yields it as a single iteration.
+template <class T, class F>
+static decltype(auto) convert_batch_callback(v8::Isolate*                  isolate,
+                                             std::shared_ptr<no::iterable> iterable,
+                                             F                             convert) {
+    return [isolate, iterable, convert](std::vector<T>& items) -> uv::future<void> {
+        v8::HandleScope scope(isolate);
+
+        auto context = isolate->GetEnteredContext();
+        auto result  = no::data<v8::Array>(isolate, static_cast<int>(items.size()));
+        for (uint32_t i = 0; i < items.size(); i++) {
+            no::check_result(result->Set(context, i, convert(isolate, items[i])));
+        }
+
+        return iterable->yield(result);
+    };
+}
+
+namespace no {
+// Runs `work` on the worker pool and settles the returned promise with what
+// `convert` makes of its result back on the JavaScript thread.
+template <class Work, class Convert>
+static v8::Local<v8::Value> queue_promise(v8::Isolate* isolate, Work work, Convert convert) {
+    auto context  = isolate->GetCurrentContext();
+    auto resolver = no::resolver::create(isolate, context);
+
+    auto after_work = [isolate, resolver, convert](std::future<decltype(work())> future) -> void {
+        v8::HandleScope scope(isolate);
+
+        try {
+            auto result = future.get();
+            resolver->resolve(convert(isolate, result));
+        } catch (const svn::svn_error& raw_error) {
+            resolver->reject(copy_error(isolate, raw_error));
+        }
+    };
+
+    uv::queue_work(std::move(work), std::move(after_work));
+
+    return resolver->value();
+}
+
+// Like above, for `work` without a result, the promise resolves to `undefined`.
+template <class Work>
+static v8::Local<v8::Value> queue_promise(v8::Isolate* isolate, Work work) {
+    auto context  = isolate->GetCurrentContext();
+    auto resolver = no::resolver::create(isolate, context);
+
+    auto after_work = [isolate, resolver](std::future<void> future) -> void {
+        v8::HandleScope scope(isolate);
+
+        try {
+            future.get();
+            resolver->resolve();
+        } catch (const svn::svn_error& raw_error) {
+            resolver->reject(copy_error(isolate, raw_error));
+        }
+    };
+
+    uv::queue_work(std::move(work), std::move(after_work));
+
+    return resolver->value();
+}
+
+// Runs `work` on the worker pool with a function that adds items of type `T`
+// to the returned async iterable, yielded `batch_size` at a time.
+template <class T, class Work, class Convert>
+static v8::Local<v8::Value> queue_iterable(v8::Isolate* isolate, int32_t batch_size, Work work, Convert convert) {
+    auto context  = isolate->GetCurrentContext();
+    auto iterable = no::iterable::create(isolate, context);
+    auto callback = convert_batch_callback<T>(isolate, iterable, convert);
+
+    auto batched_work = [work, callback, batch_size]() -> void {
+        auto batch = no::make_batch<T>(uv::make_async(callback), batch_size);
+
+        work([&batch](T& item) -> void { batch.push(std::move(item)); });
+
+        batch.flush();
+    };
+
+    auto after_work = [isolate, iterable](std::future<void> future) -> void {
+        try {
+            future.get();
+            iterable->end();
+        } catch (const svn::svn_error& raw_error) {
+            v8::HandleScope scope(isolate);
+
+            auto error = copy_error(isolate, raw_error);
+            iterable->reject(error);
+        }
+    };
+
+    uv::queue_work(std::move(batched_work), std::move(after_work));
+
+    return iterable->get();
+}
+
+// Like above, for progress notifications: every item is yielded on its own
+// as soon as `work` reports it.
+template <class T, class Work, class Convert>
+static v8::Local<v8::Value> queue_progress(v8::Isolate* isolate, Work work, Convert convert) {
+    auto context  = isolate->GetCurrentContext();
+    auto iterable = no::iterable::create(isolate, context);
+    auto callback = [isolate, iterable, convert](T& item) -> uv::future<void> {
+        v8::HandleScope scope(isolate);
+
+        return iterable->yield(convert(isolate, item));
+    };
+
+    auto notifying_work = [work, callback]() -> void {
+        auto notify = uv::make_async(callback);
+
+        work([&notify](T& item) -> void { notify(item); });
+    };
+
+    auto after_work = [isolate, iterable](std::future<void> future) -> void {
+        try {
+            future.get();
+            iterable->end();
+        } catch (const svn::svn_error& raw_error) {
+            v8::HandleScope scope(isolate);
+
+            auto error = copy_error(isolate, raw_error);
+            iterable->reject(error);
+        }
+    };
+
+    uv::queue_work(std::move(notifying_work), std::move(after_work));
+
+    return iterable->get();
+}
+} // namespace no
@@ -1,86 +1,14 @@
 #include "simple.hpp"
 
 #include <cstring>
-#include <functional>
 #include <future>
 
+#include <node/promise.hpp>
+
 #include <objects/object.hpp>
 
 #include <uv/async.hpp>
 
-namespace no {
-namespace promise {
-template <class T>
-using ThenCallback = std::function<T(v8::Isolate*, const v8::Local<v8::Value>& value)>;
-
-template <class T>
-struct then_data {
-    ThenCallback<T>                  callback;
-    std::shared_ptr<std::promise<T>> promise;
-};
-
-template <class T>
-static void invoke_callback(const v8::FunctionCallbackInfo<v8::Value>& args) {
-    auto isolate = args.GetIsolate();
-    auto data    = static_cast<then_data<T>*>(args.Data().As<v8::External>()->Value());
-    try {
-        data->promise->set_value(data->callback(isolate, args[0]));
-    } catch (...) {
-        data->promise->set_exception(std::current_exception());
-    }
-
-    delete data;
-}
-
-template <class T>
-static std::future<T> then(v8::Isolate*                  isolate,
-                           const v8::Local<v8::Promise>& promise,
-                           ThenCallback<T>               then_callback,
-                           ThenCallback<T>               catch_callback) {
-    auto _promise = std::make_shared<std::promise<T>>();
-    auto future   = _promise->get_future();
-
-    auto context = isolate->GetEnteredContext();
-
-    auto external = no::data(isolate, new then_data<T>{std::move(then_callback), _promise});
-    auto function = v8::Function::New(context, invoke_callback<T>, external).ToLocalChecked();
-    promise->Then(context, function).ToLocalChecked();
-
-    external = no::data(isolate, new then_data<T>{std::move(catch_callback), _promise});
-    function = v8::Function::New(context, invoke_callback<T>, external).ToLocalChecked();
-    promise->Catch(context, function).ToLocalChecked();
-
-    // switch (promise->State()) {
-    //     case v8::Promise::kPending: {
-    //         auto external = v8::External::New(isolate, new then_data<T>{std::move(then_callback), _promise});
-    //         auto function = v8::Function::New(context, invoke_callback<T>, external).ToLocalChecked();
-    //         promise->Then(context, function).ToLocalChecked();
-
-    //         external = v8::External::New(isolate, new then_data<T>{std::move(catch_callback), _promise});
-    //         function = v8::Function::New(context, invoke_callback<T>, external).ToLocalChecked();
-    //         promise->Catch(context, function).ToLocalChecked();
-    //     } break;
-    //     case v8::Promise::kFulfilled:
-    //         try {
-    //             _promise->set_value(then_callback(isolate, promise->Result()));
-    //         } catch (...) {
-    //             _promise->set_exception(std::current_exception());
-    //         }
-    //         break;
-    //     case v8::Promise::kRejected:
-    //         try {
-    //             _promise->set_value(catch_callback(isolate, promise->Result()));
-    //         } catch (...) {
-    //             _promise->set_exception(std::current_exception());
-    //         }
-    //         break;
-    // }
-
-    return future;
-}
-} // namespace promise
-} // namespace no
-
 static std::string convert_string(const v8::Local<v8::Value>& value) {
     if (!value->IsString())
         throw svn::svn_type_error("");
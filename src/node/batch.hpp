@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace no {
+static const size_t default_batch_size = 256;
+
+// Collects items on the worker thread and hands them to `callback` (usually an
+// `uv::async` yielding a JS array) `size` items at a time, so large results
+// cross the thread boundary once per batch instead of once per item.
+template <class T, class Callback>
+class batch {
+  public:
+    explicit batch(Callback callback, size_t size = default_batch_size)
+        : _callback(std::move(callback))
+        , _size(size == 0 ? default_batch_size : size) {
+        _items.reserve(_size);
+    }
+
+    void push(const T& item) {
+        _items.push_back(item);
+        if (_items.size() >= _size) {
+            flush();
+        }
+    }
+
+    void push(T&& item) {
+        _items.push_back(std::move(item));
+        if (_items.size() >= _size) {
+            flush();
+        }
+    }
+
+    void flush() {
+        if (_items.empty()) {
+            return;
+        }
+
+        _callback(_items);
+        _items.clear();
+    }
+
+  private:
+    Callback       _callback;
+    size_t         _size;
+    std::vector<T> _items;
+};
+
+template <class T, class Callback>
+decltype(auto) make_batch(Callback&& callback, size_t size = default_batch_size) {
+    return batch<T, std::decay_t<Callback>>(std::forward<Callback>(callback), size);
+}
+} // namespace no
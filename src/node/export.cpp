@@ -7,6 +7,7 @@
 
 #include <node/v8.hpp>
 
+#include <node/node_authz.hpp>
 #include <node/node_client.hpp>
 
 #include <node/enum/conflict_choose.hpp>
@@ -77,6 +78,7 @@ void initialize(v8::Local<v8::Object> raw_exports) {
 
     // NODE_SET_METHOD(exports, "test", test);
 
+    authz::initialize(exports);
     client::initialize(exports);
 
     conflict_choose::initialize(exports);
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cpp/svn_error.hpp>
+
+#include <node/error.hpp>
+#include <node/type_conversion.hpp>
+#include <node/v8.hpp>
+
+namespace no {
+// Unlike methods, functions don't go through `class_builder`, which turns
+// exceptions into JavaScript ones.
+template <v8::Local<v8::Value> (*Function)(const v8::FunctionCallbackInfo<v8::Value>&)>
+static void invoke(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto isolate = args.GetIsolate();
+
+    try {
+        args.GetReturnValue().Set(Function(args));
+    } catch (const no::type_error& error) {
+        isolate->ThrowException(v8::Exception::TypeError(no::data(isolate, error.what()).As<v8::String>()));
+    } catch (const svn::svn_error& raw_error) {
+        isolate->ThrowException(copy_error(isolate, raw_error));
+    }
+}
+} // namespace no
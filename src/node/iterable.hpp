@@ -173,7 +173,7 @@ class iterable : public std::enable_shared_from_this<iterable> {
         return resolver;
     }
 
-    static v8::Global<v8::Function> _initializer;
+    static inline v8::Global<v8::Function> _initializer;
 
     v8::Isolate*            _isolate;
     v8::Global<v8::Context> _context;
@@ -188,6 +188,4 @@ class iterable : public std::enable_shared_from_this<iterable> {
 
     std::promise<void> _consume_promise;
 };
-
-v8::Global<v8::Function> iterable::_initializer;
 } // namespace no
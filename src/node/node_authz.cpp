@@ -0,0 +1,200 @@
+#include "node_authz.hpp"
+
+#include <cpp/authz.hpp>
+
+#include <node/async.hpp>
+#include <node/invoke.hpp>
+#include <node/type_conversion.hpp>
+
+#include <objects/class_builder.hpp>
+
+// `null` or omitted for anonymous users, and for rules of any repository.
+static std::optional<std::string> convert_optional_name(const v8::Local<v8::Value>& value) {
+    if (value->IsUndefined() || value->IsNull()) {
+        return {};
+    }
+
+    return convert_string(value);
+}
+
+// Same as the authz file syntax.
+static svn::authz_access convert_access(const v8::Local<v8::Value>& value) {
+    auto raw = convert_string(value);
+
+    if (raw == "r") {
+        return svn::authz_access::read;
+    }
+
+    if (raw == "rw") {
+        return svn::authz_access::write;
+    }
+
+    throw no::type_error("access must be \"r\" or \"rw\"");
+}
+
+// Entries are paths or objects with a `path`, like the ones listed by
+// `Repository.tree`, relative to `base` when set.
+static std::vector<std::string> convert_entries(const v8::Local<v8::Array>& entries, const std::optional<std::string>& base) {
+    auto length = entries->Length();
+
+    std::vector<std::string> result;
+    result.reserve(length);
+
+    for (uint32_t i = 0; i < length; i++) {
+        auto item = entries->Get(i);
+
+        std::string path;
+        if (item->IsObject()) {
+            no::object object(item.As<v8::Object>());
+            path = convert_string(object["path"]);
+        } else {
+            path = convert_string(item);
+        }
+
+        if (base.has_value()) {
+            path = base.value() + "/" + path;
+        }
+
+        result.push_back(std::move(path));
+    }
+
+    return result;
+}
+
+namespace no {
+void authz::initialize(no::object& exports) {
+    v8::HandleScope scope(exports.isolate());
+
+    class_builder<authz> clazz(exports.isolate(), "Authz", constructor);
+    clazz.add_prototype_method("check", &authz::check, 4);
+    clazz.add_prototype_method("filter", &authz::filter, 3);
+
+    _initializer.Reset(exports.isolate(), clazz.get_constructor());
+
+    no::object object(exports.isolate());
+    object["load"].set(no::data<v8::Function>(exports.context(), invoke<load>), no::property_attribute::read_only);
+
+    exports["authz"].set(object, no::property_attribute::read_only);
+}
+
+v8::Local<v8::Value> authz::create(v8::Isolate* isolate, std::shared_ptr<svn::authz> model) {
+    auto context = isolate->GetCurrentContext();
+
+    const auto           argc       = 1;
+    v8::Local<v8::Value> argv[argc] = {no::data(isolate, &model)};
+
+    return _initializer.Get(isolate)->NewInstance(context, argc, argv).ToLocalChecked();
+}
+
+authz::authz(std::shared_ptr<svn::authz> model)
+    : _model(std::move(model)) {
+}
+
+std::shared_ptr<authz> authz::constructor(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    if (!args[0]->IsExternal()) {
+        throw no::type_error("use authz.load");
+    }
+
+    auto model = static_cast<std::shared_ptr<svn::authz>*>(args[0].As<v8::External>()->Value());
+    return std::shared_ptr<authz>(new authz(*model));
+}
+
+// A path is compiled once for every caller, a Buffer holds the rules
+// themselves and is compiled on its own.
+v8::Local<v8::Value> authz::load(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto isolate = args.GetIsolate();
+
+    auto convert = [](v8::Isolate* isolate, std::shared_ptr<svn::authz> result) -> v8::Local<v8::Value> {
+        return authz::create(isolate, std::move(result));
+    };
+
+    if (node::Buffer::HasInstance(args[0])) {
+        auto data    = node::Buffer::Data(args[0]);
+        auto content = std::string(data, node::Buffer::Length(args[0]));
+
+        return queue_promise(
+            isolate,
+            [content]() -> std::shared_ptr<svn::authz> { return svn::authz::parse(content); },
+            convert);
+    }
+
+    auto path = convert_string(args[0]);
+
+    return queue_promise(
+        isolate,
+        [path]() -> std::shared_ptr<svn::authz> { return svn::authz::load(path); },
+        convert);
+}
+
+v8::Local<v8::Value> authz::check(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto user   = convert_optional_name(args[0]);
+    auto repos  = convert_optional_name(args[1]);
+    auto paths  = convert_array(args[2], false);
+    auto access = convert_access(args[3]);
+
+    auto options   = convert_options(args[4]);
+    auto recursive = convert_bool(options, "recursive", false);
+
+    auto model = _model;
+
+    return queue_promise(
+        args.GetIsolate(),
+        [model, user, repos, paths = std::move(paths), access, recursive]() -> std::vector<bool> {
+            return model->check(user, repos, paths, access, recursive);
+        },
+        [](v8::Isolate* isolate, const std::vector<bool>& result) -> v8::Local<v8::Value> {
+            auto context = isolate->GetCurrentContext();
+            auto array   = v8::Array::New(isolate, static_cast<int32_t>(result.size()));
+            for (size_t i = 0; i < result.size(); i++) {
+                no::check_result(array->Set(context, static_cast<uint32_t>(i), v8::Boolean::New(isolate, result[i])));
+            }
+            return array;
+        });
+}
+
+v8::Local<v8::Value> authz::filter(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto isolate = args.GetIsolate();
+
+    auto user  = convert_optional_name(args[0]);
+    auto repos = convert_optional_name(args[1]);
+
+    if (!args[2]->IsArray()) {
+        throw no::type_error("entries must be an array");
+    }
+
+    auto options   = convert_options(args[3]);
+    auto base      = convert_optional_string(options, "base");
+    auto access    = options.has_value() && !options.value()["access"]->IsUndefined()
+                         ? convert_access(options.value()["access"])
+                         : svn::authz_access::read;
+    auto recursive = convert_bool(options, "recursive", false);
+
+    auto entries = args[2].As<v8::Array>();
+    auto paths   = convert_entries(entries, base);
+
+    // released with the conversion, back on this thread
+    auto global = std::make_shared<v8::Global<v8::Array>>(isolate, entries);
+
+    auto model = _model;
+
+    return queue_promise(
+        isolate,
+        [model, user, repos, paths = std::move(paths), access, recursive]() -> std::vector<bool> {
+            return model->check(user, repos, paths, access, recursive);
+        },
+        [global](v8::Isolate* isolate, const std::vector<bool>& result) -> v8::Local<v8::Value> {
+            auto context = isolate->GetCurrentContext();
+            auto entries = global->Get(isolate);
+            auto array   = v8::Array::New(isolate);
+
+            uint32_t length = 0;
+            for (size_t i = 0; i < result.size(); i++) {
+                if (result[i]) {
+                    auto item = no::check_result(entries->Get(context, static_cast<uint32_t>(i)));
+                    no::check_result(array->Set(context, length++, item));
+                }
+            }
+            return array;
+        });
+}
+} // namespace no
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+
+#include <objects/object.hpp>
+
+namespace svn {
+class authz;
+}
+
+namespace no {
+// Rules compiled by `authz.load`, shares the `svn::authz` model with every
+// other object loaded from the same file.
+class authz : public std::enable_shared_from_this<authz> {
+  public:
+    static void initialize(no::object& exports);
+
+    static v8::Local<v8::Value> create(v8::Isolate* isolate, std::shared_ptr<svn::authz> model);
+
+    authz(const authz&) = delete;
+    authz(authz&&)      = delete;
+
+  private:
+    explicit authz(std::shared_ptr<svn::authz> model);
+
+    static std::shared_ptr<authz> constructor(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+    static v8::Local<v8::Value> load(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+    v8::Local<v8::Value> check(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> filter(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+    static inline v8::Global<v8::Function> _initializer;
+
+    std::shared_ptr<svn::authz> _model;
+};
+} // namespace no
@@ -8,8 +8,11 @@
 #include <uv/work.hpp>
 
 #include <cpp/client.hpp>
+#include <cpp/status_watcher.hpp>
 #include <cpp/svn_type_error.hpp>
 
+#include <node/async.hpp>
+#include <node/batch.hpp>
 #include <node/error.hpp>
 #include <node/iterable.hpp>
 #include <node/type_conversion.hpp>
@@ -84,99 +87,6 @@
 
 // clang-format on
 
-static v8::Local<v8::Value> copy_error(v8::Isolate* isolate, const svn::svn_error& raw_error) {
-    auto message = raw_error.what();
-
-    no::object error(v8::Exception::Error(no::data(isolate, message).As<v8::String>()).As<v8::Object>());
-
-    error["name"] = "SvnError";
-    error["code"] = raw_error.code;
-    error["file"] = raw_error.file;
-    error["line"] = raw_error.line;
-
-    if (raw_error.child != nullptr)
-        error["child"] = copy_error(isolate, *raw_error.child);
-
-    return error;
-}
-
-static std::vector<std::string> convert_array(const v8::Local<v8::Value>& value,
-                                              bool                        allowEmpty) {
-    if (value->IsUndefined()) {
-        if (allowEmpty)
-            return std::vector<std::string>();
-        else
-            throw no::type_error("");
-    }
-
-    if (value->IsString()) {
-        return std::vector<std::string>{convert_string(value)};
-    }
-
-    if (value->IsArray()) {
-        auto array  = value.As<v8::Array>();
-        auto length = array->Length();
-        auto result = std::vector<std::string>();
-        for (uint32_t i = 0; i < length; i++) {
-            auto item = array->Get(i);
-            result.push_back(std::move(convert_string(item)));
-        }
-        return result;
-    }
-
-    throw no::type_error("");
-}
-
-static std::optional<no::object> convert_options(const v8::Local<v8::Value> options) {
-    if (options->IsUndefined()) {
-        return {};
-    }
-
-    if (options->IsObject()) {
-        return no::object(options.As<v8::Object>());
-    }
-
-    throw no::type_error("");
-}
-
-template <size_t N>
-static int32_t convert_number(const std::optional<no::object>& options,
-                              const char (&key)[N],
-                              int32_t defaultValue) {
-    if (!options.has_value()) {
-        return defaultValue;
-    }
-
-    v8::Local<v8::Value> value = options.value()[key];
-    if (value->IsUndefined())
-        return defaultValue;
-
-    if (value->IsNumber()) {
-        return value->Int32Value();
-    }
-
-    throw no::type_error("");
-}
-
-template <size_t N>
-static bool convert_bool(const std::optional<no::object>& options,
-                         const char (&key)[N],
-                         bool defaultValue) {
-    if (!options.has_value()) {
-        return defaultValue;
-    }
-
-    v8::Local<v8::Value> value = options.value()[key];
-    if (value->IsUndefined())
-        return defaultValue;
-
-    if (value->IsBoolean()) {
-        return value->BooleanValue();
-    }
-
-    throw no::type_error("");
-}
-
 template <size_t N>
 static svn::revision convert_revision(const std::optional<no::object>& options,
                                       const char (&key)[N],
@@ -292,31 +202,111 @@ static svn::depth convert_depth(const std::optional<no::object>& options,
 }
 
 template <size_t N>
-static std::vector<std::string> convert_array(const std::optional<no::object>& options,
-                                              const char (&key)[N]) {
+static std::vector<svn::status_kind> convert_status_kinds(const std::optional<no::object>& options,
+                                                          const char (&key)[N]) {
+    std::vector<svn::status_kind> result;
     if (!options.has_value()) {
-        return std::vector<std::string>();
+        return result;
     }
 
     auto value = options.value()[key];
+    if (value->IsUndefined()) {
+        return result;
+    }
+
+    if (value->IsNumber()) {
+        result.push_back(static_cast<svn::status_kind>(value->Int32Value()));
+        return result;
+    }
+
+    if (value->IsArray()) {
+        auto array  = value.As<v8::Array>();
+        auto length = array->Length();
+        for (uint32_t i = 0; i < length; i++) {
+            auto item = array->Get(i);
+            if (!item->IsNumber()) {
+                throw no::type_error("");
+            }
+
+            result.push_back(static_cast<svn::status_kind>(item->Int32Value()));
+        }
+        return result;
+    }
+
+    throw no::type_error("");
+}
+
+template <size_t N>
+static std::optional<int64_t> convert_optional_date(const std::optional<no::object>& options,
+                                                    const char (&key)[N]) {
+    if (!options.has_value()) {
+        return {};
+    }
+
+    v8::Local<v8::Value> value = options.value()[key];
     if (value->IsUndefined())
-        return std::vector<std::string>();
+        return {};
+
+    if (value->IsDate()) {
+        // microseconds, like `svn:date`
+        return static_cast<int64_t>(value.As<v8::Date>()->ValueOf()) * 1000;
+    }
+
+    throw no::type_error("");
+}
+
+static svn::copy_source convert_copy_source(const v8::Local<v8::Value>& value) {
+    if (value->IsString()) {
+        return svn::copy_source{convert_string(value), svn::revision_kind::unspecified, svn::revision_kind::unspecified};
+    }
+
+    if (value->IsObject()) {
+        const std::optional<no::object> object = no::object(value.As<v8::Object>());
+
+        return svn::copy_source{convert_string(object.value()["path"]),
+                                convert_revision(object, "revision", svn::revision_kind::unspecified),
+                                convert_revision(object, "peg_revision", svn::revision_kind::unspecified)};
+    }
+
+    throw no::type_error("");
+}
+
+static std::vector<svn::copy_source> convert_copy_sources(const v8::Local<v8::Value>& value) {
+    if (value->IsArray()) {
+        auto array  = value.As<v8::Array>();
+        auto length = array->Length();
+        auto result = std::vector<svn::copy_source>();
+        for (uint32_t i = 0; i < length; i++) {
+            result.push_back(convert_copy_source(array->Get(i)));
+        }
+        return result;
+    }
 
-    return convert_array(value, true);
+    return std::vector<svn::copy_source>{convert_copy_source(value)};
 }
 
-static void buffer_free_pointer(char*, void* hint) {
-    delete static_cast<std::vector<char>*>(hint);
+template <class T>
+static void vector_free_pointer(char*, void* hint) {
+    delete static_cast<std::vector<T>*>(hint);
 }
 
-static v8::Local<v8::Object> buffer_from_vector(v8::Isolate* isolate, std::vector<char>& vector) {
-    auto pointer = new std::vector<char>(std::move(vector));
-    return node::Buffer::New(isolate,
-                             pointer->data(),
-                             pointer->size(),
-                             buffer_free_pointer,
-                             pointer)
-        .ToLocalChecked();
+// Hands the vector's storage to a typed array without copying it.
+template <class Array, class T>
+static v8::Local<Array> typed_array_from_vector(v8::Isolate* isolate, std::vector<T>& vector) {
+    auto length  = vector.size();
+    auto pointer = new std::vector<T>(std::move(vector));
+    auto buffer  = node::Buffer::New(isolate,
+                                    reinterpret_cast<char*>(pointer->data()),
+                                    length * sizeof(T),
+                                    vector_free_pointer<T>,
+                                    pointer)
+                      .ToLocalChecked();
+    return Array::New(buffer.template As<v8::Uint8Array>()->Buffer(), 0, length);
+}
+
+static auto convert_to_date(v8::Local<v8::Context>& context, int64_t value) {
+    auto d = static_cast<double>(value / 1000);
+    return v8::Date::New(context, d).ToLocalChecked();
 }
 
 #define STRINGIFY_INTERNAL(X) #X
@@ -337,16 +327,41 @@ void client::initialize(no::object& exports) {
     clazz.add_prototype_method("add", check_disposed(&client::add), 1);
     clazz.add_prototype_method("blame", check_disposed(&client::blame), 1);
     clazz.add_prototype_method("cat", check_disposed(&client::cat), 1);
+    clazz.add_prototype_method("cat_many", check_disposed(&client::cat_many), 1);
     clazz.add_prototype_method("checkout", check_disposed(&client::checkout), 1);
     clazz.add_prototype_method("cleanup", check_disposed(&client::cleanup), 1);
     clazz.add_prototype_method("commit", check_disposed(&client::commit), 2);
+    clazz.add_prototype_method("copy", check_disposed(&client::copy), 2);
+    clazz.add_prototype_method("get_blame_cache_metrics", check_disposed(&client::get_blame_cache_metrics), 0);
+    clazz.add_prototype_method("get_fetch_cache_metrics", check_disposed(&client::get_fetch_cache_metrics), 0);
+    clazz.add_prototype_method("get_inherited_properties_cache_metrics", check_disposed(&client::get_inherited_properties_cache_metrics), 0);
+    clazz.add_prototype_method("get_log_cache_metrics", check_disposed(&client::get_log_cache_metrics), 0);
+    clazz.add_prototype_method("history", check_disposed(&client::history), 1);
     clazz.add_prototype_method("info", check_disposed(&client::info), 1);
+    clazz.add_prototype_method("lock", check_disposed(&client::lock), 1);
+    clazz.add_prototype_method("location_segments", check_disposed(&client::location_segments), 1);
     clazz.add_prototype_method("log", check_disposed(&client::log), 1);
+    clazz.add_prototype_method("mergeinfo_log", check_disposed(&client::mergeinfo_log), 2);
+    clazz.add_prototype_method("move", check_disposed(&client::move), 2);
+    clazz.add_prototype_method("pristine", check_disposed(&client::pristine), 1);
+    clazz.add_prototype_method("propget", check_disposed(&client::propget), 2);
+    clazz.add_prototype_method("proplist", check_disposed(&client::proplist), 1);
     clazz.add_prototype_method("remove", check_disposed(&client::remove), 1);
     clazz.add_prototype_method("resolve", check_disposed(&client::resolve), 1);
     clazz.add_prototype_method("revert", check_disposed(&client::revert), 1);
+    clazz.add_prototype_method("search_log_cache", check_disposed(&client::search_log_cache), 1);
+    clazz.add_prototype_method("set_blame_cache", check_disposed(&client::set_blame_cache), 1);
+    clazz.add_prototype_method("set_fetch_cache", check_disposed(&client::set_fetch_cache), 1);
+    clazz.add_prototype_method("set_inherited_properties_cache_size", check_disposed(&client::set_inherited_properties_cache_size), 1);
+    clazz.add_prototype_method("set_log_cache", check_disposed(&client::set_log_cache), 1);
+    clazz.add_prototype_method("stat", check_disposed(&client::stat), 1);
     clazz.add_prototype_method("status", check_disposed(&client::status), 1);
+    clazz.add_prototype_method("status_changes", check_disposed(&client::status_changes), 2);
+    clazz.add_prototype_method("sync_log_cache", check_disposed(&client::sync_log_cache), 1);
+    clazz.add_prototype_method("unlock", check_disposed(&client::unlock), 1);
     clazz.add_prototype_method("update", check_disposed(&client::update), 1);
+    clazz.add_prototype_method("unwatch_status", check_disposed(&client::unwatch_status), 1);
+    clazz.add_prototype_method("watch_status", check_disposed(&client::watch_status), 1);
 
     clazz.add_prototype_method("get_working_copy_root", check_disposed(&client::get_working_copy_root), 1);
 
@@ -504,11 +519,17 @@ v8::Local<v8::Value> client::blame(const v8::FunctionCallbackInfo<v8::Value>& ar
 
     auto path = convert_string(args[0]);
 
-    auto options        = convert_options(args[1]);
+    auto options = convert_options(args[1]);
+    if (convert_bool(options, "compact", false)) {
+        return blame_compact(args);
+    }
+
     auto start_revision = convert_revision(options, "start_revision", svn::revision(0));
     auto end_revision   = convert_revision(options, "end_revision", svn::revision_kind::head);
     auto peg_revision   = convert_revision(options, "peg_revision", svn::revision_kind::unspecified);
 
+    auto include_merged_revisions = convert_bool(options, "include_merged_revisions", false);
+
     auto iterable = no::iterable::create(isolate, context);
 
     auto callback = [isolate, iterable](int32_t                start_revision,
@@ -535,13 +556,16 @@ v8::Local<v8::Value> client::blame(const v8::FunctionCallbackInfo<v8::Value>& ar
     };
 
     auto keep_alive = shared_from_this();
-    auto work       = [this, keep_alive, path, start_revision, end_revision, callback, peg_revision]() -> void {
+    auto work       = [this, keep_alive, path, start_revision, end_revision, callback, peg_revision, include_merged_revisions]() -> void {
         _client->blame(path,
                        start_revision,
                        end_revision,
                        uv::make_async(callback),
                        peg_revision,
-                       svn::diff_ignore_space::none);
+                       svn::diff_ignore_space::none,
+                       true,
+                       false,
+                       include_merged_revisions);
     };
 
     auto after_work = [isolate, iterable](std::future<void> future) -> void {
@@ -561,6 +585,142 @@ v8::Local<v8::Value> client::blame(const v8::FunctionCallbackInfo<v8::Value>& ar
     return iterable->get();
 }
 
+METHOD_BEGIN(blame_compact)
+    auto path = convert_string(args[0]);
+
+    auto options                  = convert_options(args[1]);
+    auto start_revision           = convert_revision(options, "start_revision", svn::revision(0));
+    auto end_revision             = convert_revision(options, "end_revision", svn::revision_kind::head);
+    auto peg_revision             = convert_revision(options, "peg_revision", svn::revision_kind::unspecified);
+    auto include_merged_revisions = convert_bool(options, "include_merged_revisions", false);
+
+    ASYNC_BEGIN(path, start_revision, end_revision, peg_revision, include_merged_revisions)
+        return _client->blame_compact(path,
+                                      start_revision,
+                                      end_revision,
+                                      peg_revision,
+                                      svn::diff_ignore_space::none,
+                                      true,
+                                      false,
+                                      include_merged_revisions);
+    ASYNC_END()
+
+    auto raw_result = ASYNC_RESULT;
+
+    auto revision_table = no::data<v8::Array>(isolate, static_cast<int>(raw_result.revision_table.size()));
+
+    uint32_t index = 0;
+    for (auto& raw : raw_result.revision_table) {
+        no::object item(isolate);
+        item["revision"] = raw.revision;
+        item["author"]   = raw.author;
+
+        if (raw.date) {
+            item["date"] = convert_to_date(context, *raw.date);
+        }
+
+        no::check_result(revision_table->Set(context, index, item));
+        index++;
+    }
+
+    no::object result(isolate);
+    result["content"]          = buffer_from_vector(isolate, raw_result.content);
+    result["line_offsets"]     = typed_array_from_vector<v8::Uint32Array>(isolate, raw_result.line_offsets);
+    result["revisions"]        = typed_array_from_vector<v8::Int32Array>(isolate, raw_result.revisions);
+    result["merged_revisions"] = typed_array_from_vector<v8::Int32Array>(isolate, raw_result.merged_revisions);
+    result["revision_table"]   = revision_table;
+METHOD_RETURN(result)
+
+METHOD_BEGIN(set_blame_cache)
+    std::optional<const std::string> directory;
+    if (!args[0]->IsUndefined()) {
+        directory.emplace(convert_string(args[0]));
+    }
+
+    auto options  = convert_options(args[1]);
+    auto max_size = convert_size(options, "max_size", 256 * 1024 * 1024);
+
+    ASYNC_BEGIN(directory, max_size)
+        _client->set_blame_cache(directory, max_size);
+    ASYNC_END()
+
+    ASYNC_RESULT;
+METHOD_RETURN(v8::Undefined(isolate))
+
+METHOD_BEGIN(get_blame_cache_metrics)
+    ASYNC_BEGIN()
+        return _client->get_blame_cache_metrics();
+    ASYNC_END()
+
+    auto raw_result = ASYNC_RESULT;
+
+    no::object result(isolate);
+    result["hits"]       = raw_result.hits;
+    result["misses"]     = raw_result.misses;
+    result["evictions"]  = raw_result.evictions;
+    result["entries"]    = raw_result.entries;
+    result["extensions"] = raw_result.extensions;
+METHOD_RETURN(result)
+
+METHOD_BEGIN(set_fetch_cache)
+    std::optional<const std::string> directory;
+    if (!args[0]->IsUndefined()) {
+        directory.emplace(convert_string(args[0]));
+    }
+
+    auto options  = convert_options(args[1]);
+    auto max_size = convert_size(options, "max_size", 1024 * 1024 * 1024);
+
+    ASYNC_BEGIN(directory, max_size)
+        _client->set_fetch_cache(directory, max_size);
+    ASYNC_END()
+
+    ASYNC_RESULT;
+METHOD_RETURN(v8::Undefined(isolate))
+
+METHOD_BEGIN(get_fetch_cache_metrics)
+    ASYNC_BEGIN()
+        return _client->get_fetch_cache_metrics();
+    ASYNC_END()
+
+    auto raw_result = ASYNC_RESULT;
+
+    no::object result(isolate);
+    result["hits"]          = raw_result.hits;
+    result["misses"]        = raw_result.misses;
+    result["bytes_served"]  = raw_result.bytes_served;
+    result["bytes_fetched"] = raw_result.bytes_fetched;
+    result["size"]          = raw_result.size;
+METHOD_RETURN(result)
+
+METHOD_BEGIN(set_inherited_properties_cache_size)
+    if (!args[0]->IsNumber() || args[0]->Int32Value() < 1) {
+        throw no::type_error("max_entries must be a positive number");
+    }
+
+    auto max_entries = static_cast<size_t>(args[0]->Int32Value());
+
+    ASYNC_BEGIN(max_entries)
+        _client->set_inherited_properties_cache_size(max_entries);
+    ASYNC_END()
+
+    ASYNC_RESULT;
+METHOD_RETURN(v8::Undefined(isolate))
+
+METHOD_BEGIN(get_inherited_properties_cache_metrics)
+    ASYNC_BEGIN()
+        return _client->get_inherited_properties_cache_metrics();
+    ASYNC_END()
+
+    auto raw_result = ASYNC_RESULT;
+
+    no::object result(isolate);
+    result["hits"]      = raw_result.hits;
+    result["misses"]    = raw_result.misses;
+    result["evictions"] = raw_result.evictions;
+    result["entries"]   = raw_result.entries;
+METHOD_RETURN(result)
+
 METHOD_BEGIN(cat)
     auto path = convert_string(args[0]);
 
@@ -584,6 +744,80 @@ METHOD_BEGIN(cat)
     result["properties"] = properties;
 METHOD_RETURN(result)
 
+static v8::Local<v8::Value> convert_cat_item(v8::Isolate* isolate, svn::cat_item& raw) {
+    no::object result(isolate);
+    result["path"] = raw.path;
+
+    if (raw.error) {
+        result["error"] = copy_error(isolate, *raw.error);
+        return result;
+    }
+
+    result["properties"] = convert_string_map(isolate, raw.properties);
+    result["content"]    = buffer_from_vector(isolate, raw.content);
+    return result;
+}
+
+v8::Local<v8::Value> client::cat_many(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto targets = convert_array(args[0], false);
+
+    auto options         = convert_options(args[1]);
+    auto peg_revision    = convert_revision(options, "peg_revision", svn::revision_kind::unspecified);
+    auto revision        = convert_revision(options, "revision", svn::revision_kind::unspecified);
+    auto expand_keywords = convert_bool(options, "expand_keywords", true);
+    // items hold whole files, keep batches small
+    auto batch_size = convert_number(options, "batch_size", 16);
+
+    auto keep_alive = shared_from_this();
+    auto raw_client = _client;
+    auto work       = [keep_alive, raw_client, targets, peg_revision, revision, expand_keywords](const std::function<void(svn::cat_item&)>& push) -> void {
+        raw_client->cat_many(targets, push, peg_revision, revision, expand_keywords);
+    };
+
+    return queue_iterable<svn::cat_item>(args.GetIsolate(), batch_size, work, convert_cat_item);
+}
+
+static void buffer_free_shared(char*, void* hint) {
+    delete static_cast<std::shared_ptr<const char>*>(hint);
+}
+
+static v8::Local<v8::Value> convert_pristine_item(v8::Isolate* isolate, svn::pristine_item& raw) {
+    no::object result(isolate);
+    result["path"] = raw.path;
+
+    if (raw.error) {
+        result["error"] = copy_error(isolate, *raw.error);
+        return result;
+    }
+
+    if (raw.content) {
+        // the buffer keeps the mapping alive
+        auto pointer      = new std::shared_ptr<const char>(std::move(raw.content));
+        result["content"] = node::Buffer::New(isolate,
+                                              const_cast<char*>(pointer->get()),
+                                              raw.content_size,
+                                              buffer_free_shared,
+                                              pointer)
+                                .ToLocalChecked();
+    }
+    return result;
+}
+
+v8::Local<v8::Value> client::pristine(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto paths = convert_array(args[0], false);
+
+    auto options    = convert_options(args[1]);
+    auto batch_size = convert_number(options, "batch_size", 64);
+
+    auto keep_alive = shared_from_this();
+    auto raw_client = _client;
+    auto work       = [keep_alive, raw_client, paths](const std::function<void(svn::pristine_item&)>& push) -> void {
+        raw_client->pristine(paths, push);
+    };
+
+    return queue_iterable<svn::pristine_item>(args.GetIsolate(), batch_size, work, convert_pristine_item);
+}
+
 METHOD_BEGIN(checkout)
     auto url  = convert_string(args[0]);
     auto path = convert_string(args[1]);
@@ -695,9 +929,44 @@ v8::Local<v8::Value> client::commit(const v8::FunctionCallbackInfo<v8::Value>& a
     return iterable->get();
 }
 
-static auto convert_to_date(v8::Local<v8::Context>& context, int64_t value) {
-    auto d = static_cast<double>(value / 1000);
-    return v8::Date::New(context, d).ToLocalChecked();
+v8::Local<v8::Value> client::copy(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto isolate = args.GetIsolate();
+    auto context = isolate->GetCurrentContext();
+
+    auto sources     = convert_copy_sources(args[0]);
+    auto destination = convert_string(args[1]);
+    auto message     = args[2]->IsUndefined() ? std::string() : convert_string(args[2]);
+
+    auto options          = convert_options(args[3]);
+    auto copy_as_child    = convert_bool(options, "copy_as_child", true);
+    auto make_parents     = convert_bool(options, "make_parents", false);
+    auto ignore_externals = convert_bool(options, "ignore_externals", false);
+    auto pin_externals    = convert_bool(options, "pin_externals", false);
+    auto revprops         = convert_string_map(options, "revprops");
+
+    auto iterable = no::iterable::create(isolate, context);
+    auto callback = convert_commit_callback(isolate, iterable);
+
+    auto keep_alive = shared_from_this();
+    auto work       = [this, keep_alive, sources, destination, message, callback, copy_as_child, make_parents, ignore_externals, pin_externals, revprops]() -> void {
+        _client->copy(sources, destination, message, callback, copy_as_child, make_parents, ignore_externals, pin_externals, revprops);
+    };
+
+    auto after_work = [isolate, iterable](std::future<void> future) -> void {
+        try {
+            future.get();
+            iterable->end();
+        } catch (const svn::svn_error& raw) {
+            v8::HandleScope scope(isolate);
+
+            auto error = copy_error(isolate, raw);
+            iterable->reject(error);
+        }
+    };
+
+    uv::queue_work(work, after_work);
+
+    return iterable->get();
 }
 
 v8::Local<v8::Value> client::info(const v8::FunctionCallbackInfo<v8::Value>& args) {
@@ -753,36 +1022,284 @@ v8::Local<v8::Value> client::info(const v8::FunctionCallbackInfo<v8::Value>& arg
     return iterable->get();
 }
 
-v8::Local<v8::Value> client::log(const v8::FunctionCallbackInfo<v8::Value>& args) {
-    auto isolate = args.GetIsolate();
-    auto context = isolate->GetCurrentContext();
+static v8::Local<v8::Value> convert_lock_result(v8::Isolate* isolate, const svn::lock_result& raw) {
+    auto context = isolate->GetEnteredContext();
 
+    no::object result(isolate);
+    result["path"]      = raw.path;
+    result["succeeded"] = raw.succeeded;
+
+    if (raw.token) {
+        result["token"]         = raw.token;
+        result["owner"]         = raw.owner;
+        result["comment"]       = raw.comment;
+        result["creation_date"] = convert_to_date(context, raw.creation_date);
+
+        if (raw.expiration_date != 0) {
+            result["expiration_date"] = convert_to_date(context, raw.expiration_date);
+        }
+    }
+
+    if (raw.error) {
+        result["error"] = copy_error(isolate, *raw.error);
+    }
+
+    return result;
+}
+
+v8::Local<v8::Value> client::lock(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto targets = convert_array(args[0], false);
+    auto comment = args[1]->IsUndefined() ? std::string() : convert_string(args[1]);
+
+    auto options    = convert_options(args[2]);
+    auto steal_lock = convert_bool(options, "steal_lock", false);
+    auto batch_size = convert_number(options, "batch_size", static_cast<int32_t>(no::default_batch_size));
+
+    auto keep_alive = shared_from_this();
+    auto raw_client = _client;
+    auto work       = [keep_alive, raw_client, targets, comment, steal_lock](const std::function<void(svn::lock_result&)>& push) -> void {
+        raw_client->lock(targets,
+                         comment,
+                         [&push](svn::lock_result item) -> void { push(item); },
+                         steal_lock);
+    };
+
+    return queue_iterable<svn::lock_result>(args.GetIsolate(), batch_size, work, convert_lock_result);
+}
+
+static v8::Local<v8::Value> convert_log_entry(v8::Isolate* isolate, const svn::log_entry& entry) {
+    auto context = isolate->GetEnteredContext();
+
+    no::object result(isolate);
+    result["revision"]          = entry.revision;
+    result["has_children"]      = entry.has_children;
+    result["non_inheritable"]   = entry.non_inheritable;
+    result["subtractive_merge"] = entry.subtractive_merge;
+    result["author"]            = entry.author;
+    result["message"]           = entry.message;
+
+    if (entry.date) {
+        result["date"] = convert_to_date(context, *entry.date);
+    }
+
+    if (entry.revprops) {
+        result["revprops"] = convert_string_map(isolate, *entry.revprops);
+    }
+
+    if (!entry.changed_paths.empty()) {
+        result["changed_paths"] = convert_changed_paths(isolate, entry.changed_paths);
+    }
+
+    return result;
+}
+
+static v8::Local<v8::Value> convert_history_item(v8::Isolate* isolate, const svn::history_item& item) {
+    no::object result(convert_log_entry(isolate, item.entry).As<v8::Object>());
+    result["path"] = item.path;
+    return result;
+}
+
+v8::Local<v8::Value> client::history(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto path = convert_string(args[0]);
+
+    auto options                = convert_options(args[1]);
+    auto peg_revision           = convert_revision(options, "peg_revision", svn::revision_kind::unspecified);
+    auto limit                  = convert_number(options, "limit", 0);
+    auto discover_changed_paths = convert_bool(options, "discover_changed_paths", false);
+    auto revprops               = convert_array(options, "revprops");
+    auto batch_size             = convert_number(options, "batch_size", static_cast<int32_t>(no::default_batch_size));
+
+    auto keep_alive = shared_from_this();
+    auto raw_client = _client;
+    auto work       = [keep_alive, raw_client, path, peg_revision, limit, discover_changed_paths, revprops](const std::function<void(svn::history_item&)>& push) -> void {
+        raw_client->history(path, push, peg_revision, limit, discover_changed_paths, revprops);
+    };
+
+    return queue_iterable<svn::history_item>(args.GetIsolate(), batch_size, work, convert_history_item);
+}
+
+METHOD_BEGIN(location_segments)
+    auto path = convert_string(args[0]);
+
+    auto options        = convert_options(args[1]);
+    auto peg_revision   = convert_revision(options, "peg_revision", svn::revision_kind::unspecified);
+    auto start_revision = convert_revision(options, "start_revision", svn::revision_kind::unspecified);
+    auto end_revision   = convert_revision(options, "end_revision", svn::revision_kind::unspecified);
+
+    ASYNC_BEGIN(path, peg_revision, start_revision, end_revision)
+        return _client->location_segments(path, peg_revision, start_revision, end_revision);
+    ASYNC_END()
+
+    auto raw_result = ASYNC_RESULT;
+
+    auto result = no::data<v8::Array>(isolate, static_cast<int>(raw_result.size()));
+
+    uint32_t index = 0;
+    for (auto& raw : raw_result) {
+        no::object item(isolate);
+        item["range_start"] = raw.range_start;
+        item["range_end"]   = raw.range_end;
+        item["path"]        = raw.path;
+
+        no::check_result(result->Set(context, index, item));
+        index++;
+    }
+METHOD_RETURN(result)
+
+v8::Local<v8::Value> client::log(const v8::FunctionCallbackInfo<v8::Value>& args) {
     auto paths = convert_array(args[0], false);
 
-    auto options         = convert_options(args[1]);
-    auto peg_revision    = convert_revision(options, "peg_revision", svn::revision_kind::unspecified);
-    auto revision_ranges = convert_revision_ranges(options, "revision_ranges");
-    auto limit           = convert_number(options, "limit", 0);
+    auto options                  = convert_options(args[1]);
+    auto peg_revision             = convert_revision(options, "peg_revision", svn::revision_kind::unspecified);
+    auto revision_ranges          = convert_revision_ranges(options, "revision_ranges");
+    auto limit                    = convert_number(options, "limit", 0);
+    auto discover_changed_paths   = convert_bool(options, "discover_changed_paths", false);
+    auto strict_node_history      = convert_bool(options, "strict_node_history", false);
+    auto include_merged_revisions = convert_bool(options, "include_merged_revisions", false);
+    auto revprops                 = convert_array(options, "revprops");
+    auto batch_size               = convert_number(options, "batch_size", static_cast<int32_t>(no::default_batch_size));
 
-    auto iterable = no::iterable::create(isolate, context);
+    auto keep_alive = shared_from_this();
+    auto raw_client = _client;
+    auto work       = [keep_alive, raw_client, paths, revision_ranges, limit, peg_revision, discover_changed_paths, strict_node_history, include_merged_revisions, revprops](const std::function<void(svn::log_entry&)>& push) -> void {
+        raw_client->log(paths,
+                        push,
+                        revision_ranges,
+                        limit,
+                        peg_revision,
+                        discover_changed_paths,
+                        strict_node_history,
+                        include_merged_revisions,
+                        revprops);
+    };
 
-    auto callback = [isolate, iterable](svn::log_entry& entry) -> uv::future<void> {
-        v8::HandleScope scope(isolate);
+    return queue_iterable<svn::log_entry>(args.GetIsolate(), batch_size, work, convert_log_entry);
+}
 
-        no::object result(isolate);
-        result["revision"]          = entry.revision;
-        result["non_inheritable"]   = entry.non_inheritable;
-        result["subtractive_merge"] = entry.subtractive_merge;
-        result["author"]            = entry.author;
-        result["date"]              = entry.date;
-        result["message"]           = entry.message;
+METHOD_BEGIN(search_log_cache)
+    auto url = convert_string(args[0]);
 
-        return iterable->yield(result);
+    auto options = convert_options(args[1]);
+
+    svn::log_query query{convert_optional_string(options, "author"),
+                         convert_optional_string(options, "message"),
+                         convert_optional_string(options, "path"),
+                         convert_optional_date(options, "date_from"),
+                         convert_optional_date(options, "date_to"),
+                         {},
+                         convert_bool(options, "discover_changed_paths", false)};
+
+    auto limit = convert_number(options, "limit", 0);
+    if (limit > 0) {
+        query.limit = limit;
+    }
+
+    ASYNC_BEGIN(url, query)
+        return _client->search_log_cache(url, query);
+    ASYNC_END()
+
+    auto raw_result = ASYNC_RESULT;
+
+    auto result = no::data<v8::Array>(isolate, static_cast<int>(raw_result.size()));
+
+    uint32_t index = 0;
+    for (auto& raw : raw_result) {
+        no::check_result(result->Set(context, index, convert_log_entry(isolate, raw)));
+        index++;
+    }
+METHOD_RETURN(result)
+
+METHOD_BEGIN(set_log_cache)
+    std::optional<const std::string> directory;
+    if (!args[0]->IsUndefined()) {
+        directory.emplace(convert_string(args[0]));
+    }
+
+    ASYNC_BEGIN(directory)
+        _client->set_log_cache(directory);
+    ASYNC_END()
+
+    ASYNC_RESULT;
+METHOD_RETURN(v8::Undefined(isolate))
+
+METHOD_BEGIN(get_log_cache_metrics)
+    ASYNC_BEGIN()
+        return _client->get_log_cache_metrics();
+    ASYNC_END()
+
+    auto raw_result = ASYNC_RESULT;
+
+    no::object result(isolate);
+    result["hits"]      = raw_result.hits;
+    result["misses"]    = raw_result.misses;
+    result["evictions"] = raw_result.evictions;
+    result["entries"]   = raw_result.entries;
+METHOD_RETURN(result)
+
+METHOD_BEGIN(sync_log_cache)
+    auto url = convert_string(args[0]);
+
+    ASYNC_BEGIN(url)
+        return _client->sync_log_cache(url);
+    ASYNC_END()
+
+    auto result = no::data(isolate, ASYNC_RESULT);
+METHOD_RETURN(result)
+
+v8::Local<v8::Value> client::mergeinfo_log(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto target = convert_string(args[0]);
+    auto source = convert_string(args[1]);
+
+    auto options                = convert_options(args[2]);
+    auto finding_merged         = convert_bool(options, "finding_merged", true);
+    auto target_peg_revision    = convert_revision(options, "target_peg_revision", svn::revision_kind::unspecified);
+    auto source_peg_revision    = convert_revision(options, "source_peg_revision", svn::revision_kind::unspecified);
+    auto source_start_revision  = convert_revision(options, "source_start_revision", svn::revision_kind::unspecified);
+    auto source_end_revision    = convert_revision(options, "source_end_revision", svn::revision_kind::unspecified);
+    auto discover_changed_paths = convert_bool(options, "discover_changed_paths", false);
+    auto depth                  = convert_depth(options, "depth", svn::depth::empty);
+    auto revprops               = convert_array(options, "revprops");
+    auto batch_size             = convert_number(options, "batch_size", static_cast<int32_t>(no::default_batch_size));
+
+    auto keep_alive = shared_from_this();
+    auto raw_client = _client;
+    auto work       = [keep_alive, raw_client, target, source, finding_merged, target_peg_revision, source_peg_revision, source_start_revision, source_end_revision, discover_changed_paths, depth, revprops](const std::function<void(svn::log_entry&)>& push) -> void {
+        raw_client->mergeinfo_log(target,
+                                  source,
+                                  push,
+                                  finding_merged,
+                                  target_peg_revision,
+                                  source_peg_revision,
+                                  source_start_revision,
+                                  source_end_revision,
+                                  discover_changed_paths,
+                                  depth,
+                                  revprops);
     };
 
+    return queue_iterable<svn::log_entry>(args.GetIsolate(), batch_size, work, convert_log_entry);
+}
+
+v8::Local<v8::Value> client::move(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto isolate = args.GetIsolate();
+    auto context = isolate->GetCurrentContext();
+
+    auto sources     = convert_array(args[0], false);
+    auto destination = convert_string(args[1]);
+    auto message     = args[2]->IsUndefined() ? std::string() : convert_string(args[2]);
+
+    auto options               = convert_options(args[3]);
+    auto move_as_child         = convert_bool(options, "move_as_child", true);
+    auto make_parents          = convert_bool(options, "make_parents", false);
+    auto allow_mixed_revisions = convert_bool(options, "allow_mixed_revisions", true);
+    auto revprops              = convert_string_map(options, "revprops");
+
+    auto iterable = no::iterable::create(isolate, context);
+    auto callback = convert_commit_callback(isolate, iterable);
+
     auto keep_alive = shared_from_this();
-    auto work       = [this, keep_alive, paths, callback, revision_ranges, limit, peg_revision]() -> void {
-        _client->log(paths, uv::make_async(callback), revision_ranges, limit, peg_revision, false, false, false, {});
+    auto work       = [this, keep_alive, sources, destination, message, callback, move_as_child, make_parents, allow_mixed_revisions, revprops]() -> void {
+        _client->move(sources, destination, message, callback, move_as_child, make_parents, allow_mixed_revisions, revprops);
     };
 
     auto after_work = [isolate, iterable](std::future<void> future) -> void {
@@ -802,6 +1319,85 @@ v8::Local<v8::Value> client::log(const v8::FunctionCallbackInfo<v8::Value>& args
     return iterable->get();
 }
 
+static v8::Local<v8::Value> convert_property_item(v8::Isolate* isolate, const svn::property_item& raw) {
+    no::object result(isolate);
+    result["path"]       = raw.path;
+    result["properties"] = convert_string_map(isolate, raw.properties);
+
+    if (raw.inherited_properties) {
+        auto context   = isolate->GetEnteredContext();
+        auto inherited = no::data<v8::Array>(isolate, static_cast<int>(raw.inherited_properties->size()));
+
+        uint32_t index = 0;
+        for (auto& raw_item : *raw.inherited_properties) {
+            no::object item(isolate);
+            item["path"]       = raw_item.path_or_url;
+            item["properties"] = convert_string_map(isolate, raw_item.properties);
+
+            no::check_result(inherited->Set(context, index, item));
+            index++;
+        }
+
+        result["inherited_properties"] = inherited;
+    }
+
+    return result;
+}
+
+v8::Local<v8::Value> client::propget(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto name    = convert_string(args[0]);
+    auto targets = convert_array(args[1], false);
+
+    auto options             = convert_options(args[2]);
+    auto peg_revision        = convert_revision(options, "peg_revision", svn::revision_kind::unspecified);
+    auto revision            = convert_revision(options, "revision", svn::revision_kind::unspecified);
+    auto depth               = convert_depth(options, "depth", svn::depth::empty);
+    auto get_inherited_props = convert_bool(options, "get_inherited_props", false);
+    auto changelists         = convert_array(options, "changelists");
+    auto batch_size          = convert_number(options, "batch_size", static_cast<int32_t>(no::default_batch_size));
+
+    auto keep_alive = shared_from_this();
+    auto raw_client = _client;
+    auto work       = [keep_alive, raw_client, name, targets, peg_revision, revision, depth, get_inherited_props, changelists](const std::function<void(svn::property_item&)>& push) -> void {
+        raw_client->propget(name,
+                            targets,
+                            [&push](svn::property_item item) -> void { push(item); },
+                            peg_revision,
+                            revision,
+                            depth,
+                            get_inherited_props,
+                            changelists);
+    };
+
+    return queue_iterable<svn::property_item>(args.GetIsolate(), batch_size, work, convert_property_item);
+}
+
+v8::Local<v8::Value> client::proplist(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto targets = convert_array(args[0], false);
+
+    auto options             = convert_options(args[1]);
+    auto peg_revision        = convert_revision(options, "peg_revision", svn::revision_kind::unspecified);
+    auto revision            = convert_revision(options, "revision", svn::revision_kind::unspecified);
+    auto depth               = convert_depth(options, "depth", svn::depth::empty);
+    auto get_inherited_props = convert_bool(options, "get_inherited_props", false);
+    auto changelists         = convert_array(options, "changelists");
+    auto batch_size          = convert_number(options, "batch_size", static_cast<int32_t>(no::default_batch_size));
+
+    auto keep_alive = shared_from_this();
+    auto raw_client = _client;
+    auto work       = [keep_alive, raw_client, targets, peg_revision, revision, depth, get_inherited_props, changelists](const std::function<void(svn::property_item&)>& push) -> void {
+        raw_client->proplist(targets,
+                             [&push](svn::property_item item) -> void { push(item); },
+                             peg_revision,
+                             revision,
+                             depth,
+                             get_inherited_props,
+                             changelists);
+    };
+
+    return queue_iterable<svn::property_item>(args.GetIsolate(), batch_size, work, convert_property_item);
+}
+
 v8::Local<v8::Value> client::remove(const v8::FunctionCallbackInfo<v8::Value>& args) {
     auto isolate = args.GetIsolate();
     auto context = isolate->GetCurrentContext();
@@ -857,16 +1453,65 @@ METHOD_BEGIN(revert)
     ASYNC_RESULT;
 METHOD_RETURN(v8::Undefined(isolate));
 
+static v8::Local<v8::Value> convert_stat_item(v8::Isolate* isolate, const svn::stat_item& raw) {
+    auto context = isolate->GetEnteredContext();
+
+    no::object result(isolate);
+    result["path"] = raw.path;
+    result["kind"] = static_cast<int32_t>(raw.kind);
+
+    if (raw.error) {
+        result["error"] = copy_error(isolate, *raw.error);
+        return result;
+    }
+
+    if (raw.kind != svn::node_kind::none) {
+        result["size"]        = raw.size;
+        result["created_rev"] = raw.created_rev;
+        result["time"]        = convert_to_date(context, raw.time);
+        result["last_author"] = raw.last_author;
+    }
+
+    return result;
+}
+
+v8::Local<v8::Value> client::stat(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto urls = convert_array(args[0], false);
+
+    auto options    = convert_options(args[1]);
+    auto revision   = convert_revision(options, "revision", svn::revision_kind::head);
+    auto batch_size = convert_number(options, "batch_size", static_cast<int32_t>(no::default_batch_size));
+
+    auto keep_alive = shared_from_this();
+    auto raw_client = _client;
+    auto work       = [keep_alive, raw_client, urls, revision](const std::function<void(svn::stat_item&)>& push) -> void {
+        raw_client->stat(urls, [&push](svn::stat_item item) -> void { push(item); }, revision);
+    };
+
+    return queue_iterable<svn::stat_item>(args.GetIsolate(), batch_size, work, convert_stat_item);
+}
+
 v8::Local<v8::Value> client::status(const v8::FunctionCallbackInfo<v8::Value>& args) {
     auto isolate = args.GetIsolate();
     auto context = isolate->GetCurrentContext();
 
     auto path = convert_string(args[0]);
 
-    auto options          = convert_options(args[1]);
-    auto revision         = convert_revision(options, "revision", svn::revision_kind::working);
-    auto depth            = convert_depth(options, "depth", svn::depth::infinity);
-    auto ignore_externals = convert_bool(options, "ignore_externals", false);
+    auto options            = convert_options(args[1]);
+    auto revision           = convert_revision(options, "revision", svn::revision_kind::working);
+    auto depth              = convert_depth(options, "depth", svn::depth::infinity);
+    auto get_all            = convert_bool(options, "get_all", false);
+    auto check_out_of_date  = convert_bool(options, "check_out_of_date", false);
+    auto check_working_copy = convert_bool(options, "check_working_copy", true);
+    auto no_ignore          = convert_bool(options, "no_ignore", false);
+    auto ignore_externals   = convert_bool(options, "ignore_externals", false);
+    auto depth_as_sticky    = convert_bool(options, "depth_as_sticky", false);
+    auto changelists        = convert_array(options, "changelists");
+
+    svn::status_filter filter{convert_status_kinds(options, "node_status_in"),
+                              convert_array(options, "path_prefixes"),
+                              convert_array(options, "exclude_globs"),
+                              convert_bool(options, "only_conflicted", false)};
 
     auto iterable = no::iterable::create(isolate, context);
     auto callback = [isolate, iterable](const std::string& path, const svn::status& raw_status) -> uv::future<void> {
@@ -895,8 +1540,19 @@ v8::Local<v8::Value> client::status(const v8::FunctionCallbackInfo<v8::Value>& a
     };
 
     auto keep_alive = shared_from_this();
-    auto work       = [this, keep_alive, path, callback, revision, depth, ignore_externals]() -> void {
-        _client->status(path, uv::make_async(callback), revision, depth, false, false, true, false, ignore_externals);
+    auto work       = [this, keep_alive, path, callback, revision, depth, get_all, check_out_of_date, check_working_copy, no_ignore, ignore_externals, depth_as_sticky, changelists, filter]() -> void {
+        _client->status(path,
+                        uv::make_async(callback),
+                        revision,
+                        depth,
+                        get_all,
+                        check_out_of_date,
+                        check_working_copy,
+                        no_ignore,
+                        ignore_externals,
+                        depth_as_sticky,
+                        changelists,
+                        filter);
     };
 
     auto after_work = [isolate, iterable](std::future<void> future) -> void {
@@ -916,6 +1572,86 @@ v8::Local<v8::Value> client::status(const v8::FunctionCallbackInfo<v8::Value>& a
     return iterable->get();
 }
 
+static v8::Local<v8::Value> convert_status_entry(v8::Isolate* isolate, const svn::status_entry& raw_status) {
+    auto context = isolate->GetEnteredContext();
+
+    no::object result(isolate);
+    result["path"]           = raw_status.path;
+    result["changelist"]     = raw_status.changelist;
+    result["changed_author"] = raw_status.changed_author;
+    result["changed_date"]   = convert_to_date(context, raw_status.changed_date);
+    result["changed_rev"]    = raw_status.changed_rev;
+    result["conflicted"]     = raw_status.conflicted;
+    result["copied"]         = raw_status.copied;
+    result["depth"]          = static_cast<int32_t>(raw_status.node_depth);
+    result["file_external"]  = raw_status.file_external;
+    result["kind"]           = static_cast<int32_t>(raw_status.kind);
+    result["node_status"]    = static_cast<int32_t>(raw_status.node_status);
+    result["prop_status"]    = static_cast<int32_t>(raw_status.prop_status);
+    result["revision"]       = raw_status.revision;
+    result["text_status"]    = static_cast<int32_t>(raw_status.text_status);
+    result["versioned"]      = raw_status.versioned;
+    return result;
+}
+
+static v8::Local<v8::Value> convert_status_changes(v8::Isolate* isolate, const svn::status_watcher::changes& raw) {
+    auto context = isolate->GetEnteredContext();
+
+    auto changed = no::data<v8::Array>(isolate, static_cast<int>(raw.changed.size()));
+    for (uint32_t i = 0; i < raw.changed.size(); i++) {
+        no::check_result(changed->Set(context, i, convert_status_entry(isolate, raw.changed[i])));
+    }
+
+    auto removed = no::data<v8::Array>(isolate, static_cast<int>(raw.removed.size()));
+    for (uint32_t i = 0; i < raw.removed.size(); i++) {
+        no::check_result(removed->Set(context, i, no::data(isolate, raw.removed[i])));
+    }
+
+    no::object result(isolate);
+    result["generation"] = raw.generation;
+    result["reset"]      = raw.reset;
+    result["changed"]    = changed;
+    result["removed"]    = removed;
+    return result;
+}
+
+METHOD_BEGIN(status_changes)
+    auto path = svn::status_watcher::canonicalize(convert_string(args[0]));
+
+    int64_t since = 0;
+    if (args[1]->IsNumber()) {
+        since = static_cast<int64_t>(args[1].As<v8::Number>()->Value());
+    }
+
+    auto entry = _status_watchers.find(path);
+    if (entry == _status_watchers.end()) {
+        throw no::type_error("the path is not watched, call watch_status first");
+    }
+    auto watcher = entry->second;
+
+    ASYNC_BEGIN(watcher, since)
+        return watcher->get_changes(since);
+    ASYNC_END()
+
+    auto result = convert_status_changes(isolate, ASYNC_RESULT);
+METHOD_RETURN(result)
+
+v8::Local<v8::Value> client::unlock(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto targets = convert_array(args[0], false);
+
+    auto options    = convert_options(args[1]);
+    auto break_lock = convert_bool(options, "break_lock", false);
+    auto batch_size = convert_number(options, "batch_size", static_cast<int32_t>(no::default_batch_size));
+
+    auto keep_alive = shared_from_this();
+    auto raw_client = _client;
+    auto work       = [keep_alive, raw_client, targets, break_lock](const std::function<void(svn::lock_result&)>& push) -> void {
+        raw_client->unlock(targets, [&push](svn::lock_result item) -> void { push(item); }, break_lock);
+    };
+
+    return queue_iterable<svn::lock_result>(args.GetIsolate(), batch_size, work, convert_lock_result);
+}
+
 v8::Local<v8::Value> client::update(const v8::FunctionCallbackInfo<v8::Value>& args) {
     auto isolate = args.GetIsolate();
     auto context = isolate->GetCurrentContext();
@@ -959,6 +1695,35 @@ v8::Local<v8::Value> client::update(const v8::FunctionCallbackInfo<v8::Value>& a
     return iterable->get();
 }
 
+v8::Local<v8::Value> client::unwatch_status(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto path = svn::status_watcher::canonicalize(convert_string(args[0]));
+    _status_watchers.erase(path);
+    return v8::Local<v8::Value>();
+}
+
+METHOD_BEGIN(watch_status)
+    auto path = convert_string(args[0]);
+    auto key  = svn::status_watcher::canonicalize(path);
+    auto self = shared_from_this();
+
+    std::shared_ptr<const svn::client> raw_client = _client;
+
+    ASYNC_BEGIN(raw_client, path)
+        auto watcher = std::make_shared<svn::status_watcher>(raw_client, path);
+        auto changes = watcher->get_changes(0);
+        return std::make_pair(watcher, changes);
+    ASYNC_END(self, key)
+
+    auto raw_result = ASYNC_RESULT;
+
+    // disposed while the initial status was running
+    if (self->_client != nullptr) {
+        self->_status_watchers[key] = raw_result.first;
+    }
+
+    auto result = convert_status_changes(isolate, raw_result.second);
+METHOD_RETURN(result)
+
 METHOD_BEGIN(get_working_copy_root)
     auto path = convert_string(args[0]);
 
@@ -970,6 +1735,7 @@ METHOD_BEGIN(get_working_copy_root)
 METHOD_RETURN(result);
 
 v8::Local<v8::Value> client::dispose(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    _status_watchers.clear();
     _client = nullptr;
     return v8::Local<v8::Value>();
 }
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <map>
+#include <memory>
+#include <string>
+
 #include <node/auth/simple.hpp>
 #include <objects/object.hpp>
 
 namespace svn {
 class client;
+class status_watcher;
 }
 
 namespace no {
@@ -33,17 +38,43 @@ class client : public std::enable_shared_from_this<client> {
 
     v8::Local<v8::Value> add(const v8::FunctionCallbackInfo<v8::Value>& args);
     v8::Local<v8::Value> blame(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> blame_compact(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> set_blame_cache(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> get_blame_cache_metrics(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> set_fetch_cache(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> get_fetch_cache_metrics(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> set_inherited_properties_cache_size(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> get_inherited_properties_cache_metrics(const v8::FunctionCallbackInfo<v8::Value>& args);
     v8::Local<v8::Value> cat(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> cat_many(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> pristine(const v8::FunctionCallbackInfo<v8::Value>& args);
     v8::Local<v8::Value> checkout(const v8::FunctionCallbackInfo<v8::Value>& args);
     v8::Local<v8::Value> cleanup(const v8::FunctionCallbackInfo<v8::Value>& args);
     v8::Local<v8::Value> commit(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> copy(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> history(const v8::FunctionCallbackInfo<v8::Value>& args);
     v8::Local<v8::Value> info(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> lock(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> location_segments(const v8::FunctionCallbackInfo<v8::Value>& args);
     v8::Local<v8::Value> log(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> search_log_cache(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> set_log_cache(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> get_log_cache_metrics(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> sync_log_cache(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> mergeinfo_log(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> move(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> propget(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> proplist(const v8::FunctionCallbackInfo<v8::Value>& args);
     v8::Local<v8::Value> remove(const v8::FunctionCallbackInfo<v8::Value>& args);
     v8::Local<v8::Value> resolve(const v8::FunctionCallbackInfo<v8::Value>& args);
     v8::Local<v8::Value> revert(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> stat(const v8::FunctionCallbackInfo<v8::Value>& args);
     v8::Local<v8::Value> status(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> status_changes(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> unlock(const v8::FunctionCallbackInfo<v8::Value>& args);
     v8::Local<v8::Value> update(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> unwatch_status(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> watch_status(const v8::FunctionCallbackInfo<v8::Value>& args);
 
     v8::Local<v8::Value> get_working_copy_root(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -60,7 +91,11 @@ class client : public std::enable_shared_from_this<client> {
         };
     }
 
-    std::unique_ptr<svn::client> _client;
+    // shared with the status watchers, which may outlive `dispose`
+    std::shared_ptr<svn::client> _client;
     no::simple_auth_provider     _simple_auth_provider;
+
+    // keyed by `svn::status_watcher::canonicalize`
+    std::map<std::string, std::shared_ptr<svn::status_watcher>> _status_watchers;
 };
 } // namespace no
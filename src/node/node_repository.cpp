@@ -0,0 +1,178 @@
+#include "node_repository.hpp"
+
+#include <cpp/repos.hpp>
+
+#include <node/async.hpp>
+#include <node/type_conversion.hpp>
+
+#include <objects/class_builder.hpp>
+
+// Omitted revisions stand for the youngest one.
+static int32_t convert_revision_number(const v8::Local<v8::Value>& value) {
+    if (value->IsUndefined()) {
+        return -1;
+    }
+
+    if (value->IsNumber()) {
+        return value->Int32Value();
+    }
+
+    throw no::type_error("");
+}
+
+static v8::Local<v8::Value> convert_dirent(v8::Isolate* isolate, svn::repos_dirent& raw) {
+    no::object result(isolate);
+    result["path"]        = raw.path;
+    result["kind"]        = static_cast<int32_t>(raw.kind);
+    result["created_rev"] = raw.created_rev;
+    if (raw.kind == svn::node_kind::file) {
+        result["size"] = raw.size;
+    }
+    return result;
+}
+
+static v8::Local<v8::Value> convert_chunk(v8::Isolate* isolate, std::vector<char>& raw) {
+    return buffer_from_vector(isolate, raw);
+}
+
+static v8::Local<v8::Value> convert_location(v8::Isolate* isolate, svn::repos_location& raw) {
+    no::object result(isolate);
+    result["path"]     = raw.path;
+    result["revision"] = raw.revision;
+    return result;
+}
+
+namespace no {
+void repository::initialize(no::object& exports) {
+    v8::HandleScope scope(exports.isolate());
+
+    class_builder<repository> clazz(exports.isolate(), "Repository", constructor);
+    clazz.add_prototype_method("cat", &repository::cat, 2);
+    clazz.add_prototype_method("changed_paths", &repository::changed_paths, 1);
+    clazz.add_prototype_method("history", &repository::history, 1);
+    clazz.add_prototype_method("proplist", &repository::proplist, 2);
+    clazz.add_prototype_method("revision_proplist", &repository::revision_proplist, 1);
+    clazz.add_prototype_method("tree", &repository::tree, 2);
+    clazz.add_prototype_method("youngest", &repository::youngest, 0);
+
+    _initializer.Reset(exports.isolate(), clazz.get_constructor());
+}
+
+v8::Local<v8::Value> repository::create(v8::Isolate* isolate, std::shared_ptr<svn::repos> repos) {
+    auto context = isolate->GetCurrentContext();
+
+    const auto           argc       = 1;
+    v8::Local<v8::Value> argv[argc] = {no::data(isolate, &repos)};
+
+    return _initializer.Get(isolate)->NewInstance(context, argc, argv).ToLocalChecked();
+}
+
+repository::repository(std::shared_ptr<svn::repos> repos)
+    : _repos(std::move(repos)) {
+}
+
+std::shared_ptr<repository> repository::constructor(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    if (!args[0]->IsExternal()) {
+        throw no::type_error("use repos.open");
+    }
+
+    auto repos = static_cast<std::shared_ptr<svn::repos>*>(args[0].As<v8::External>()->Value());
+    return std::shared_ptr<repository>(new repository(*repos));
+}
+
+v8::Local<v8::Value> repository::youngest(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto repos = _repos;
+
+    return queue_promise(
+        args.GetIsolate(),
+        [repos]() -> int32_t { return repos->youngest(); },
+        [](v8::Isolate* isolate, int32_t result) -> v8::Local<v8::Value> { return no::data(isolate, result); });
+}
+
+v8::Local<v8::Value> repository::tree(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto revision = convert_revision_number(args[0]);
+    auto path     = args[1]->IsUndefined() ? std::string() : convert_string(args[1]);
+
+    auto options    = convert_options(args[2]);
+    auto recursive  = convert_bool(options, "recursive", false);
+    auto batch_size = convert_number(options, "batch_size", static_cast<int32_t>(no::default_batch_size));
+
+    auto repos = _repos;
+    auto work  = [repos, revision, path, recursive](const std::function<void(svn::repos_dirent&)>& push) -> void {
+        repos->tree(revision, path, recursive, push);
+    };
+
+    return queue_iterable<svn::repos_dirent>(args.GetIsolate(), batch_size, work, convert_dirent);
+}
+
+v8::Local<v8::Value> repository::cat(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto revision = convert_revision_number(args[0]);
+    auto path     = convert_string(args[1]);
+
+    auto repos = _repos;
+    auto work  = [repos, revision, path](const std::function<void(std::vector<char>&)>& push) -> void {
+        repos->cat(revision, path, [&push](const char* data, size_t length) -> void {
+            std::vector<char> chunk(data, data + length);
+            push(chunk);
+        });
+    };
+
+    // chunks are 64 KiB, yield them one by one
+    return queue_iterable<std::vector<char>>(args.GetIsolate(), 1, work, convert_chunk);
+}
+
+v8::Local<v8::Value> repository::changed_paths(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto revision = convert_revision_number(args[0]);
+
+    auto repos = _repos;
+
+    return queue_promise(
+        args.GetIsolate(),
+        [repos, revision]() -> std::map<std::string, svn::log_changed_path> { return repos->changed_paths(revision); },
+        [](v8::Isolate* isolate, const std::map<std::string, svn::log_changed_path>& result) -> v8::Local<v8::Value> {
+            return convert_changed_paths(isolate, result);
+        });
+}
+
+v8::Local<v8::Value> repository::proplist(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto revision = convert_revision_number(args[0]);
+    auto path     = convert_string(args[1]);
+
+    auto repos = _repos;
+
+    return queue_promise(
+        args.GetIsolate(),
+        [repos, revision, path]() -> svn::string_map { return repos->proplist(revision, path); },
+        [](v8::Isolate* isolate, const svn::string_map& result) -> v8::Local<v8::Value> {
+            return convert_string_map(isolate, result);
+        });
+}
+
+v8::Local<v8::Value> repository::revision_proplist(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto revision = convert_revision_number(args[0]);
+
+    auto repos = _repos;
+
+    return queue_promise(
+        args.GetIsolate(),
+        [repos, revision]() -> svn::string_map { return repos->revision_proplist(revision); },
+        [](v8::Isolate* isolate, const svn::string_map& result) -> v8::Local<v8::Value> {
+            return convert_string_map(isolate, result);
+        });
+}
+
+v8::Local<v8::Value> repository::history(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto path = convert_string(args[0]);
+
+    auto options    = convert_options(args[1]);
+    auto revision   = options.has_value() ? convert_revision_number(options.value()["revision"]) : -1;
+    auto batch_size = convert_number(options, "batch_size", static_cast<int32_t>(no::default_batch_size));
+
+    auto repos = _repos;
+    auto work  = [repos, revision, path](const std::function<void(svn::repos_location&)>& push) -> void {
+        repos->history(revision, path, push);
+    };
+
+    return queue_iterable<svn::repos_location>(args.GetIsolate(), batch_size, work, convert_location);
+}
+} // namespace no
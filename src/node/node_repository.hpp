@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+
+#include <objects/object.hpp>
+
+namespace svn {
+class repos;
+}
+
+namespace no {
+// A repository opened by `repos.open`, shares the `svn::repos` handle with
+// every other object opened on the same path.
+class repository : public std::enable_shared_from_this<repository> {
+  public:
+    static void initialize(no::object& exports);
+
+    static v8::Local<v8::Value> create(v8::Isolate* isolate, std::shared_ptr<svn::repos> repos);
+
+    repository(const repository&) = delete;
+    repository(repository&&)      = delete;
+
+  private:
+    explicit repository(std::shared_ptr<svn::repos> repos);
+
+    static std::shared_ptr<repository> constructor(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+    v8::Local<v8::Value> youngest(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> tree(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> cat(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> changed_paths(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> proplist(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> revision_proplist(const v8::FunctionCallbackInfo<v8::Value>& args);
+    v8::Local<v8::Value> history(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+    static inline v8::Global<v8::Function> _initializer;
+
+    std::shared_ptr<svn::repos> _repos;
+};
+} // namespace no
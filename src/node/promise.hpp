@@ -0,0 +1,58 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+
+#include <node/v8.hpp>
+
+namespace no {
+namespace promise {
+template <class T>
+using ThenCallback = std::function<T(v8::Isolate*, const v8::Local<v8::Value>& value)>;
+
+template <class T>
+struct then_data {
+    ThenCallback<T> then_callback;
+    ThenCallback<T> catch_callback;
+    std::promise<T> promise;
+};
+
+template <class T, bool Fulfilled>
+static void invoke_callback(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto isolate = args.GetIsolate();
+
+    // only one of the handlers runs, it frees the data of both
+    auto data = std::unique_ptr<then_data<T>>(static_cast<then_data<T>*>(args.Data().As<v8::External>()->Value()));
+
+    auto& callback = Fulfilled ? data->then_callback : data->catch_callback;
+    try {
+        data->promise.set_value(callback(isolate, args[0]));
+    } catch (...) {
+        data->promise.set_exception(std::current_exception());
+    }
+}
+
+template <class T>
+static std::future<T> then(v8::Isolate*                  isolate,
+                           const v8::Local<v8::Promise>& promise,
+                           ThenCallback<T>               then_callback,
+                           ThenCallback<T>               catch_callback) {
+    auto data   = new then_data<T>{std::move(then_callback), std::move(catch_callback)};
+    auto future = data->promise.get_future();
+
+    auto context  = isolate->GetEnteredContext();
+    auto external = no::data(isolate, data);
+
+    auto on_fulfilled = v8::Function::New(context, invoke_callback<T, true>, external).ToLocalChecked();
+    auto on_rejected  = v8::Function::New(context, invoke_callback<T, false>, external).ToLocalChecked();
+
+    // the V8 of older runtimes has no `Then` taking both handlers. A rejection
+    // passes through the promise derived by `Then` to `on_rejected`, which
+    // never throws, so nothing in the chain is left unhandled.
+    promise->Then(context, on_fulfilled).ToLocalChecked()->Catch(context, on_rejected).ToLocalChecked();
+
+    return future;
+}
+} // namespace promise
+} // namespace no
@@ -1,34 +1,655 @@
 #pragma once
 
-#include <svn_repos.h>
-#include <svn_hash.h>
-
 #include <node.h>
+#include <node_buffer.h>
+
+#include <svn_error_codes.h>
+
+#include <uv/async.hpp>
+#include <uv/future.hpp>
 
+#include <cpp/repos.hpp>
+
+#include <node/abort_signal.hpp>
+#include <node/async.hpp>
+#include <node/invoke.hpp>
+#include <node/node_repository.hpp>
+#include <node/promise.hpp>
 #include <node/type_conversion.hpp>
 #include <node/v8.hpp>
 
+#include <objects/object.hpp>
+
 namespace no {
 namespace repos {
-static void create_repos(const v8::FunctionCallbackInfo<v8::Value>& args) {
+static svn::repos::abort_function convert_signal(v8::Isolate* isolate, std::optional<no::object>& options) {
+    if (!options.has_value()) {
+        return {};
+    }
+
+    return abort_signal::watch(isolate, options.value()["signal"]);
+}
+
+static svn::repos_create_options convert_create_options(const v8::Local<v8::Value>& value) {
+    auto options = convert_options(value);
+
+    svn::repos_create_options result;
+    result.fs_type            = convert_optional_string(options, "fs_type").value_or("fsfs");
+    result.compression        = convert_optional_string(options, "compression");
+    result.compatible_version = convert_optional_string(options, "compatible_version");
+    if (options.has_value() && !options.value()["shard_size"]->IsUndefined()) {
+        result.shard_size = convert_number(options, "shard_size", 0);
+    }
+    return result;
+}
+
+static v8::Local<v8::Value> create(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto path    = convert_string(args[0]);
+    auto options = convert_create_options(args[1]);
+
+    return queue_promise(args.GetIsolate(), [path, options]() -> void { svn::repos::create(path, options); });
+}
+
+static v8::Local<v8::Value> open(const v8::FunctionCallbackInfo<v8::Value>& args) {
     auto path = convert_string(args[0]);
 
-    apr_initialize();
+    return queue_promise(
+        args.GetIsolate(),
+        [path]() -> std::shared_ptr<svn::repos> { return svn::repos::open(path); },
+        [](v8::Isolate* isolate, std::shared_ptr<svn::repos> result) -> v8::Local<v8::Value> {
+            return repository::create(isolate, std::move(result));
+        });
+}
+
+static v8::Local<v8::Value> hotcopy(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto isolate = args.GetIsolate();
+
+    auto source      = convert_string(args[0]);
+    auto destination = convert_string(args[1]);
+
+    auto options = convert_options(args[2]);
+
+    svn::repos_hotcopy_options hotcopy_options;
+    hotcopy_options.incremental              = convert_bool(options, "incremental", false);
+    hotcopy_options.clean_logs               = convert_bool(options, "clean_logs", false);
+    hotcopy_options.rate_limit_bytes_per_sec = convert_number(options, "rate_limit_bytes_per_sec", 0);
+
+    auto abort = convert_signal(isolate, options);
 
-    apr_pool_t* pool;
-    apr_pool_create_ex(&pool, nullptr, nullptr, nullptr);
+    auto work = [source, destination, hotcopy_options, abort](const svn::repos::hotcopy_callback& callback) -> void {
+        svn::repos::hotcopy(source, destination, hotcopy_options, callback, abort);
+    };
 
-    apr_hash_t* fs_config = apr_hash_make(pool);
-    svn_hash_sets(fs_config, SVN_FS_CONFIG_COMPATIBLE_VERSION, "1.9");
+    auto convert = [](v8::Isolate* isolate, svn::repos_hotcopy_progress& item) -> v8::Local<v8::Value> {
+        no::object result(isolate);
+        result["start_revision"] = item.start_revision;
+        result["end_revision"]   = item.end_revision;
+        result["bytes"]          = item.bytes;
+        return result;
+    };
 
-    svn_repos_t* repos;
-    svn_repos_create(&repos, path.c_str(), nullptr, nullptr, nullptr, fs_config, pool);
+    return queue_progress<svn::repos_hotcopy_progress>(isolate, work, convert);
+}
+
+static v8::Local<v8::Value> pack(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto isolate = args.GetIsolate();
+
+    auto path    = convert_string(args[0]);
+    auto options = convert_options(args[1]);
+
+    svn::repos_pack_options pack_options;
+    pack_options.shards_per_run = convert_number(options, "shards_per_run", 0);
+
+    auto abort = convert_signal(isolate, options);
+
+    auto work = [path, pack_options, abort](const svn::repos::pack_callback& callback) -> void {
+        svn::repos::pack(path, pack_options, callback, abort);
+    };
+
+    auto convert = [](v8::Isolate* isolate, svn::repos_pack_progress& item) -> v8::Local<v8::Value> {
+        no::object result(isolate);
+        result["action"] = item.action;
+        result["shard"]  = item.shard;
+        return result;
+    };
+
+    return queue_progress<svn::repos_pack_progress>(isolate, work, convert);
+}
+
+// Sizes of whole repositories easily exceed 32 bits, they are exact as
+// doubles up to 2^53.
+static v8::Local<v8::Value> convert_size(v8::Isolate* isolate, int64_t value) {
+    return no::data(isolate, static_cast<double>(value));
+}
+
+static v8::Local<v8::Value> convert_representation_stats(v8::Isolate* isolate, const svn::repos_representation_stats& raw) {
+    no::object result(isolate);
+    result["count"]                = convert_size(isolate, raw.count);
+    result["packed_size"]          = convert_size(isolate, raw.packed_size);
+    result["expanded_size"]        = convert_size(isolate, raw.expanded_size);
+    result["references"]           = convert_size(isolate, raw.references);
+    result["average_chain_length"] = raw.average_chain_length;
+    return result;
+}
 
-    // apr_terminate();
+static v8::Local<v8::Value> convert_histogram(v8::Isolate* isolate, const std::vector<svn::repos_histogram_line>& raw) {
+    auto context = isolate->GetCurrentContext();
+    auto result  = no::data<v8::Array>(isolate, static_cast<int>(raw.size()));
+    for (uint32_t i = 0; i < raw.size(); i++) {
+        no::object line(isolate);
+        line["count"] = convert_size(isolate, raw[i].count);
+        line["size"]  = convert_size(isolate, raw[i].size);
+        no::check_result(result->Set(context, i, line));
+    }
+    return result;
+}
+
+static v8::Local<v8::Value> convert_layout_stats(v8::Isolate* isolate, const svn::repos_layout_stats& raw) {
+    auto context = isolate->GetCurrentContext();
+
+    no::object result(isolate);
+    result["total_size"]     = convert_size(isolate, raw.total_size);
+    result["revision_count"] = convert_size(isolate, raw.revision_count);
+    result["change_count"]   = convert_size(isolate, raw.change_count);
+    result["file_count"]     = convert_size(isolate, raw.file_count);
+    result["dir_count"]      = convert_size(isolate, raw.dir_count);
+
+    result["file_representations"]      = convert_representation_stats(isolate, raw.file_representations);
+    result["dir_representations"]       = convert_representation_stats(isolate, raw.dir_representations);
+    result["file_prop_representations"] = convert_representation_stats(isolate, raw.file_prop_representations);
+    result["dir_prop_representations"]  = convert_representation_stats(isolate, raw.dir_prop_representations);
+
+    result["representation_sizes"] = convert_histogram(isolate, raw.representation_sizes);
+    result["node_sizes"]           = convert_histogram(isolate, raw.node_sizes);
+
+    auto largest_changes = no::data<v8::Array>(isolate, static_cast<int>(raw.largest_changes.size()));
+    for (uint32_t i = 0; i < raw.largest_changes.size(); i++) {
+        auto& change = raw.largest_changes[i];
+
+        no::object item(isolate);
+        item["path"]     = change.path;
+        item["revision"] = change.revision;
+        item["size"]     = convert_size(isolate, change.size);
+        no::check_result(largest_changes->Set(context, i, item));
+    }
+    result["largest_changes"] = largest_changes;
+
+    auto extensions = no::data<v8::Array>(isolate, static_cast<int>(raw.extensions.size()));
+    for (uint32_t i = 0; i < raw.extensions.size(); i++) {
+        auto& extension = raw.extensions[i];
+
+        no::object item(isolate);
+        item["extension"]            = extension.extension;
+        item["node_count"]           = convert_size(isolate, extension.node_count);
+        item["node_size"]            = convert_size(isolate, extension.node_size);
+        item["representation_count"] = convert_size(isolate, extension.representation_count);
+        item["representation_size"]  = convert_size(isolate, extension.representation_size);
+        no::check_result(extensions->Set(context, i, item));
+    }
+    result["extensions"] = extensions;
+
+    return result;
+}
+
+static v8::Local<v8::Value> stats(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto isolate = args.GetIsolate();
+
+    auto path    = convert_string(args[0]);
+    auto options = convert_options(args[1]);
+
+    svn::repos_stats_options stats_options;
+    stats_options.detailed = convert_bool(options, "detailed", false);
+
+    auto abort = convert_signal(isolate, options);
+
+    // like `load`, the last reference is dropped on the JavaScript thread
+    std::shared_ptr<v8::Global<v8::Function>> progress;
+    if (options.has_value()) {
+        v8::Local<v8::Value> value = options.value()["progress"];
+        if (value->IsFunction()) {
+            progress = std::make_shared<v8::Global<v8::Function>>(isolate, value.As<v8::Function>());
+        } else if (!value->IsUndefined()) {
+            throw no::type_error("progress must be a function");
+        }
+    }
+
+    auto notify = [isolate, progress](int32_t revision) -> void {
+        v8::HandleScope scope(isolate);
+
+        auto context = isolate->GetEnteredContext();
+
+        const auto           argc       = 1;
+        v8::Local<v8::Value> argv[argc] = {no::data(isolate, revision)};
+
+        // stops `stats` instead of leaving the exception pending
+        v8::TryCatch try_catch(isolate);
+        if (progress->Get(isolate)->Call(context, v8::Undefined(isolate), argc, argv).IsEmpty()) {
+            throw svn::svn_error(SVN_ERR_CANCELLED, "progress threw an exception");
+        }
+    };
+
+    auto work = [path, stats_options, progress, notify, abort]() -> svn::repos_stats {
+        if (!progress) {
+            return svn::repos::stats(path, stats_options, {}, abort);
+        }
+
+        auto invoke_progress = uv::make_async(notify);
+        return svn::repos::stats(path, stats_options, [&invoke_progress](int32_t revision) -> void { invoke_progress(revision); }, abort);
+    };
+
+    return queue_promise(
+        isolate,
+        work,
+        [](v8::Isolate* isolate, const svn::repos_stats& raw) -> v8::Local<v8::Value> {
+            no::object result(isolate);
+            result["youngest"]         = raw.youngest;
+            result["shard_size"]       = raw.shard_size;
+            result["min_unpacked_rev"] = raw.min_unpacked_rev;
+            result["unpacked_shards"]  = raw.unpacked_shards;
+            if (raw.layout) {
+                result["layout"] = convert_layout_stats(isolate, *raw.layout);
+            }
+            return result;
+        });
+}
+
+static v8::Local<v8::Value> verify(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto isolate = args.GetIsolate();
+
+    auto path    = convert_string(args[0]);
+    auto options = convert_options(args[1]);
+
+    svn::repos_verify_options verify_options;
+    verify_options.start               = convert_number(options, "start", 0);
+    verify_options.end                 = convert_number(options, "end", -1);
+    verify_options.parallelism         = convert_number(options, "parallelism", 1);
+    verify_options.metadata_only       = convert_bool(options, "metadata_only", false);
+    verify_options.check_normalization = convert_bool(options, "check_normalization", false);
+
+    auto batch_size = convert_number(options, "batch_size", static_cast<int32_t>(no::default_batch_size));
+
+    auto abort = convert_signal(isolate, options);
+
+    auto work = [path, verify_options, abort](const svn::repos::verify_callback& callback) -> void {
+        svn::repos::verify(path, verify_options, callback, abort);
+    };
+
+    auto convert = [](v8::Isolate* isolate, svn::repos_verify_result& item) -> v8::Local<v8::Value> {
+        no::object result(isolate);
+        result["revision"] = item.revision;
+        if (item.error) {
+            result["error"] = copy_error(isolate, *item.error);
+        }
+        return result;
+    };
+
+    return queue_iterable<svn::repos_verify_result>(isolate, batch_size, work, convert);
+}
+
+static svn::repos_dump_options convert_dump_options(const std::optional<no::object>& options) {
+    svn::repos_dump_options result;
+    result.start       = convert_number(options, "start", 0);
+    result.end         = convert_number(options, "end", -1);
+    result.incremental = convert_bool(options, "incremental", false);
+    result.deltas      = convert_bool(options, "deltas", false);
+    return result;
+}
+
+static v8::Local<v8::Value> dump(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto isolate = args.GetIsolate();
+
+    auto path         = convert_string(args[0]);
+    auto options      = convert_options(args[1]);
+    auto dump_options = convert_dump_options(options);
+
+    auto abort = convert_signal(isolate, options);
+
+    auto work = [path, dump_options, abort](const svn::repos::dump_callback& callback) -> void {
+        svn::repos::dump(path, dump_options, callback, abort);
+    };
+
+    auto convert = [](v8::Isolate* isolate, std::vector<char>& chunk) -> v8::Local<v8::Value> {
+        return buffer_from_vector(isolate, chunk);
+    };
+
+    // every chunk waits for the previous one to be consumed
+    return queue_progress<std::vector<char>>(isolate, work, convert);
+}
+
+static v8::Local<v8::Value> dump_parallel(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto isolate = args.GetIsolate();
+
+    auto path  = convert_string(args[0]);
+    auto files = convert_array(args[1], false);
+
+    auto options      = convert_options(args[2]);
+    auto dump_options = convert_dump_options(options);
+
+    auto abort = convert_signal(isolate, options);
+
+    return queue_promise(
+        isolate,
+        [path, files, dump_options, abort]() -> std::vector<svn::repos_dump_range> {
+            return svn::repos::dump_parallel(path, files, dump_options, abort);
+        },
+        [](v8::Isolate* isolate, const std::vector<svn::repos_dump_range>& ranges) -> v8::Local<v8::Value> {
+            auto context = isolate->GetCurrentContext();
+            auto result  = no::data<v8::Array>(isolate, static_cast<int>(ranges.size()));
+            for (uint32_t i = 0; i < ranges.size(); i++) {
+                no::object item(isolate);
+                item["file"]  = ranges[i].file;
+                item["start"] = ranges[i].start;
+                item["end"]   = ranges[i].end;
+                no::check_result(result->Set(context, i, item));
+            }
+            return result;
+        });
+}
+
+// A string or a Buffer, copied as is.
+static std::vector<char> convert_content(const v8::Local<v8::Value>& value) {
+    if (node::Buffer::HasInstance(value)) {
+        auto data = node::Buffer::Data(value);
+        return std::vector<char>(data, data + node::Buffer::Length(value));
+    }
+
+    if (value->IsString()) {
+        v8::String::Utf8Value utf8(value);
+        return std::vector<char>(*utf8, *utf8 + utf8.length());
+    }
+
+    throw no::type_error("content must be a string or a Buffer");
+}
+
+static svn::repos_commit_operation convert_commit_operation(const v8::Local<v8::Value>& value) {
+    if (!value->IsObject()) {
+        throw no::type_error("operations must be objects");
+    }
+
+    std::optional<no::object> object(no::object(value.As<v8::Object>()));
+
+    svn::repos_commit_operation result;
+    result.path = convert_string(object.value()["path"]);
+
+    auto action = convert_string(object.value()["action"]);
+    if (action == "add" || action == "put") {
+        result.action  = action == "add" ? svn::repos_commit_action::add : svn::repos_commit_action::put;
+        result.content = convert_content(object.value()["content"]);
+    } else if (action == "delete") {
+        result.action = svn::repos_commit_action::remove;
+    } else if (action == "mkdir") {
+        result.action = svn::repos_commit_action::mkdir;
+    } else if (action == "copy") {
+        result.action        = svn::repos_commit_action::copy;
+        result.copyfrom_path = convert_string(object.value()["copyfrom_path"]);
+        result.copyfrom_rev  = convert_number(object, "copyfrom_rev", -1);
+    } else if (action == "propset") {
+        result.action = svn::repos_commit_action::propset;
+        result.name   = convert_string(object.value()["name"]);
+
+        v8::Local<v8::Value> prop_value = object.value()["value"];
+        if (!prop_value->IsUndefined()) {
+            auto content = convert_content(prop_value);
+            result.value.emplace(content.data(), content.size());
+        }
+    } else {
+        throw no::type_error("action must be add, put, delete, mkdir, copy or propset");
+    }
+
+    return result;
+}
+
+// `{ author, message, revprops }`, plus `operations` when `operations` isn't
+// given separately.
+static svn::repos_commit_info convert_commit_info(const v8::Local<v8::Value>& value, const v8::Local<v8::Value>& operations) {
+    if (!value->IsObject()) {
+        throw no::type_error("commit must be an object");
+    }
+
+    std::optional<no::object> object(no::object(value.As<v8::Object>()));
+
+    svn::repos_commit_info result;
+    result.author   = convert_optional_string(object, "author");
+    result.message  = convert_optional_string(object, "message").value_or("");
+    result.revprops = convert_string_map(object, "revprops");
+
+    auto raw_operations = operations;
+    if (raw_operations->IsUndefined()) {
+        raw_operations = object.value()["operations"];
+    }
+
+    if (!raw_operations->IsArray()) {
+        throw no::type_error("operations must be an array");
+    }
+
+    auto array = raw_operations.As<v8::Array>();
+    for (uint32_t i = 0; i < array->Length(); i++) {
+        result.operations.push_back(convert_commit_operation(array->Get(i)));
+    }
+
+    return result;
+}
+
+static svn::repos_commit_options convert_commit_options(const v8::Local<v8::Value>& value) {
+    auto options = convert_options(value);
+
+    svn::repos_commit_options result;
+    result.bypass_hooks = convert_bool(options, "bypass_hooks", false);
+    return result;
+}
+
+static v8::Local<v8::Value> convert_commit_result(v8::Isolate* isolate, const svn::repos_commit_result& raw) {
+    no::object result(isolate);
+    result["revision"] = raw.revision;
+    if (raw.post_commit_error) {
+        result["post_commit_error"] = *raw.post_commit_error;
+    }
+    return result;
+}
+
+static v8::Local<v8::Value> commit(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto path    = convert_string(args[0]);
+    auto commits = std::vector<svn::repos_commit_info>{convert_commit_info(args[1], args[2])};
+    auto options = convert_commit_options(args[3]);
+
+    return queue_promise(
+        args.GetIsolate(),
+        [path, commits, options]() -> svn::repos_commit_result { return svn::repos::commit(path, commits, options)[0]; },
+        [](v8::Isolate* isolate, const svn::repos_commit_result& result) -> v8::Local<v8::Value> {
+            return convert_commit_result(isolate, result);
+        });
+}
+
+static v8::Local<v8::Value> commit_batch(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto isolate = args.GetIsolate();
+
+    auto path = convert_string(args[0]);
+
+    if (!args[1]->IsArray()) {
+        throw no::type_error("commits must be an array");
+    }
+
+    std::vector<svn::repos_commit_info> commits;
+
+    auto array = args[1].As<v8::Array>();
+    for (uint32_t i = 0; i < array->Length(); i++) {
+        commits.push_back(convert_commit_info(array->Get(i), v8::Undefined(isolate)));
+    }
+
+    auto options = convert_commit_options(args[2]);
+
+    return queue_promise(
+        isolate,
+        [path, commits, options]() -> std::vector<svn::repos_commit_result> { return svn::repos::commit(path, commits, options); },
+        [](v8::Isolate* isolate, const std::vector<svn::repos_commit_result>& results) -> v8::Local<v8::Value> {
+            auto context = isolate->GetCurrentContext();
+            auto result  = no::data<v8::Array>(isolate, static_cast<int>(results.size()));
+            for (uint32_t i = 0; i < results.size(); i++) {
+                no::check_result(result->Set(context, i, convert_commit_result(isolate, results[i])));
+            }
+            return result;
+        });
+}
+
+using chunk_result = std::optional<std::vector<char>>;
+
+// `{ done, value }` of an async iterator over Buffers.
+static chunk_result convert_chunk_result(v8::Isolate* isolate, const v8::Local<v8::Value>& value) {
+    if (!value->IsObject()) {
+        throw svn::svn_type_error("readable must be an async iterable of Buffers");
+    }
+
+    no::object result(value.As<v8::Object>());
+    if (result["done"]->BooleanValue()) {
+        return {};
+    }
+
+    v8::Local<v8::Value> chunk = result["value"];
+    if (!node::Buffer::HasInstance(chunk)) {
+        throw svn::svn_type_error("readable must be an async iterable of Buffers");
+    }
+
+    auto data = node::Buffer::Data(chunk);
+    return std::vector<char>(data, data + node::Buffer::Length(chunk));
+}
+
+// Fails the load with what `next()` rejected with, usually an Error.
+static chunk_result reject_chunk_result(v8::Isolate* isolate, const v8::Local<v8::Value>& reason) {
+    v8::Local<v8::Value> message = reason;
+    if (reason->IsObject()) {
+        auto value = no::object(reason.As<v8::Object>())["message"];
+        if (value->IsString()) {
+            message = value;
+        }
+    }
+
+    // a reason without a string form still fails the load
+    v8::TryCatch          try_catch(isolate);
+    v8::String::Utf8Value utf8(message);
+    if (*utf8 == nullptr) {
+        throw svn::svn_error(SVN_ERR_CANCELLED, "reading the dump file failed");
+    }
+
+    auto what = std::string("reading the dump file failed: ") + *utf8;
+    throw svn::svn_error(SVN_ERR_CANCELLED, what.c_str());
+}
+
+static v8::Local<v8::Value> load(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto isolate = args.GetIsolate();
+    auto context = isolate->GetCurrentContext();
+
+    auto path = convert_string(args[0]);
+
+    if (!args[1]->IsObject()) {
+        throw no::type_error("readable must be an async iterable of Buffers");
+    }
+
+    auto global = no::object(context->Global());
+    auto symbol = global["Symbol"].as<no::object>();
+
+    auto readable     = no::object(args[1].As<v8::Object>());
+    auto get_iterator = readable[symbol["asyncIterator"].as<v8::Name>()];
+    if (!get_iterator->IsFunction()) {
+        throw no::type_error("readable must be an async iterable of Buffers");
+    }
+
+    auto iterator = std::make_shared<v8::Global<v8::Object>>(
+        isolate,
+        no::check_result(get_iterator.as<v8::Function>()->Call(context, args[1], 0, nullptr)).As<v8::Object>());
+
+    auto options = convert_options(args[2]);
+
+    svn::repos_load_options load_options;
+    load_options.uuid_action     = convert_optional_string(options, "uuid_action").value_or("default");
+    load_options.parent_dir      = convert_optional_string(options, "parent_dir");
+    load_options.validate_props  = convert_bool(options, "validate_props", false);
+    load_options.ignore_dates    = convert_bool(options, "ignore_dates", false);
+    load_options.normalize_props = convert_bool(options, "normalize_props", false);
+    load_options.batch_fsync     = convert_bool(options, "batch_fsync", false);
+
+    auto abort = convert_signal(isolate, options);
+
+    // runs on the JavaScript thread, the worker waits for the promise. The
+    // last reference to `iterator` is dropped there too, when the work is
+    // deleted after completing.
+    auto next = [isolate, iterator]() -> uv::future<chunk_result> {
+        v8::HandleScope scope(isolate);
+
+        auto context = isolate->GetEnteredContext();
+        auto object  = no::object(iterator->Get(isolate));
+
+        auto next_function = object["next"];
+        if (!next_function->IsFunction()) {
+            throw svn::svn_type_error("readable must be an async iterable of Buffers");
+        }
+
+        auto value = no::check_result(next_function.as<v8::Function>()->Call(context, object, 0, nullptr));
+        if (!value->IsPromise()) {
+            std::promise<chunk_result> promise;
+            promise.set_value(convert_chunk_result(isolate, value));
+
+            auto future = promise.get_future();
+            return uv::future<chunk_result>(future);
+        }
+
+        auto future = no::promise::then<chunk_result>(isolate, value.As<v8::Promise>(), convert_chunk_result, reject_chunk_result);
+        return uv::future<chunk_result>(future);
+    };
+
+    auto work = [path, next, load_options, abort](const svn::repos::load_callback& callback) -> void {
+        auto pull = uv::make_async(next);
+
+        auto read = [&pull](std::vector<char>& chunk) -> bool {
+            auto result = pull();
+            if (!result) {
+                return false;
+            }
+
+            chunk = std::move(*result);
+            return true;
+        };
+
+        svn::repos::load(path, read, load_options, callback, abort);
+    };
+
+    auto convert = [](v8::Isolate* isolate, svn::repos_load_progress& item) -> v8::Local<v8::Value> {
+        no::object result(isolate);
+        result["revision"]          = item.revision;
+        result["original_revision"] = item.original_revision;
+        return result;
+    };
+
+    return queue_progress<svn::repos_load_progress>(isolate, work, convert);
+}
+
+// Kept for compatibility, blocks the JavaScript thread.
+static v8::Local<v8::Value> create_repos(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto path = convert_string(args[0]);
+
+    svn::repos::create(path);
+
+    return v8::Undefined(args.GetIsolate());
 }
 
 void initialize(no::object& exports) {
-    exports["create_repos"].set(no::data<v8::Function>(exports.context(), create_repos), no::property_attribute::read_only);
+    repository::initialize(exports);
+
+    exports["create_repos"].set(no::data<v8::Function>(exports.context(), invoke<create_repos>), no::property_attribute::read_only);
+
+    no::object object(exports.isolate());
+    object["commit"].set(no::data<v8::Function>(exports.context(), invoke<commit>), no::property_attribute::read_only);
+    object["commit_batch"].set(no::data<v8::Function>(exports.context(), invoke<commit_batch>), no::property_attribute::read_only);
+    object["create"].set(no::data<v8::Function>(exports.context(), invoke<create>), no::property_attribute::read_only);
+    object["dump"].set(no::data<v8::Function>(exports.context(), invoke<dump>), no::property_attribute::read_only);
+    object["dump_parallel"].set(no::data<v8::Function>(exports.context(), invoke<dump_parallel>), no::property_attribute::read_only);
+    object["hotcopy"].set(no::data<v8::Function>(exports.context(), invoke<hotcopy>), no::property_attribute::read_only);
+    object["load"].set(no::data<v8::Function>(exports.context(), invoke<load>), no::property_attribute::read_only);
+    object["open"].set(no::data<v8::Function>(exports.context(), invoke<open>), no::property_attribute::read_only);
+    object["pack"].set(no::data<v8::Function>(exports.context(), invoke<pack>), no::property_attribute::read_only);
+    object["stats"].set(no::data<v8::Function>(exports.context(), invoke<stats>), no::property_attribute::read_only);
+    object["verify"].set(no::data<v8::Function>(exports.context(), invoke<verify>), no::property_attribute::read_only);
+
+    exports["repos"].set(object, no::property_attribute::read_only);
 }
 } // namespace repos
 } // namespace no
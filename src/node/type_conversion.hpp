@@ -1,11 +1,22 @@
 #pragma once
 
+#include <cmath>
 #include <cstring>
+#include <map>
+#include <optional>
 #include <string>
+#include <vector>
+
+#include <node_buffer.h>
+
+#include <cpp/svn_error.hpp>
+#include <cpp/types.hpp>
 
 #include <node/error.hpp>
 #include <node/v8.hpp>
 
+#include <objects/object.hpp>
+
 static std::string convert_string(const v8::Local<v8::Value>& value) {
     if (!value->IsString())
         throw no::type_error("cannot convert argument to string");
@@ -18,3 +29,220 @@ static std::string convert_string(const v8::Local<v8::Value>& value) {
 
     return std::string(*utf8, length);
 }
+
+static v8::Local<v8::Value> copy_error(v8::Isolate* isolate, const svn::svn_error& raw_error) {
+    auto message = raw_error.what();
+
+    no::object error(v8::Exception::Error(no::data(isolate, message).As<v8::String>()).As<v8::Object>());
+
+    error["name"] = "SvnError";
+    error["code"] = raw_error.code;
+    error["file"] = raw_error.file;
+    error["line"] = raw_error.line;
+
+    if (raw_error.child != nullptr)
+        error["child"] = copy_error(isolate, *raw_error.child);
+
+    return error;
+}
+
+static std::optional<no::object> convert_options(const v8::Local<v8::Value> options) {
+    if (options->IsUndefined()) {
+        return {};
+    }
+
+    if (options->IsObject()) {
+        return no::object(options.As<v8::Object>());
+    }
+
+    throw no::type_error("");
+}
+
+template <size_t N>
+static int32_t convert_number(const std::optional<no::object>& options,
+                              const char (&key)[N],
+                              int32_t defaultValue) {
+    if (!options.has_value()) {
+        return defaultValue;
+    }
+
+    v8::Local<v8::Value> value = options.value()[key];
+    if (value->IsUndefined())
+        return defaultValue;
+
+    if (value->IsNumber()) {
+        return value->Int32Value();
+    }
+
+    throw no::type_error("");
+}
+
+// Sizes in bytes, they may not fit in an `int32_t`.
+template <size_t N>
+static int64_t convert_size(const std::optional<no::object>& options,
+                            const char (&key)[N],
+                            int64_t defaultValue) {
+    if (!options.has_value()) {
+        return defaultValue;
+    }
+
+    v8::Local<v8::Value> value = options.value()[key];
+    if (value->IsUndefined())
+        return defaultValue;
+
+    if (value->IsNumber()) {
+        auto result = value->NumberValue();
+        if (!std::isfinite(result) || result < 0 || result >= 9223372036854775808.0) {
+            throw no::type_error((std::string(key) + " must be a non-negative number").c_str());
+        }
+        return static_cast<int64_t>(result);
+    }
+
+    throw no::type_error("");
+}
+
+template <size_t N>
+static bool convert_bool(const std::optional<no::object>& options,
+                         const char (&key)[N],
+                         bool defaultValue) {
+    if (!options.has_value()) {
+        return defaultValue;
+    }
+
+    v8::Local<v8::Value> value = options.value()[key];
+    if (value->IsUndefined())
+        return defaultValue;
+
+    if (value->IsBoolean()) {
+        return value->BooleanValue();
+    }
+
+    throw no::type_error("");
+}
+
+template <size_t N>
+static std::optional<std::string> convert_optional_string(const std::optional<no::object>& options,
+                                                          const char (&key)[N]) {
+    if (!options.has_value()) {
+        return {};
+    }
+
+    v8::Local<v8::Value> value = options.value()[key];
+    if (value->IsUndefined())
+        return {};
+
+    return convert_string(value);
+}
+
+static std::vector<std::string> convert_array(const v8::Local<v8::Value>& value,
+                                              bool                        allowEmpty) {
+    if (value->IsUndefined()) {
+        if (allowEmpty)
+            return std::vector<std::string>();
+        else
+            throw no::type_error("");
+    }
+
+    if (value->IsString()) {
+        return std::vector<std::string>{convert_string(value)};
+    }
+
+    if (value->IsArray()) {
+        auto array  = value.As<v8::Array>();
+        auto length = array->Length();
+        auto result = std::vector<std::string>();
+        for (uint32_t i = 0; i < length; i++) {
+            auto item = array->Get(i);
+            result.push_back(std::move(convert_string(item)));
+        }
+        return result;
+    }
+
+    throw no::type_error("");
+}
+
+template <size_t N>
+static std::vector<std::string> convert_array(const std::optional<no::object>& options,
+                                              const char (&key)[N]) {
+    if (!options.has_value()) {
+        return std::vector<std::string>();
+    }
+
+    auto value = options.value()[key];
+    if (value->IsUndefined())
+        return std::vector<std::string>();
+
+    return convert_array(value, true);
+}
+
+template <size_t N>
+static svn::string_map convert_string_map(const std::optional<no::object>& options,
+                                          const char (&key)[N]) {
+    if (!options.has_value()) {
+        return svn::string_map();
+    }
+
+    v8::Local<v8::Value> value = options.value()[key];
+    if (value->IsUndefined())
+        return svn::string_map();
+
+    if (!value->IsObject())
+        throw no::type_error("");
+
+    auto context = options->context();
+    auto object  = value.As<v8::Object>();
+    auto names   = no::check_result(object->GetOwnPropertyNames(context));
+
+    svn::string_map result;
+    for (uint32_t i = 0; i < names->Length(); i++) {
+        auto name = no::check_result(names->Get(context, i));
+        result.emplace(convert_string(name), convert_string(no::check_result(object->Get(context, name))));
+    }
+    return result;
+}
+
+static void buffer_free_pointer(char*, void* hint) {
+    delete static_cast<std::vector<char>*>(hint);
+}
+
+static v8::Local<v8::Object> buffer_from_vector(v8::Isolate* isolate, std::vector<char>& vector) {
+    auto pointer = new std::vector<char>(std::move(vector));
+    return node::Buffer::New(isolate,
+                             pointer->data(),
+                             pointer->size(),
+                             buffer_free_pointer,
+                             pointer)
+        .ToLocalChecked();
+}
+
+static no::object convert_string_map(v8::Isolate* isolate, const svn::string_map& map) {
+    no::object result(isolate);
+    for (auto& pair : map) {
+        result[pair.first] = pair.second;
+    }
+    return result;
+}
+
+static v8::Local<v8::Array> convert_changed_paths(v8::Isolate* isolate, const std::map<std::string, svn::log_changed_path>& raw) {
+    auto context = isolate->GetEnteredContext();
+    auto result  = no::data<v8::Array>(isolate, static_cast<int>(raw.size()));
+
+    uint32_t index = 0;
+    for (auto& pair : raw) {
+        auto& raw_item = pair.second;
+
+        no::object item(isolate);
+        item["path"]           = pair.first;
+        item["action"]         = std::string(1, raw_item.action);
+        item["copyfrom_path"]  = raw_item.copyfrom_path;
+        item["copyfrom_rev"]   = raw_item.copyfrom_rev;
+        item["node_kind"]      = static_cast<int32_t>(raw_item.node_kind);
+        item["text_modified"]  = raw_item.text_modified;
+        item["props_modified"] = raw_item.props_modified;
+
+        no::check_result(result->Set(context, index, item));
+        index++;
+    }
+
+    return result;
+}
@@ -133,7 +133,15 @@ static v8::Local<v8::Value> data(v8::Isolate*                            isolate
                                  const std::optional<const std::string>& value,
                                  v8::NewStringType                       type = v8::NewStringType::kNormal) {
     if (value.has_value())
-        return no::data(isolate, value.value(), type);
+        return no::check_result(v8::String::NewFromUtf8(isolate, value->data(), type, static_cast<int>(value->size())));
+
+    return v8::Undefined(isolate);
+}
+
+static v8::Local<v8::Value> data(v8::Isolate*                      isolate,
+                                 const std::optional<std::string>& value) {
+    if (value.has_value())
+        return no::data(isolate, value.value());
 
     return v8::Undefined(isolate);
 }
@@ -193,6 +201,14 @@ static v8::Local<v8::Value> data(v8::Isolate*            isolate,
     return v8::Undefined(isolate);
 }
 
+static v8::Local<v8::Value> data(v8::Isolate*               isolate,
+                                 const std::optional<bool>& value) {
+    if (value.has_value())
+        return no::data(isolate, *value);
+
+    return v8::Undefined(isolate);
+}
+
 static v8::Local<v8::Integer> data(v8::Isolate* isolate, uint32_t value) {
     return v8::Integer::NewFromUnsigned(isolate, value);
 }
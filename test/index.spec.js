@@ -8,6 +8,16 @@ const global_config = false;
 const config = global_config ? undefined : path.resolve(__dirname, "config");
 const server = path.resolve(__dirname, "server");
 const local = path.resolve(__dirname, "local");
+const log_cache = path.resolve(__dirname, "log_cache");
+const blame_cache = path.resolve(__dirname, "blame_cache");
+const fetch_cache = path.resolve(__dirname, "fetch_cache");
+const repos_fsx = path.resolve(__dirname, "repos_fsx");
+const repos_hotcopy = path.resolve(__dirname, "repos_hotcopy");
+const repos_pack = path.resolve(__dirname, "repos_pack");
+const repos_dump = path.resolve(__dirname, "repos_dump");
+const repos_load = path.resolve(__dirname, "repos_load");
+const repos_commit = path.resolve(__dirname, "repos_commit");
+const authz_file = path.resolve(__dirname, "authz");
 
 const file1 = path.resolve(local, "file1.txt").replace(/\\/g, "/");
 
@@ -33,6 +43,16 @@ describe("svn.node", () => {
 
         fs.removeSync(server);
         fs.removeSync(local);
+        fs.removeSync(log_cache);
+        fs.removeSync(blame_cache);
+        fs.removeSync(fetch_cache);
+        fs.removeSync(repos_fsx);
+        fs.removeSync(repos_hotcopy);
+        fs.removeSync(repos_pack);
+        fs.removeSync(repos_dump);
+        fs.removeSync(repos_load);
+        fs.removeSync(repos_commit);
+        fs.removeSync(authz_file);
     });
 
     let svn;
@@ -57,6 +77,111 @@ describe("svn.node", () => {
         expect(fs.existsSync(server)).to.be.true;
     });
 
+    it("repos.create", async function() {
+        await svn.repos.create(repos_fsx, { fs_type: "fsx", compression: "zlib", shard_size: 16 });
+
+        expect(fs.readFileSync(path.resolve(repos_fsx, "db", "fs-type"), "utf-8").trim(), "fs-type").to.equal("fsx");
+        expect(fs.readFileSync(path.resolve(repos_fsx, "db", "format"), "utf-8"), "format").to.contain("layout sharded 16");
+
+        let error;
+        try {
+            await svn.repos.create(repos_fsx);
+        } catch (e) {
+            error = e;
+        }
+        expect(error, "error").to.be.an("error");
+    });
+
+    it("repos.pack", async function() {
+        // revision 0 alone completes a shard
+        await svn.repos.create(repos_pack, { shard_size: 1 });
+        expect((await svn.repos.stats(repos_pack)).unpacked_shards, "before").to.equal(1);
+
+        const progress = [];
+        await async_iterate(svn.repos.pack(repos_pack, { shards_per_run: 1 }), (item) => progress.push(item));
+        expect(progress.map((item) => item.action), "actions").to.include.members(["start", "end"]);
+
+        const stats = await svn.repos.stats(repos_pack);
+        expect(stats.unpacked_shards, "after").to.equal(0);
+        expect(stats.min_unpacked_rev, "min_unpacked_rev").to.equal(1);
+    });
+
+    it("repos.commit", async function() {
+        await svn.repos.create(repos_commit);
+
+        const { revision } = await svn.repos.commit(repos_commit, { author: "author", message: "seed" }, [
+            { action: "mkdir", path: "/trunk" },
+            { action: "add", path: "/trunk/file.txt", content: "1" },
+            { action: "propset", path: "/trunk/file.txt", name: "svn:eol-style", value: "native" },
+        ], { bypass_hooks: true });
+        expect(revision, "revision").to.equal(1);
+
+        const commits = [];
+        for (let i = 2; i <= 100; i++) {
+            commits.push({ message: `${i}`, operations: [{ action: "put", path: "/trunk/file.txt", content: Buffer.from(`${i}`) }] });
+        }
+        commits.push({ message: "branch", operations: [{ action: "copy", path: "/branch", copyfrom_path: "/trunk" }] });
+
+        const results = await svn.repos.commit_batch(repos_commit, commits);
+        expect(results.length, "results.length").to.equal(commits.length);
+        expect(results[results.length - 1].revision, "youngest").to.equal(101);
+
+        const repository = await svn.repos.open(repos_commit);
+        const chunks = [];
+        await async_iterate(repository.cat(undefined, "/branch/file.txt"), (batch) => chunks.push(...batch));
+        expect(Buffer.concat(chunks).toString("utf-8"), "content").to.equal("100");
+        expect(await repository.proplist(1, "/trunk/file.txt"), "props").to.deep.equal({ "svn:eol-style": "native" });
+        expect((await repository.revision_proplist(1))["svn:author"], "author").to.equal("author");
+        expect(await repository.revision_proplist(2), "no author").to.not.have.property("svn:author");
+
+        if (process.platform !== "win32") {
+            // a repository of its own, the others count their revisions
+            const hook = path.resolve(repos_fsx, "hooks", "post-commit");
+            fs.writeFileSync(hook, "#!/bin/sh\necho broken >&2\nexit 1\n", { mode: 0o755 });
+
+            const result = await svn.repos.commit(repos_fsx, { message: "hook" }, [{ action: "mkdir", path: "/hook" }]);
+            fs.removeSync(hook);
+
+            expect(result.revision, "hook revision").to.equal(1);
+            expect(result.post_commit_error, "post_commit_error").to.contain("broken");
+        }
+    });
+
+    it("repos.stats", async function() {
+        const revisions_read = [];
+        const stats = await svn.repos.stats(repos_commit, { detailed: true, progress: (revision) => revisions_read.push(revision) });
+        expect(stats.layout.revision_count, "revision_count").to.equal(102);
+        expect(stats.layout.largest_changes.length, "largest_changes").to.be.greaterThan(0);
+        expect(stats.layout.extensions.map((item) => item.extension), "extensions").to.include("txt");
+        expect(revisions_read, "progress").to.not.be.empty;
+    });
+
+    it("authz.load", async function() {
+        fs.writeFileSync(authz_file, "[/]\n* = r\n[/secret]\n* =\nalice = rw\n[repo:/trunk]\nbob = rw\n");
+
+        const authz = await svn.authz.load(authz_file);
+        expect(await authz.check("alice", null, ["/", "/secret", "secret/file"], "rw"), "alice").to.deep.equal([false, true, true]);
+        expect(await authz.check(null, "repo", ["/trunk", "/secret"], "r"), "anonymous").to.deep.equal([true, false]);
+        expect(await authz.check("bob", "repo", ["/trunk", "/branches"], "rw"), "bob").to.deep.equal([true, false]);
+        expect(await authz.check("bob", null, ["/"], "r", { recursive: true }), "recursive").to.deep.equal([false]);
+
+        const entries = [];
+        for (let i = 0; i < 100000; i++) {
+            entries.push(i % 2 === 0 ? { path: `secret/${i}` } : `public/${i}`);
+        }
+        const filtered = await authz.filter("bob", null, entries);
+        expect(filtered.length, "filtered.length").to.equal(50000);
+        expect(filtered[0], "filtered[0]").to.equal("public/1");
+
+        const from_buffer = await svn.authz.load(Buffer.from("[/]\nalice = r\n"));
+        expect(await from_buffer.filter("alice", null, [{ path: "file" }], { base: "/trunk" }), "buffer").to.deep.equal([{ path: "file" }]);
+
+        // compiled again once the file changes
+        fs.writeFileSync(authz_file, "[/]\n* = rw\n");
+        fs.utimesSync(authz_file, new Date(), new Date(Date.now() + 10000));
+        expect(await authz.check("bob", null, ["/secret"], "rw"), "reloaded").to.deep.equal([true]);
+    });
+
     it("new Client", () => {
         client = new svn.Client(config);
 
@@ -194,6 +319,57 @@ describe("svn.node", () => {
         expect(count).to.equal(1);
     });
 
+    it("status with filters", async function() {
+        async function count(options) {
+            let result = 0;
+            await async_iterate(client.status(local, options), () => result++);
+            return result;
+        }
+
+        expect(await count({ node_status_in: [svn.StatusKind.modified] }), "node_status_in modified").to.equal(1);
+        expect(await count({ node_status_in: [svn.StatusKind.added] }), "node_status_in added").to.equal(0);
+        expect(await count({ exclude_globs: ["*.txt"] }), "exclude_globs").to.equal(0);
+        expect(await count({ path_prefixes: [file1] }), "path_prefixes").to.equal(1);
+        expect(await count({ only_conflicted: true }), "only_conflicted").to.equal(0);
+    });
+
+    it("watch_status", async function() {
+        const file2 = path.resolve(local, "file2.txt").replace(/\\/g, "/");
+
+        let result = await client.watch_status(local);
+        expect(result.reset, "result.reset").to.be.true;
+        expect(result.changed.map((item) => item.path), "result.changed").to.deep.equal([file1]);
+
+        await fs.writeFile(file2, file2);
+        result = await client.status_changes(local, result.generation);
+        expect(result.reset, "result.reset").to.be.false;
+        expect(result.changed.map((item) => item.path), "result.changed").to.deep.equal([file2]);
+        expect(svn.StatusKind[result.changed[0].node_status]).to.equal(svn.StatusKind[svn.StatusKind.unversioned]);
+
+        await fs.remove(file2);
+        result = await client.status_changes(local, result.generation);
+        expect(result.changed, "result.changed").to.deep.equal([]);
+        expect(result.removed, "result.removed").to.deep.equal([file2]);
+
+        // any spelling of the path finds the same watcher
+        const directory = path.resolve(local, "directory").replace(/\\/g, "/");
+        await fs.outputFile(path.resolve(directory, "nested", "file.txt"), "file");
+        result = await client.status_changes(local + "/./", result.generation);
+        expect(result.changed.map((item) => item.path), "result.changed").to.deep.equal([directory]);
+
+        await fs.remove(directory);
+        result = await client.status_changes(local, result.generation);
+        expect(result.removed, "result.removed").to.deep.equal([directory]);
+
+        client.unwatch_status(local + "/");
+
+        // the watcher keeps the client alive until the initial status is done
+        const disposed = new svn.Client(config);
+        const watching = disposed.watch_status(local);
+        disposed.dispose();
+        await watching;
+    });
+
     it("cat", async function() {
         let result = await client.cat(file1);
         expect(result.content.toString("utf-8")).to.equal(file1);
@@ -207,6 +383,400 @@ describe("svn.node", () => {
         expect(result.content.toString("utf-8")).to.equal(file1 + file1);
     });
 
+    it("cat_many", async function() {
+        const root = uri.file(server).toString(true);
+
+        const items = [];
+        await async_iterate(client.cat_many([root + "/file1.txt", root + "/missing.txt"]), (batch) => items.push(...batch));
+        expect(items.length, "items.length").to.equal(2);
+        expect(items[0].content.toString("utf-8"), "items[0].content").to.equal(file1);
+        expect(items[1].error, "items[1].error").to.be.an("error");
+    });
+
+    it("pristine", async function() {
+        const items = [];
+        await async_iterate(client.pristine([file1, path.resolve(local, "missing.txt")]), (batch) => items.push(...batch));
+        expect(items.length, "items.length").to.equal(2);
+        expect(items[0].content.toString("utf-8"), "items[0].content").to.equal(file1);
+        expect(items[1].error, "items[1].error").to.be.an("error");
+    });
+
+    it("fetch cache", async function() {
+        const url = uri.file(server).toString(true) + "/file1.txt";
+
+        await client.set_fetch_cache(fetch_cache);
+        const fetched = await client.cat(url);
+        const cached = await client.cat(url);
+        const metrics = await client.get_fetch_cache_metrics();
+        await client.set_fetch_cache();
+
+        expect(fetched.content.toString("utf-8"), "fetched.content").to.equal(file1);
+        expect(cached.content.toString("utf-8"), "cached.content").to.equal(file1);
+        expect(cached.properties, "cached.properties").to.deep.equal(fetched.properties);
+        expect(metrics.misses, "metrics.misses").to.equal(1);
+        expect(metrics.hits, "metrics.hits").to.equal(1);
+        expect(metrics.bytes_served, "metrics.bytes_served").to.equal(Buffer.byteLength(file1));
+        expect(metrics.size, "metrics.size").to.equal(Buffer.byteLength(file1));
+
+        await client.set_fetch_cache(fetch_cache, { max_size: 8 * 1024 * 1024 * 1024 });
+        await client.set_fetch_cache();
+
+        let error;
+        try {
+            await client.set_fetch_cache(fetch_cache, { max_size: -1 });
+        } catch (e) {
+            error = e;
+        }
+        expect(error, "error").to.be.an("error");
+    });
+
+    it("stat", async function() {
+        const root = uri.file(server).toString(true);
+
+        const items = [];
+        await async_iterate(client.stat([root + "/file1.txt", root + "/missing.txt"]), (batch) => items.push(...batch));
+        expect(items.length, "items.length").to.equal(2);
+        expect(items[0].kind, "items[0].kind").to.equal(svn.NodeKind.file);
+        expect(items[0].size, "items[0].size").to.equal(Buffer.byteLength(file1));
+        expect(items[1].kind, "items[1].kind").to.equal(svn.NodeKind.none);
+        expect(items[1].error, "items[1].error").to.be.undefined;
+    });
+
+    it("blame compact", async function() {
+        const url = uri.file(server).toString(true) + "/file1.txt";
+
+        const result = await client.blame(url, { peg_revision: svn.RevisionKind.head, compact: true });
+        expect(result.content.toString("utf-8"), "result.content").to.equal(file1);
+        expect(Array.from(result.line_offsets), "result.line_offsets").to.deep.equal([0, Buffer.byteLength(file1)]);
+        expect(result.revisions.length, "result.revisions.length").to.equal(1);
+        expect(result.merged_revisions[0], "result.merged_revisions[0]").to.equal(-1);
+        expect(result.revision_table.length, "result.revision_table.length").to.equal(1);
+        expect(result.revision_table[0].revision, "result.revision_table[0].revision").to.equal(result.revisions[0]);
+        expect(result.revision_table[0].date, "result.revision_table[0].date").to.be.a("date");
+
+        // every line keeps its own end of line
+        const text = "crlf\r\nlf\nlast";
+        await svn.repos.commit(repos_fsx, { author: "author", message: "eol" }, [{ action: "put", path: "/eol.txt", content: text }]);
+
+        const eol = await client.blame(uri.file(repos_fsx).toString(true) + "/eol.txt", { compact: true });
+        expect(eol.content.toString("utf-8"), "eol.content").to.equal(text);
+        expect(Array.from(eol.line_offsets), "eol.line_offsets").to.deep.equal([0, 6, 9, 13]);
+    });
+
+    it("blame cache", async function() {
+        const root = uri.file(repos_commit).toString(true);
+        const blame = (target) => client.blame(root + target, { compact: true });
+
+        await client.set_blame_cache(blame_cache);
+        const stored = await blame("/trunk/file.txt");
+        const cached = await blame("/trunk/file.txt");
+        expect(cached, "cached").to.deep.equal(stored);
+        expect(fs.existsSync(path.resolve(blame_cache, "blame.db")), "blame.db").to.be.true;
+
+        // the cached annotation is extended with the new revision
+        const content = Buffer.from(`${"x".repeat(99)}\n`.repeat(10));
+        await svn.repos.commit(repos_commit, { author: "author", message: "lines" }, [
+            { action: "put", path: "/trunk/file.txt", content },
+            { action: "put", path: "/branch/file.txt", content },
+        ]);
+        const extended = await blame("/trunk/file.txt");
+        const metrics = await client.get_blame_cache_metrics();
+        await client.set_blame_cache();
+
+        expect(extended, "extended").to.deep.equal(await blame("/trunk/file.txt"));
+        expect(metrics, "metrics").to.deep.equal({ hits: 2, misses: 1, evictions: 0, entries: 1, extensions: 1 });
+
+        // both annotations are about 1 KiB, only the last one used fits
+        await client.set_blame_cache(blame_cache, { max_size: 1536 });
+        await blame("/branch/file.txt");
+        await blame("/trunk/file.txt");
+        const evicted = await client.get_blame_cache_metrics();
+        await client.set_blame_cache();
+
+        expect(evicted, "evicted").to.deep.equal({ hits: 0, misses: 2, evictions: 2, entries: 1, extensions: 0 });
+
+        await client.set_blame_cache(blame_cache, { max_size: 8 * 1024 * 1024 * 1024 });
+        await client.set_blame_cache();
+
+        let error;
+        try {
+            await client.set_blame_cache(blame_cache, { max_size: -1 });
+        } catch (e) {
+            error = e;
+        }
+        expect(error, "error").to.be.an("error");
+    });
+
+    it("proplist", async function() {
+        const url = uri.file(server).toString(true) + "/file1.txt";
+
+        const items = [];
+        const result = client.proplist([url], { get_inherited_props: true });
+        await async_iterate(result, (batch) => {
+            expect(batch).to.be.an("array");
+            items.push(...batch);
+        });
+
+        expect(items.length, "items.length").to.equal(1);
+        expect(items[0].path, "items[0].path").to.equal(url);
+        expect(items[0].inherited_properties, "items[0].inherited_properties").to.deep.equal([]);
+    });
+
+    it("inherited properties cache", async function() {
+        const root = uri.file(repos_commit).toString(true);
+        const proplist = (target) => async_iterate(client.proplist([`${root}${target}`], { get_inherited_props: true }), () => { });
+
+        // one entry per parent directory
+        await client.set_inherited_properties_cache_size(2);
+        await proplist("/trunk/file.txt");
+        await proplist("/branch/file.txt");
+
+        const base = await client.get_inherited_properties_cache_metrics();
+        const delta = async () => {
+            const metrics = await client.get_inherited_properties_cache_metrics();
+            return {
+                hits: metrics.hits - base.hits,
+                misses: metrics.misses - base.misses,
+                evictions: metrics.evictions - base.evictions,
+            };
+        };
+
+        await proplist("/trunk/file.txt");
+        expect(await delta(), "hit").to.deep.equal({ hits: 1, misses: 0, evictions: 0 });
+
+        // `trunk` was added before `branch` but used after it, the parent of `/trunk` evicts `branch`
+        await proplist("/trunk");
+        await proplist("/trunk/file.txt");
+        expect(await delta(), "eviction").to.deep.equal({ hits: 2, misses: 1, evictions: 1 });
+
+        await proplist("/branch/file.txt");
+        expect(await delta(), "evicted").to.deep.equal({ hits: 2, misses: 2, evictions: 2 });
+
+        await client.set_inherited_properties_cache_size(4096);
+    });
+
+    it("log", async function() {
+        const items = [];
+        await async_iterate(client.log(file1, { discover_changed_paths: true }), (batch) => items.push(...batch));
+        expect(items.length, "items.length").to.equal(1);
+        expect(items[0].message, "items[0].message").to.equal("commit1");
+        expect(items[0].date, "items[0].date").to.be.a("date");
+        expect(items[0].changed_paths[0].action, "items[0].changed_paths[0].action").to.equal("A");
+
+        // URLs have no BASE, their history starts at HEAD
+        const url = uri.file(server).toString(true) + "/file1.txt";
+
+        const remote = [];
+        await async_iterate(client.log(url), (batch) => remote.push(...batch));
+        expect(remote.map((item) => item.revision), "remote").to.deep.equal(items.map((item) => item.revision));
+    });
+
+    it("mergeinfo_log", async function() {
+        const url = uri.file(server).toString(true) + "/file1.txt";
+
+        const merged = [];
+        await async_iterate(client.mergeinfo_log(url, url), (batch) => merged.push(...batch));
+        expect(merged, "merged").to.deep.equal([]);
+
+        const eligible = [];
+        await async_iterate(client.mergeinfo_log(url, url, { finding_merged: false }), (batch) => eligible.push(...batch));
+        expect(eligible.length, "eligible.length").to.equal(1);
+        expect(eligible[0].revision, "eligible[0].revision").to.equal(1);
+    });
+
+    it("lock", async function() {
+        const locked = [];
+        await async_iterate(client.lock([file1], "lock"), (batch) => locked.push(...batch));
+        expect(locked.length, "locked.length").to.equal(1);
+        expect(locked[0].succeeded, "locked[0].succeeded").to.be.true;
+        expect(locked[0].token, "locked[0].token").to.be.a("string");
+
+        const unlocked = [];
+        await async_iterate(client.unlock([file1]), (batch) => unlocked.push(...batch));
+        expect(unlocked.length, "unlocked.length").to.equal(1);
+        expect(unlocked[0].succeeded, "unlocked[0].succeeded").to.be.true;
+    });
+
+    it("copy", async function() {
+        const root = uri.file(server).toString(true);
+
+        const items = [];
+        await async_iterate(client.copy([root + "/file1.txt"], root + "/file2.txt", "copy"), (item) => items.push(item));
+        expect(items.length, "items.length").to.equal(1);
+        expect(items[0].revision, "items[0].revision").to.be.a("number");
+    });
+
+    it("location_segments", async function() {
+        const url = uri.file(server).toString(true) + "/file2.txt";
+
+        const segments = await client.location_segments(url);
+        expect(segments.map((item) => item.path), "paths").to.deep.equal(["file2.txt", "file1.txt"]);
+        expect(segments[0].range_start, "segments[0].range_start").to.equal(segments[1].range_end + 1);
+    });
+
+    it("history", async function() {
+        const url = uri.file(server).toString(true) + "/file2.txt";
+
+        const items = [];
+        await async_iterate(client.history(url), (batch) => items.push(...batch));
+        expect(items.map((item) => item.path), "paths").to.deep.equal(["file2.txt", "file1.txt"]);
+        expect(items[0].message, "items[0].message").to.equal("copy");
+        expect(items[1].message, "items[1].message").to.equal("commit1");
+    });
+
+    it("repos.open", async function() {
+        const repository = await svn.repos.open(server);
+
+        const youngest = await repository.youngest();
+        expect(youngest, "youngest").to.be.greaterThan(1);
+
+        const entries = [];
+        await async_iterate(repository.tree(undefined, "/"), (batch) => entries.push(...batch));
+        expect(entries.map((item) => item.path), "entries").to.include.members(["file1.txt", "file2.txt"]);
+
+        const chunks = [];
+        await async_iterate(repository.cat(1, "/file1.txt"), (batch) => chunks.push(...batch));
+        expect(Buffer.concat(chunks).toString("utf-8"), "content").to.equal(file1);
+
+        const changed = await repository.changed_paths(1);
+        expect(changed.map((item) => item.path), "changed").to.include("/file1.txt");
+
+        const locations = [];
+        await async_iterate(repository.history("/file2.txt"), (batch) => locations.push(...batch));
+        expect(locations.map((item) => item.path), "history").to.deep.equal(["/file2.txt", "/file1.txt"]);
+    });
+
+    it("repos.hotcopy", async function() {
+        const youngest = await (await svn.repos.open(server)).youngest();
+
+        const progress = [];
+        await async_iterate(svn.repos.hotcopy(server, repos_hotcopy, { rate_limit_bytes_per_sec: 1024 * 1024 }), (item) => progress.push(item));
+        expect(progress[progress.length - 1].end_revision, "end_revision").to.equal(youngest);
+        expect(await (await svn.repos.open(repos_hotcopy)).youngest(), "youngest").to.equal(youngest);
+
+        const incremental = [];
+        await async_iterate(svn.repos.hotcopy(server, repos_hotcopy, { incremental: true }), (item) => incremental.push(item));
+        expect(incremental, "incremental").to.be.empty;
+
+        const signal = { aborted: true, addEventListener() { } };
+        let error;
+        try {
+            await async_iterate(svn.repos.hotcopy(server, repos_hotcopy, { incremental: true, signal }), () => { });
+        } catch (e) {
+            error = e;
+        }
+        expect(error, "error").to.be.an("error");
+
+        const listeners = [];
+        let added = 0;
+        const pending = {
+            aborted: false,
+            addEventListener(type, listener) { listeners.push(listener); added++; },
+            removeEventListener(type, listener) { listeners.splice(listeners.indexOf(listener), 1); },
+        };
+        await async_iterate(svn.repos.hotcopy(server, repos_hotcopy, { incremental: true, signal: pending }), () => { });
+        // the work holding the listener is released after it settled
+        await new Promise((resolve) => setImmediate(resolve));
+        expect(added, "added").to.equal(1);
+        expect(listeners, "listeners").to.be.empty;
+    });
+
+    it("repos.verify", async function() {
+        const youngest = await (await svn.repos.open(server)).youngest();
+
+        const results = [];
+        await async_iterate(svn.repos.verify(server, { parallelism: 2 }), (batch) => results.push(...batch));
+        expect(results.filter((item) => item.error), "errors").to.be.empty;
+        expect(results.map((item) => item.revision).sort((a, b) => a - b), "revisions").to.deep.equal([...Array(youngest + 1).keys()]);
+
+        // 5 revisions don't split evenly over 4 threads
+        const uneven = [];
+        await async_iterate(svn.repos.verify(repos_commit, { end: 4, parallelism: 4 }), (batch) => uneven.push(...batch));
+        expect(uneven.filter((item) => item.error), "uneven errors").to.be.empty;
+        expect(uneven.map((item) => item.revision).sort((a, b) => a - b), "uneven revisions").to.deep.equal([0, 1, 2, 3, 4]);
+    });
+
+    it("repos.dump", async function() {
+        const youngest = await (await svn.repos.open(server)).youngest();
+
+        const chunks = [];
+        await async_iterate(svn.repos.dump(server), (chunk) => chunks.push(chunk));
+        const dump = Buffer.concat(chunks).toString("utf-8");
+        expect(dump, "dump").to.match(/^SVN-fs-dump-format-version: /);
+        expect(dump, "dump").to.contain(`Revision-number: ${youngest}`);
+
+        fs.ensureDirSync(repos_dump);
+        const files = [path.resolve(repos_dump, "0.dump"), path.resolve(repos_dump, "1.dump")];
+        const ranges = await svn.repos.dump_parallel(server, files);
+        expect(ranges[0].start, "ranges[0].start").to.equal(0);
+        expect(ranges[ranges.length - 1].end, "end").to.equal(youngest);
+        for (const range of ranges) {
+            expect(fs.existsSync(range.file), range.file).to.be.true;
+        }
+    });
+
+    it("repos.load", async function() {
+        const youngest = await (await svn.repos.open(server)).youngest();
+
+        const chunks = [];
+        await async_iterate(svn.repos.dump(server), (chunk) => chunks.push(chunk));
+
+        async function* readable() {
+            yield* chunks;
+        }
+
+        await svn.repos.create(repos_load);
+
+        const progress = [];
+        await async_iterate(svn.repos.load(repos_load, readable(), { batch_fsync: true }), (item) => progress.push(item));
+        expect(progress.map((item) => item.revision), "revisions").to.deep.equal(progress.map((item) => item.original_revision));
+        expect(progress[progress.length - 1].revision, "youngest").to.equal(youngest);
+
+        const repository = await svn.repos.open(repos_load);
+        const content = [];
+        await async_iterate(repository.cat(1, "/file1.txt"), (batch) => content.push(...batch));
+        expect(Buffer.concat(content).toString("utf-8"), "content").to.equal(file1);
+
+        async function* unreadable() {
+            throw new Error("unreadable");
+        }
+
+        let error;
+        try {
+            await async_iterate(svn.repos.load(repos_load, unreadable()), () => { });
+        } catch (e) {
+            error = e;
+        }
+        expect(error, "error").to.be.an("error");
+        expect(error.message, "error.message").to.contain("unreadable");
+    });
+
+    it("log cache", async function() {
+        const root = uri.file(server).toString(true);
+        const url = root + "/file2.txt";
+
+        const expected = [];
+        await async_iterate(client.log(url, { discover_changed_paths: true }), (batch) => expected.push(...batch));
+
+        await client.set_log_cache(log_cache);
+        const youngest = await client.sync_log_cache(root);
+        expect(youngest, "youngest").to.equal(expected[0].revision);
+
+        const cached = [];
+        await async_iterate(client.log(url, { discover_changed_paths: true }), (batch) => cached.push(...batch));
+        expect(cached, "cached").to.deep.equal(expected);
+
+        // merged revisions aren't cached, the server answers
+        await async_iterate(client.log(url, { include_merged_revisions: true }), () => { });
+
+        expect(await client.get_log_cache_metrics(), "metrics").to.deep.equal({ hits: 1, misses: 1, evictions: 0, entries: youngest + 1 });
+
+        const found = await client.search_log_cache(root, { message: "copy" });
+        expect(found.map((item) => item.revision), "found").to.deep.equal([expected[0].revision]);
+
+        await client.set_log_cache();
+    });
+
     describe("changelist", () => {
         const changelist = Date.now().toString();
 
@@ -280,16 +850,18 @@ describe("svn.node", () => {
         iterable = client.log("c:/Users/Simon/Desktop/dev/webchat/index.html", {
             revision_ranges: ranges
         });
-        await async_iterate(iterable, (value) => {
-            const info = revisions.get(value.revision);
-            info.message = value.message;
-            info.author = value.author;
-
-            if (value.author.length > max.author) {
-                max.author = value.author.length;
-            }
-            if (value.message.length > max.message) {
-                max.message = value.message.length;
+        await async_iterate(iterable, (batch) => {
+            for (const value of batch) {
+                const info = revisions.get(value.revision);
+                info.message = value.message;
+                info.author = value.author;
+
+                if (value.author.length > max.author) {
+                    max.author = value.author.length;
+                }
+                if (value.message.length > max.message) {
+                    max.message = value.message.length;
+                }
             }
         });
 